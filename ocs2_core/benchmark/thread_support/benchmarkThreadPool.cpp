@@ -0,0 +1,63 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+using namespace ocs2;
+
+int main() {
+  constexpr int numRepeats = 10000;
+  const size_t numWorkers = 3;
+  std::atomic_int counter;
+
+  auto timeRunParallel = [&](ThreadPool& pool) {
+    counter = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numRepeats; i++) {
+      pool.runParallel([&](int) { counter++; }, numWorkers + 1);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / numRepeats;
+  };
+
+  ThreadPool queuePool(numWorkers);
+  ThreadPool spinningPool(numWorkers, 0, std::chrono::microseconds(1000));
+  const double queuePoolTime = timeRunParallel(queuePool);
+  const double spinningPoolTime = timeRunParallel(spinningPool);
+
+  std::cout << "Fork/join with " << numWorkers << " workers, average over " << numRepeats << " calls:\n";
+  std::cout << "\tTask queue pool    : " << queuePoolTime << " [us]\n";
+  std::cout << "\tSpinning pool      : " << spinningPoolTime << " [us]\n";
+
+  return 0;
+}
@@ -33,7 +33,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <Eigen/Core>
 
 // STL
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 // CppAD
 #include <cppad/cg.hpp>
@@ -82,10 +86,12 @@ class CppAdInterface {
   CppAdInterface(ad_function_t adFunction, size_t variableDim, std::string modelName, std::string folderName = "/tmp/ocs2",
                  std::vector<std::string> compileFlags = {"-O3", "-g", "-march=native", "-mtune=native", "-ffast-math"});
 
-  ~CppAdInterface() = default;
+  ~CppAdInterface();
 
   /**
-   * Copy constructor. Models are reloaded if available.
+   * Copy constructor. The loaded model library is shared with rhs, only the evaluation buffers are created for the copy.
+   * If rhs has no model loaded, models are loaded from disk if available. Evaluations on a single instance are not thread-safe, use one
+   * copy per thread.
    */
   CppAdInterface(const CppAdInterface& rhs);
 
@@ -108,13 +114,45 @@ class CppAdInterface {
   void createModels(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
 
   /**
-   * Load models if they are available on disk. Creates a new library otherwise.
+   * Load models if they are available on disk and were generated from the same function. Creates a new library otherwise.
    *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
    */
   void loadModelsIfAvailable(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
 
+  /**
+   * First phase of the model creation: tapes the function and generates the library sources. The library is identified by a hash of
+   * the optimized operation sequence, the dimensions, the approximation order, and the compile flags. If a library with the same hash
+   * is found on disk, it is loaded instead and no sources are generated.
+   * Taping is not thread-safe, this function should not be called concurrently.
+   *
+   * @param approximationOrder : Order of derivatives to generate
+   * @param recompileLibrary : Generate a new library even if an up-to-date one is available on disk.
+   * @param verbose : Print out extra information
+   * @return true if the library has to be compiled with compileModels().
+   */
+  bool prepareModels(ApproximationOrder approximationOrder, bool recompileLibrary, bool verbose = true);
+
+  /**
+   * Second phase of the model creation: compiles the sources generated by prepareModels(), saves the library to disk, and loads it.
+   * Different interfaces can be compiled concurrently.
+   *
+   * @param verbose : Print out extra information
+   */
+  void compileModels(bool verbose = true);
+
+  /**
+   * Loads or creates the models of several interfaces. The functions are taped one after the other, the libraries that need to be
+   * (re)compiled are then compiled concurrently.
+   *
+   * @param adInterfaces : The interfaces and the order of derivatives to generate for each of them.
+   * @param recompileLibraries : Generate new libraries even if up-to-date ones are available on disk.
+   * @param verbose : Print out extra information
+   */
+  static void loadOrCreateModels(const std::vector<std::pair<CppAdInterface*, ApproximationOrder>>& adInterfaces, bool recompileLibraries,
+                                 bool verbose = true);
+
   /**
    * @param x : input vector of size variableDim
    * @param p : parameter vector of size parameterDim
@@ -131,6 +169,15 @@ class CppAdInterface {
    */
   matrix_t getJacobian(const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Jacobian written to a caller-provided matrix, which is only reallocated if it does not have the right size.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] jacobian : d/dx( f(x,p) )
+   */
+  void getJacobian(const vector_t& x, const vector_t& p, matrix_t& jacobian) const;
+
   /**
    * Returns the full Gauss-Newton approximation of the function.
    * With auto differentiated function y = f(x,p), the following approximation is made:
@@ -166,6 +213,53 @@ class CppAdInterface {
   matrix_t getHessian(const vector_t& w, const vector_t& x, const vector_t& p = vector_t(0)) const;
 
  private:
+  /** Sparsity pattern in coordinate format: the k-th nonzero is at (rows[k], cols[k]). Nonzeros are ordered by row, then by column. */
+  struct CoordinateSparsity {
+    std::vector<size_t> rows;
+    std::vector<size_t> cols;
+    size_t size() const { return rows.size(); }
+  };
+
+  /** Compiled model library. It is immutable once loaded and shared between all copies of an interface. */
+  struct ModelLibrary {
+    explicit ModelLibrary(std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> lib) : dynamicLib(std::move(lib)) {}
+    std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> dynamicLib;
+    std::mutex mutex;  // Models register with the library on creation and destruction.
+  };
+
+  /** Code generation state between prepareModels() and compileModels(). */
+  struct ModelGeneration;
+
+  /**
+   * Reads the hash of the library on disk.
+   * @return hash, empty if not available.
+   */
+  std::string readLibraryHash() const;
+
+  /**
+   * Takes ownership of a newly loaded library and creates the model of this instance from it.
+   */
+  void setModelLibrary(std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> dynamicLib);
+
+  /**
+   * Creates the model of this instance from the shared library. The model holds the evaluation buffers of this instance.
+   */
+  void createModelFromLibrary();
+
+  /**
+   * Destroys the model of this instance, if any.
+   */
+  void releaseModel();
+
+  /** Concatenates the variables and parameters into the input buffer of the model. */
+  void setVariablesAndParameters(const vector_t& x, const vector_t& p) const;
+
+  /** Evaluates the nonzeros of the Jacobian into sparseJacobianBuffer_. */
+  void evaluateSparseJacobian(const vector_t& x, const vector_t& p) const;
+
+  /** Evaluates the nonzeros of the weighted hessian into sparseHessianBuffer_. */
+  void evaluateSparseHessian(const vector_t& w, const vector_t& x, const vector_t& p) const;
+
   /**
    * Defines library folder names
    */
@@ -203,7 +297,7 @@ class CppAdInterface {
   void setApproximationOrder(ApproximationOrder approximationOrder, CppAD::cg::ModelCSourceGen<scalar_t>& sourceGen, ad_fun_t& fun) const;
 
   /**
-   * Stores the sparisty nonzeros
+   * Stores the sparsity patterns and their number of nonzeros
    */
   void setSparsityNonzeros();
 
@@ -221,8 +315,13 @@ class CppAdInterface {
    */
   cppad_sparsity::SparsityPattern createHessianSparsity(ad_fun_t& fun) const;
 
-  std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> dynamicLib_;
-  std::unique_ptr<CppAD::cg::GenericModel<scalar_t>> model_;
+  std::unique_ptr<ModelGeneration> modelGeneration_;
+  std::shared_ptr<ModelLibrary> library_;
+  std::unique_ptr<CppAD::cg::GenericModel<scalar_t>> model_;  // Not shared, holds the evaluation buffers of this instance.
+  mutable vector_t xpBuffer_;
+  mutable vector_t valueBuffer_;
+  mutable std::vector<scalar_t> sparseJacobianBuffer_;
+  mutable std::vector<scalar_t> sparseHessianBuffer_;
   ad_parameterized_function_t adFunction_;
   std::vector<std::string> compileFlags_;
 
@@ -232,6 +331,8 @@ class CppAdInterface {
   size_t rangeDim_ = 0;
   size_t nnzJacobian_ = 0;
   size_t nnzHessian_ = 0;
+  CoordinateSparsity jacobianSparsity_;
+  CoordinateSparsity hessianSparsity_;
 
   // Names
   std::string modelName_;
@@ -240,6 +341,7 @@ class CppAdInterface {
   std::string tmpName_;
   std::string tmpFolder_;
   std::string libraryName_;
+  std::string libraryHashFile_;
 };
 
 }  // namespace ocs2
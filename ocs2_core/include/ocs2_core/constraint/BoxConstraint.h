@@ -0,0 +1,79 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * Box constraint on a subset of the entries of a vector v:
+ *    lowerBound <= v[indices] <= upperBound
+ *
+ * A side without bound is set to -/+ infinity.
+ */
+struct BoxConstraint {
+  /** Indices of the bounded entries */
+  std::vector<int> indices;
+  /** Lower bounds of the bounded entries */
+  vector_t lowerBound;
+  /** Upper bounds of the bounded entries */
+  vector_t upperBound;
+
+  /** Default constructor, creates an empty box */
+  BoxConstraint() = default;
+
+  /**
+   * Constructor
+   *
+   * @param [in] indicesIn: Indices of the bounded entries.
+   * @param [in] lowerBoundIn: Lower bounds of the bounded entries.
+   * @param [in] upperBoundIn: Upper bounds of the bounded entries.
+   */
+  BoxConstraint(std::vector<int> indicesIn, vector_t lowerBoundIn, vector_t upperBoundIn)
+      : indices(std::move(indicesIn)), lowerBound(std::move(lowerBoundIn)), upperBound(std::move(upperBoundIn)) {
+    if (lowerBound.size() != indices.size() || upperBound.size() != indices.size()) {
+      throw std::runtime_error("[BoxConstraint] The bounds have size " + std::to_string(lowerBound.size()) + " and " +
+                               std::to_string(upperBound.size()) + " for " + std::to_string(indices.size()) + " indices.");
+    }
+  }
+
+  /** Number of bounded entries */
+  size_t size() const { return indices.size(); }
+
+  /** Whether no entry is bounded */
+  bool empty() const { return indices.empty(); }
+};
+
+}  // namespace ocs2
@@ -34,7 +34,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
-enum class SensitivityIntegratorType { EULER, RK2, RK4 };
+/**
+ * Explicit EULER, RK2 and RK4 and the implicit IMPLICIT_EULER, IMPLICIT_MIDPOINT and RADAU_IIA2 (two stage Radau IIA collocation).
+ * The implicit discretizations are A-stable and allow larger intervals for stiff dynamics. Their stage equations are solved with Newton's
+ * method, and their sensitivities follow from the implicit function theorem. If Newton's method does not converge, they print a warning
+ * and use the last iterate.
+ */
+enum class SensitivityIntegratorType { EULER, RK2, RK4, IMPLICIT_EULER, IMPLICIT_MIDPOINT, RADAU_IIA2 };
 
 namespace sensitivity_integrator {
 
@@ -76,4 +76,47 @@ vector_t rk4Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt);
 
+/**
+ * Computes the discretized dynamics. Uses a backward euler discretization, x_{k+1} = x_{k} + dt * f(t + dt, x_{k+1}, u_{k}).
+ * Returns x_{k+1}
+ */
+vector_t implicitEulerDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt);
+
+/**
+ * Creates a linear approximation of the discretized dynamics. Uses a backward euler discretization.
+ * Returns an approximation of the form:
+ *      x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+ */
+VectorFunctionLinearApproximation implicitEulerSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                         const vector_t& u, scalar_t dt);
+
+/**
+ * Computes the discretized dynamics. Uses an implicit midpoint discretization,
+ *      x_{k+1} = x_{k} + dt * f(t + dt/2, (x_{k} + x_{k+1})/2, u_{k})
+ * Returns x_{k+1}
+ */
+vector_t implicitMidpointDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt);
+
+/**
+ * Creates a linear approximation of the discretized dynamics. Uses an implicit midpoint discretization.
+ * Returns an approximation of the form:
+ *      x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+ */
+VectorFunctionLinearApproximation implicitMidpointSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                            const vector_t& u, scalar_t dt);
+
+/**
+ * Computes the discretized dynamics. Uses a two stage Radau IIA collocation (3rd order) discretization.
+ * Returns x_{k+1}
+ */
+vector_t radauIIA2Discretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt);
+
+/**
+ * Creates a linear approximation of the discretized dynamics. Uses a two stage Radau IIA collocation (3rd order) discretization.
+ * Returns an approximation of the form:
+ *      x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
+ */
+VectorFunctionLinearApproximation radauIIA2SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                     const vector_t& u, scalar_t dt);
+
 }  // namespace ocs2
\ No newline at end of file
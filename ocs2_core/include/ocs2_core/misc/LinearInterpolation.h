@@ -53,6 +53,17 @@ using remove_cvref_t = typename std::remove_cv<typename std::remove_reference<T>
  */
 index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
 
+/**
+ * Same as timeSegment, but the lookup starts from a cursor which is updated for the next enquiry. For monotonically increasing
+ * enquiry times the lookup is amortized O(1). A negative cursor starts a binary search.
+ *
+ * @param [in] enquiryTime: The enquiry time for interpolation.
+ * @param [in] timeArray: interpolation time array.
+ * @param [in, out] lowerBoundIndex: The index of the first time in timeArray which is not smaller than the enquiry time.
+ * @return {index, alpha}
+ */
+index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, int& lowerBoundIndex);
+
 /**
  * Directly uses the index and interpolation coefficient provided by the user
  * @note If sizes in data array are not equal, the interpolation will snap to the data
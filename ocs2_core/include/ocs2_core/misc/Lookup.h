@@ -91,6 +91,28 @@ int findIndexInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time) {
   return static_cast<int>(firstLargerValueIterator - timeArray.begin());
 }
 
+/**
+ * Same as findIndexInTimeArray, but the search starts from a hint, e.g. the index found by the previous enquiry. If the hint is not
+ * before the enquiry time, a binary search is used. For monotonically increasing enquiry times the search is amortized O(1).
+ *
+ * @tparam SCALAR : numerical type of time
+ * @param timeArray : sorted time array to perform the lookup in
+ * @param time : enquiry time
+ * @param hint : index to start the search from
+ * @return index between [0, size(timeArray)]
+ */
+template <typename SCALAR = double>
+int findIndexInTimeArray(const std::vector<SCALAR>& timeArray, SCALAR time, int hint) {
+  const auto size = static_cast<int>(timeArray.size());
+  if (hint < 0 || hint > size || (hint > 0 && timeArray[hint - 1] >= time)) {
+    return findIndexInTimeArray(timeArray, time);
+  }
+  while (hint < size && timeArray[hint] < time) {
+    ++hint;
+  }
+  return hint;
+}
+
 /**
  *  Find interval into a sorted time Array
  *
@@ -67,12 +67,21 @@ const Data& stdAccessFun(const std::vector<Data, Alloc>& vec, size_t ind) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
+  int lowerBoundIndex = -1;  // no hint: binary search
+  return timeSegment(enquiryTime, timeArray, lowerBoundIndex);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, int& lowerBoundIndex) {
   // corner cases (no time set OR single time element)
   if (timeArray.size() <= 1) {
     return {0, scalar_t(1.0)};
   }
 
-  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+  lowerBoundIndex = lookup::findIndexInTimeArray(timeArray, enquiryTime, lowerBoundIndex);
+  const int index = lowerBoundIndex - 1;
   const auto lastInterval = static_cast<int>(timeArray.size() - 1);
   if (index >= 0) {
     if (index < lastInterval) {
@@ -73,4 +73,30 @@ inline void setThisThreadPriority(int priority) {
   setThreadPriority(priority, pthread_self());
 }
 
+/**
+ * Pins the input thread to a CPU core.
+ *
+ * @param cpu: The index of the CPU core
+ * @param thread: A reference to the tread.
+ */
+inline void setThreadAffinity(int cpu, pthread_t thread) {
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(cpu, &cpuSet);
+
+  if (pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuSet) != 0) {
+    std::cerr << "WARNING: Failed to set the CPU affinity of a thread to core " << cpu << "." << std::endl;
+  }
+}
+
+/**
+ * Pins the input thread to a CPU core.
+ *
+ * @param cpu: The index of the CPU core
+ * @param thread: A reference to the tread.
+ */
+inline void setThreadAffinity(int cpu, std::thread& thread) {
+  setThreadAffinity(cpu, thread.native_handle());
+}
+
 }  // namespace ocs2
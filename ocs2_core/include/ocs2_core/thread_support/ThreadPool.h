@@ -29,7 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <exception>
 #include <future>
 #include <mutex>
 #include <queue>
@@ -51,6 +54,20 @@ class ThreadPool {
    */
   explicit ThreadPool(size_t nThreads = 1, int priority = 0);
 
+  /**
+   * Constructor of a pool with spinning workers. An idle worker busy-waits for new work for the given duration before it is parked.
+   * In this mode, runParallel() does not go through the task queue: the tasks are published lock-free to the workers, which claim them
+   * with an atomic counter, and the calling thread waits without futures. This reduces the fork/join overhead to a few microseconds
+   * while the workers are spinning.
+   *
+   * @param [in] nThreads: Number of threads to launch in the pool
+   * @param [in] priority: The worker thread priority
+   * @param [in] spinDuration: Time that an idle worker keeps spinning for new work before it is parked. A zero duration gives the
+   *                           regular task queue pool.
+   * @param [in] pinWorkers: If true, worker i is pinned to CPU core (i mod number of cores).
+   */
+  ThreadPool(size_t nThreads, int priority, std::chrono::microseconds spinDuration, bool pinWorkers = false);
+
   /**
    * Destructor
    */
@@ -71,6 +88,7 @@ class ThreadPool {
    * Helper function to run a task N times parallel with the help of the pool.
    * - 1 task will run in the calling thread with ID = nThreads.
    * - N-1 tasks will run on the threadpool with ID in [0, nThreads-1].
+   * With spinning workers, the calling thread and the workers claim the N tasks as they become available.
    *
    * @note This is a blocking operation, returns when all tasks are completed.
    * @warning Calling runParallel(task, nThreads) does not guarantee that each task will be executed with a different workerIndex.
@@ -96,6 +114,13 @@ class ThreadPool {
    */
   void worker(int workerIndex);
 
+  /**
+   * Thread worker loop of the spinning pool
+   *
+   * @param [in] workerIndex: worker thread index
+   */
+  void spinningWorker(int workerIndex);
+
   /**
    * Run a task asynchronously in another thread
    *
@@ -103,13 +128,43 @@ class ThreadPool {
    */
   void runTask(std::unique_ptr<TaskBase> taskPtr);
 
-  bool stop_{false};  //!< flag telling all threads to stop, protected by taskQueueLock_
+  /**
+   * Pops and runs a task from the task queue, if there is one.
+   *
+   * @param [in] workerIndex: worker thread index
+   * @return true if a task was run.
+   */
+  bool runQueuedTask(int workerIndex);
+
+  /**
+   * Claims and runs one instance of the task published by runParallel(), if there is one left.
+   *
+   * @param [in] workerIndex: worker thread index
+   * @return true if a task was run.
+   */
+  bool runParallelTask(int workerIndex);
+
+  std::atomic_bool stop_{false};  //!< flag telling all threads to stop, set while holding taskQueueLock_
 
   std::queue<std::unique_ptr<TaskBase>> taskQueue_;  // protected by taskQueueLock_
   std::condition_variable taskQueueCondition_;
   std::mutex taskQueueLock_;
 
   std::vector<std::thread> workerThreads_;
+
+  // Spinning workers
+  bool isSpinning_{false};
+  std::chrono::microseconds spinDuration_{0};
+  std::atomic_size_t numQueuedTasks_{0};  // size of taskQueue_, readable without taking the lock
+  std::atomic_int numParkedWorkers_{0};
+
+  // Lock-free fork/join of runParallel() with spinning workers
+  std::mutex parallelJobLock_;                                // serializes concurrent calls to runParallel()
+  const std::function<void(int)>* parallelTaskPtr_{nullptr};  // published through numUnclaimedParallelTasks_
+  std::atomic_int numUnclaimedParallelTasks_{0};
+  std::atomic_int numUnfinishedParallelTasks_{0};
+  std::exception_ptr parallelTaskException_;  // protected by parallelTaskExceptionLock_
+  std::mutex parallelTaskExceptionLock_;
 };
 
 /**
@@ -0,0 +1,105 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace ocs2 {
+
+/**
+ * Wait-free single-producer single-consumer exchange of a value through three slots. The consumer owns the active slot and the producer
+ * owns the buffer slot. Publishing the buffer and updating the active value swap the slot with the shared middle slot in a single atomic
+ * exchange, so neither side ever blocks the other and the consumer always gets the latest published value.
+ *
+ * Only one thread should write to the buffer (getBuffer() and publishBuffer()) and only one thread should access the active value
+ * (get() and updateFromBuffer()). The values are never copied or moved by the exchange, so the previous content of a slot is handed back
+ * to the producer and can be released or reused there.
+ *
+ * @tparam T : wrapped type
+ */
+template <typename T>
+class TripleBuffer {
+ public:
+  /** Constructor initializes the three slots with default constructed values. */
+  TripleBuffer() : activeIndex_(0), bufferIndex_(1), middleIndex_(2) {}
+
+  /** Read the currently active value. */
+  const T& get() const { return slots_[activeIndex_]; }
+
+  /** Read/write the currently active value. */
+  T& get() { return slots_[activeIndex_]; }
+
+  /** Read/write the buffer of the producer. The content is the value which was active two updates ago, or a never consumed value. */
+  T& getBuffer() { return slots_[bufferIndex_]; }
+
+  /** Publishes the buffer to the consumer. The buffer slot is replaced by the middle slot. */
+  void publishBuffer() { bufferIndex_ = middleIndex_.exchange(bufferIndex_ | newValueFlag_, std::memory_order_acq_rel) & indexMask_; }
+
+  /** Whether a value has been published since the last updateFromBuffer. */
+  bool hasNewValue() const { return (middleIndex_.load(std::memory_order_acquire) & newValueFlag_) != 0; }
+
+  /**
+   * Replaces the active value with the latest published value.
+   * @return True: the active value was updated, False: no value was published since the last update.
+   */
+  bool updateFromBuffer() {
+    if (!hasNewValue()) {
+      return false;
+    }
+    activeIndex_ = middleIndex_.exchange(activeIndex_, std::memory_order_acq_rel) & indexMask_;
+    return true;
+  }
+
+  /** Resets all slots to default constructed values. This method is NOT thread-safe. */
+  void reset() {
+    for (auto& slot : slots_) {
+      slot = T();
+    }
+    middleIndex_.store(middleIndex_.load() & indexMask_);
+  }
+
+ private:
+  static constexpr uint8_t indexMask_ = 0x3;
+  static constexpr uint8_t newValueFlag_ = 0x4;
+
+  std::array<T, 3> slots_;
+  uint8_t activeIndex_;               // owned by the consumer
+  uint8_t bufferIndex_;               // owned by the producer
+  std::atomic<uint8_t> middleIndex_;  // shared, carries the new value flag
+};
+
+template <typename T>
+constexpr uint8_t TripleBuffer<T>::indexMask_;
+template <typename T>
+constexpr uint8_t TripleBuffer<T>::newValueFlag_;
+
+}  // namespace ocs2
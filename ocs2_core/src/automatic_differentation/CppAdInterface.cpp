@@ -29,10 +29,129 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 
+#include <cstdint>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
 #include <boost/filesystem.hpp>
 
 namespace ocs2 {
 
+namespace {
+/** Appends the bytes of a value to a string */
+template <typename T>
+void appendBytes(std::string& sequence, const T& value) {
+  sequence.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+}  // namespace
+
+struct CppAdInterface::ModelGeneration {
+  /** Exposes the source generation of the library processor, such that all sources are generated before compilation. */
+  class LibraryProcessor : public CppAD::cg::DynamicModelLibraryProcessor<scalar_t> {
+   public:
+    using CppAD::cg::DynamicModelLibraryProcessor<scalar_t>::DynamicModelLibraryProcessor;
+
+    /** Generates the sources of all models and of the library. They are cached by the source generators. */
+    void generateSources() {
+      for (const auto& model : this->modelLibraryHelper_->getModels()) {
+        this->getSources(*model.second);
+      }
+      this->getLibrarySources();
+    }
+  };
+
+  /**
+   * Serializes the operation sequence of a taped function: the operation graph of its zero order forward sweep, numbered in post-order.
+   * Each operation is written with its type, its info, and its arguments, either as index of an earlier operation or as parameter value.
+   * This identifies the function without generating the sources of its derivatives.
+   */
+  static std::string serializeOperationSequence(ad_fun_t& fun) {
+    using node_t = CppAD::cg::OperationNode<scalar_t>;
+
+    CppAD::cg::CodeHandler<scalar_t> handler;
+    std::vector<ad_base_t> independent(fun.Domain());
+    handler.makeVariables(independent);
+    const std::vector<ad_base_t> dependent = fun.Forward(0, independent);
+
+    std::string sequence;
+
+    // Depth-first traversal with an explicit stack, the graph of large models is too deep for recursion
+    std::unordered_map<const node_t*, size_t> nodeIndices;
+    std::vector<std::pair<const node_t*, size_t>> stack;  // node and its next argument to visit
+    auto serializeNode = [&](const node_t* root) {
+      stack.emplace_back(root, 0);
+      while (!stack.empty()) {
+        const node_t* node = stack.back().first;
+        const auto& arguments = node->getArguments();
+        if (stack.back().second < arguments.size()) {
+          const node_t* argument = arguments[stack.back().second++].getOperation();
+          if (argument != nullptr && nodeIndices.count(argument) == 0) {
+            stack.emplace_back(argument, 0);
+          }
+          continue;
+        }
+        stack.pop_back();
+        if (nodeIndices.count(node) > 0) {  // shared argument of several operations on the stack
+          continue;
+        }
+
+        appendBytes(sequence, static_cast<uint32_t>(node->getOperationType()));
+        if (node->getOperationType() == CppAD::cg::CGOpCode::Inv) {
+          appendBytes(sequence, static_cast<uint64_t>(handler.getIndependentVariableIndex(*node)));
+        }
+        appendBytes(sequence, static_cast<uint64_t>(node->getInfo().size()));
+        for (const auto info : node->getInfo()) {
+          appendBytes(sequence, static_cast<uint64_t>(info));
+        }
+        appendBytes(sequence, static_cast<uint64_t>(arguments.size()));
+        for (const auto& argument : arguments) {
+          if (argument.getOperation() != nullptr) {
+            appendBytes(sequence, 'n');
+            appendBytes(sequence, static_cast<uint64_t>(nodeIndices.at(argument.getOperation())));
+          } else {
+            appendBytes(sequence, 'p');
+            appendBytes(sequence, *argument.getParameter());
+          }
+        }
+        nodeIndices.emplace(node, nodeIndices.size());
+      }
+    };
+
+    for (const auto& y : dependent) {
+      if (y.isParameter()) {
+        appendBytes(sequence, 'p');
+        appendBytes(sequence, y.getValue());
+      } else {
+        serializeNode(y.getOperationNode());
+        appendBytes(sequence, 'n');
+        appendBytes(sequence, static_cast<uint64_t>(nodeIndices.at(y.getOperationNode())));
+      }
+    }
+    return sequence;
+  }
+
+  /** 64-bit FNV-1a hash, as hexadecimal string. Unlike std::hash, it is stable across processes and compilers. */
+  static std::string computeHash(const std::string& input) {
+    uint64_t hashValue = 14695981039346656037ULL;
+    for (const char c : input) {
+      hashValue ^= static_cast<unsigned char>(c);
+      hashValue *= 1099511628211ULL;
+    }
+    std::ostringstream hashStream;
+    hashStream << std::hex << std::setw(16) << std::setfill('0') << hashValue;
+    return hashStream.str();
+  }
+
+  ad_fun_t fun;
+  std::unique_ptr<CppAD::cg::ModelCSourceGen<scalar_t>> sourceGen;
+  std::unique_ptr<CppAD::cg::ModelLibraryCSourceGen<scalar_t>> librarySourceGen;
+  std::unique_ptr<LibraryProcessor> libraryProcessor;
+  std::string hash;
+};
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -60,16 +179,40 @@ CppAdInterface::CppAdInterface(ad_function_t adFunction, size_t variableDim, std
 /******************************************************************************************************/
 CppAdInterface::CppAdInterface(const CppAdInterface& rhs)
     : CppAdInterface(rhs.adFunction_, rhs.variableDim_, rhs.parameterDim_, rhs.modelName_, rhs.folderName_, rhs.compileFlags_) {
-  if (isLibraryAvailable()) {
+  if (rhs.library_ != nullptr) {
+    library_ = rhs.library_;
+    rangeDim_ = rhs.rangeDim_;
+    nnzJacobian_ = rhs.nnzJacobian_;
+    nnzHessian_ = rhs.nnzHessian_;
+    jacobianSparsity_ = rhs.jacobianSparsity_;
+    hessianSparsity_ = rhs.hessianSparsity_;
+    createModelFromLibrary();
+  } else if (isLibraryAvailable()) {
     loadModels(false);
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdInterface::~CppAdInterface() {
+  releaseModel();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool verbose) {
-  createFolderStructure();
+  prepareModels(approximationOrder, true, verbose);
+  compileModels(verbose);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool CppAdInterface::prepareModels(ApproximationOrder approximationOrder, bool recompileLibrary, bool verbose) {
+  modelGeneration_.reset(new ModelGeneration);
+  auto& fun = modelGeneration_->fun;
 
   // set and declare independent variables and start tape recording
   ad_vector_t xp(variableDim_ + parameterDim_);
@@ -85,18 +228,53 @@ void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool ve
   adFunction_(x, p, y);
   rangeDim_ = y.rows();
   // create f: xp -> y and stop tape recording
-  ad_fun_t fun(xp, y);
+  fun.Dependent(xp, y);
   // Optimize the operation sequence
   fun.optimize();
 
+  // Identify the library by the taped function and the options of the code generation
+  std::string hashInput = ModelGeneration::serializeOperationSequence(fun);
+  hashInput += modelName_ + "_" + std::to_string(variableDim_) + "_" + std::to_string(parameterDim_) + "_" +
+               std::to_string(static_cast<int>(approximationOrder));
+  for (const auto& flag : compileFlags_) {
+    hashInput += "_" + flag;
+  }
+  modelGeneration_->hash = ModelGeneration::computeHash(hashInput);
+
+  if (!recompileLibrary && isLibraryAvailable()) {
+    if (readLibraryHash() == modelGeneration_->hash) {
+      modelGeneration_.reset();
+      loadModels(verbose);
+      return false;
+    } else if (verbose) {
+      std::cerr << "[CppAdInterface] Library on disk is outdated: " << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION
+                << std::endl;
+    }
+  }
+
   // generates source code
-  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen(fun, modelName_);
-  setApproximationOrder(approximationOrder, sourceGen, fun);
+  modelGeneration_->sourceGen.reset(new CppAD::cg::ModelCSourceGen<scalar_t>(fun, modelName_));
+  setApproximationOrder(approximationOrder, *modelGeneration_->sourceGen, fun);
+
+  // Library processor, compiles to temporary shared library file to avoid interference between processes
+  modelGeneration_->librarySourceGen.reset(new CppAD::cg::ModelLibraryCSourceGen<scalar_t>(*modelGeneration_->sourceGen));
+  modelGeneration_->libraryProcessor.reset(new ModelGeneration::LibraryProcessor(*modelGeneration_->librarySourceGen, libraryName_ + tmpName_));
+  modelGeneration_->libraryProcessor->generateSources();
+
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::compileModels(bool verbose) {
+  if (modelGeneration_ == nullptr) {
+    throw std::runtime_error("[CppAdInterface] compileModels() requires the sources generated by prepareModels().");
+  }
+  createFolderStructure();
 
-  // Compiler objects, compile to temporary shared library file to avoid interference between processes
-  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen(sourceGen);
+  // Compiler objects
   CppAD::cg::GccCompiler<scalar_t> gccCompiler;
-  CppAD::cg::DynamicModelLibraryProcessor<scalar_t> libraryProcessor(libraryCSourceGen, libraryName_ + tmpName_);
   setCompilerOptions(gccCompiler);
 
   if (verbose) {
@@ -105,10 +283,7 @@ void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool ve
   }
 
   // Compile and store the library
-  dynamicLib_ = libraryProcessor.createDynamicLibrary(gccCompiler);
-  model_ = dynamicLib_->model(modelName_);
-
-  setSparsityNonzeros();
+  setModelLibrary(modelGeneration_->libraryProcessor->createDynamicLibrary(gccCompiler));
 
   // Rename generated library after loading
   if (verbose) {
@@ -117,6 +292,39 @@ void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool ve
   }
   boost::filesystem::rename(libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION,
                             libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
+
+  // Store the hash next to the library, written to a temporary file first such that other processes never read a partial hash
+  {
+    std::ofstream hashFile(libraryHashFile_ + tmpName_);
+    hashFile << modelGeneration_->hash;
+  }
+  boost::filesystem::rename(libraryHashFile_ + tmpName_, libraryHashFile_);
+
+  modelGeneration_.reset();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::loadOrCreateModels(const std::vector<std::pair<CppAdInterface*, ApproximationOrder>>& adInterfaces,
+                                        bool recompileLibraries, bool verbose) {
+  // Taping uses CppAD, which is not thread-safe
+  std::vector<CppAdInterface*> interfacesToCompile;
+  for (const auto& adInterface : adInterfaces) {
+    if (adInterface.first->prepareModels(adInterface.second, recompileLibraries, verbose)) {
+      interfacesToCompile.push_back(adInterface.first);
+    }
+  }
+
+  // The sources are ready, compilation of the libraries is independent
+  std::vector<std::future<void>> compilations;
+  compilations.reserve(interfacesToCompile.size());
+  for (auto* adInterface : interfacesToCompile) {
+    compilations.push_back(std::async(std::launch::async, [adInterface, verbose]() { adInterface->compileModels(verbose); }));
+  }
+  for (auto& compilation : compilations) {
+    compilation.get();
+  }
 }
 
 /******************************************************************************************************/
@@ -127,21 +335,17 @@ void CppAdInterface::loadModels(bool verbose) {
     std::cerr << "[CppAdInterface] Loading Shared Library: " << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION
               << std::endl;
   }
-  dynamicLib_.reset(new CppAD::cg::LinuxDynamicLib<scalar_t>(libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION));
-  model_ = dynamicLib_->model(modelName_);
-  rangeDim_ = model_->Range();
-
-  setSparsityNonzeros();
+  std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> dynamicLib(
+      new CppAD::cg::LinuxDynamicLib<scalar_t>(libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION));
+  setModelLibrary(std::move(dynamicLib));
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void CppAdInterface::loadModelsIfAvailable(ApproximationOrder approximationOrder, bool verbose) {
-  if (isLibraryAvailable()) {
-    loadModels(verbose);
-  } else {
-    createModels(approximationOrder, verbose);
+  if (prepareModels(approximationOrder, false, verbose)) {
+    compileModels(verbose);
   }
 }
 
@@ -149,12 +353,11 @@ void CppAdInterface::loadModelsIfAvailable(ApproximationOrder approximationOrder
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p) const {
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
+  setVariablesAndParameters(x, p);
 
   vector_t functionValue(model_->Range());
 
-  model_->ForwardZero(xp, functionValue);
+  model_->ForwardZero(xpBuffer_, functionValue);
   assert(functionValue.allFinite());
   return functionValue;
 }
@@ -163,63 +366,56 @@ vector_t CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p)
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getJacobian(const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
+  matrix_t jacobian;
+  getJacobian(x, p, jacobian);
+  return jacobian;
+}
 
-  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
-  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
-  size_t const* rows;
-  size_t const* cols;
-  // Call this particular SparseJacobian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
-  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getJacobian(const vector_t& x, const vector_t& p, matrix_t& jacobian) const {
+  evaluateSparseJacobian(x, p);
 
   // Write sparse elements into Eigen type. Only jacobian w.r.t. variables was requested, so cols should not contain elements corresponding
   // to parameters.
-  matrix_t jacobian = matrix_t::Zero(model_->Range(), variableDim_);
+  jacobian.setZero(rangeDim_, variableDim_);
   for (size_t i = 0; i < nnzJacobian_; i++) {
-    jacobian(rows[i], cols[i]) = sparseJacobian[i];
+    jacobian(jacobianSparsity_.rows[i], jacobianSparsity_.cols[i]) = sparseJacobianBuffer_[i];
   }
 
   assert(jacobian.allFinite());
-  return jacobian;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation(const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
-
   ScalarFunctionQuadraticApproximation gnApprox;
 
   // Zero order
-  vector_t valueVector(model_->Range());
-  model_->ForwardZero(xp, valueVector);
-  gnApprox.f = 0.5 * valueVector.squaredNorm();
+  setVariablesAndParameters(x, p);
+  valueBuffer_.resize(rangeDim_);
+  model_->ForwardZero(xpBuffer_, valueBuffer_);
+  gnApprox.f = 0.5 * valueBuffer_.squaredNorm();
 
   // Jacobian
-  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
-  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
-  size_t const* rows;
-  size_t const* cols;
-  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+  evaluateSparseJacobian(x, p);
+  const auto& rows = jacobianSparsity_.rows;
+  const auto& cols = jacobianSparsity_.cols;
+  const auto& sparseJacobian = sparseJacobianBuffer_;
 
   // Sparse evaluation of J' * f
   gnApprox.dfdx.setZero(variableDim_);
   for (size_t i = 0; i < nnzJacobian_; i++) {
-    gnApprox.dfdx(cols[i]) += sparseJacobian[i] * valueVector(rows[i]);
+    gnApprox.dfdx(cols[i]) += sparseJacobian[i] * valueBuffer_(rows[i]);
   }
 
   /*
    * Sparse construction of the GN matrix, H = J' * J.
    * H(i, j) = sum_rows { J(row, i) * J(row, j) }
    * Because the sparse elements are ordered first by row, then by column, we process J row-by-row.
-   * For each row of J, we add the non-zero pairs (i, j) to H(i, j).
+   * For each row of J, we add the non-zero pairs (i, j) with i <= j to the upper triangle of H.
    */
   gnApprox.dfdxx.setZero(variableDim_, variableDim_);
   for (size_t i = 0; i < nnzJacobian_; ++i) {
@@ -229,14 +425,12 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
     // Diagonal element always exists:
     gnApprox.dfdxx(col_i, col_i) += v_i * v_i;
     // Process off-diagonals
-    size_t j = i + 1;
-    while (rows[j] == row_i) {
-      const size_t col_j = cols[j];
-      gnApprox.dfdxx(col_j, col_i) += v_i * sparseJacobian[j];
-      gnApprox.dfdxx(col_i, col_j) = gnApprox.dfdxx(col_j, col_i);  // Maintain symmetry as we go.
-      ++j;
+    for (size_t j = i + 1; j < nnzJacobian_ && rows[j] == row_i; ++j) {
+      gnApprox.dfdxx(col_i, cols[j]) += v_i * sparseJacobian[j];
     }
   }
+  // Copy upper triangular to lower triangular part
+  gnApprox.dfdxx.template triangularView<Eigen::StrictlyLower>() = gnApprox.dfdxx.template triangularView<Eigen::StrictlyUpper>().transpose();
 
   assert(gnApprox.dfdx.allFinite());
   assert(gnApprox.dfdxx.allFinite());
@@ -257,25 +451,12 @@ matrix_t CppAdInterface::getHessian(size_t outputIndex, const vector_t& x, const
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xp.data(), xp.size());
-
-  std::vector<scalar_t> sparseHessian(nnzHessian_);
-  CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(sparseHessian);
-  size_t const* rows;
-  size_t const* cols;
-
-  CppAD::cg::ArrayView<const scalar_t> wArrayView(w.data(), w.size());
-
-  // Call this particular SparseHessian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
-  model_->SparseHessian(xpArrayView, wArrayView, sparseHessianArrayView, &rows, &cols);
+  evaluateSparseHessian(w, x, p);
 
   // Fills upper triangular sparsity of hessian w.r.t variables.
   matrix_t hessian = matrix_t::Zero(variableDim_, variableDim_);
   for (size_t i = 0; i < nnzHessian_; i++) {
-    hessian(rows[i], cols[i]) = sparseHessian[i];
+    hessian(hessianSparsity_.rows[i], hessianSparsity_.cols[i]) = sparseHessianBuffer_[i];
   }
 
   // Copy upper triangular to lower triangular part
@@ -285,6 +466,76 @@ matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const
   return hessian;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::setVariablesAndParameters(const vector_t& x, const vector_t& p) const {
+  xpBuffer_.resize(variableDim_ + parameterDim_);
+  xpBuffer_ << x, p;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::evaluateSparseJacobian(const vector_t& x, const vector_t& p) const {
+  setVariablesAndParameters(x, p);
+  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xpBuffer_.data(), xpBuffer_.size());
+
+  sparseJacobianBuffer_.resize(nnzJacobian_);
+  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobianBuffer_);
+  size_t const* rows;
+  size_t const* cols;
+  // Call this particular SparseJacobian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
+  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::evaluateSparseHessian(const vector_t& w, const vector_t& x, const vector_t& p) const {
+  setVariablesAndParameters(x, p);
+  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xpBuffer_.data(), xpBuffer_.size());
+  CppAD::cg::ArrayView<const scalar_t> wArrayView(w.data(), w.size());
+
+  sparseHessianBuffer_.resize(nnzHessian_);
+  CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(sparseHessianBuffer_);
+  size_t const* rows;
+  size_t const* cols;
+  // Call this particular SparseHessian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
+  model_->SparseHessian(xpArrayView, wArrayView, sparseHessianArrayView, &rows, &cols);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::setModelLibrary(std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> dynamicLib) {
+  // The current model is registered with the previous library, which might still be used by copies.
+  releaseModel();
+
+  library_ = std::make_shared<ModelLibrary>(std::move(dynamicLib));
+  createModelFromLibrary();
+  rangeDim_ = model_->Range();
+  setSparsityNonzeros();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::createModelFromLibrary() {
+  std::lock_guard<std::mutex> lock(library_->mutex);
+  model_ = library_->dynamicLib->model(modelName_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::releaseModel() {
+  if (model_ != nullptr) {
+    std::lock_guard<std::mutex> lock(library_->mutex);
+    model_.reset();
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -297,6 +548,7 @@ void CppAdInterface::setFolderNames() {
   tmpName_ = getUniqueTemporaryName();
   tmpFolder_ = libraryFolder_ + "/" + tmpName_;
   libraryName_ = libraryFolder_ + "/" + modelName_ + "_lib";
+  libraryHashFile_ = libraryName_ + ".hash";
 }
 
 /******************************************************************************************************/
@@ -306,6 +558,16 @@ bool CppAdInterface::isLibraryAvailable() const {
   return boost::filesystem::exists(libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::readLibraryHash() const {
+  std::ifstream hashFile(libraryHashFile_);
+  std::string hash;
+  hashFile >> hash;
+  return hash;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -368,10 +630,12 @@ void CppAdInterface::setApproximationOrder(ApproximationOrder approximationOrder
 /******************************************************************************************************/
 void CppAdInterface::setSparsityNonzeros() {
   if (model_->isJacobianSparsityAvailable()) {
-    nnzJacobian_ = cppad_sparsity::getNumberOfNonZeros(model_->JacobianSparsitySet());
+    model_->JacobianSparsity(jacobianSparsity_.rows, jacobianSparsity_.cols);
+    nnzJacobian_ = jacobianSparsity_.size();
   }
   if (model_->isHessianSparsityAvailable()) {
-    nnzHessian_ = cppad_sparsity::getNumberOfNonZeros(model_->HessianSparsitySet());
+    model_->HessianSparsity(hessianSparsity_.rows, hessianSparsity_.cols);
+    nnzHessian_ = hessianSparsity_.size();
   }
 }
 
@@ -82,15 +82,11 @@ void SystemDynamicsBaseAD::initialize(size_t stateDim, size_t inputDim, const st
   guardSurfacesADInterfacePtr_.reset(
       new CppAdInterface(guardSurfaces, 1 + stateDim, getNumGuardSurfacesParameters(), modelName + "_guard_surfaces", modelFolder));
 
-  if (recompileLibraries) {
-    flowMapADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    jumpMapADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    guardSurfacesADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-  } else {
-    flowMapADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    jumpMapADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    guardSurfacesADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-  }
+  // Compile the libraries concurrently
+  CppAdInterface::loadOrCreateModels({{flowMapADInterfacePtr_.get(), CppAdInterface::ApproximationOrder::First},
+                                      {jumpMapADInterfacePtr_.get(), CppAdInterface::ApproximationOrder::First},
+                                      {guardSurfacesADInterfacePtr_.get(), CppAdInterface::ApproximationOrder::First}},
+                                     recompileLibraries, verbose);
 }
 
 /******************************************************************************************************/
@@ -127,7 +123,7 @@ VectorFunctionLinearApproximation SystemDynamicsBaseAD::linearApproximation(scal
                                                                             const PreComputation&) {
   tapedTimeStateInput_ << t, x, u;
   const vector_t parameters = getFlowMapParameters(t);
-  flowJacobian_ = flowMapADInterfacePtr_->getJacobian(tapedTimeStateInput_, parameters);
+  flowMapADInterfacePtr_->getJacobian(tapedTimeStateInput_, parameters, flowJacobian_);
 
   VectorFunctionLinearApproximation approximation;
   approximation.dfdx = flowJacobian_.middleCols(1, x.rows());
@@ -142,7 +138,7 @@ VectorFunctionLinearApproximation SystemDynamicsBaseAD::linearApproximation(scal
 VectorFunctionLinearApproximation SystemDynamicsBaseAD::jumpMapLinearApproximation(scalar_t t, const vector_t& x, const PreComputation&) {
   tapedTimeState_ << t, x;
   const vector_t parameters = getJumpMapParameters(t);
-  jumpJacobian_ = jumpMapADInterfacePtr_->getJacobian(tapedTimeState_, parameters);
+  jumpMapADInterfacePtr_->getJacobian(tapedTimeState_, parameters, jumpJacobian_);
 
   VectorFunctionLinearApproximation approximation;
   approximation.dfdx = jumpJacobian_.rightCols(x.rows());
@@ -157,7 +153,7 @@ VectorFunctionLinearApproximation SystemDynamicsBaseAD::jumpMapLinearApproximati
 VectorFunctionLinearApproximation SystemDynamicsBaseAD::guardSurfacesLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u) {
   tapedTimeState_ << t, x;
   const vector_t parameters = getGuardSurfacesParameters(t);
-  guardJacobian_ = guardSurfacesADInterfacePtr_->getJacobian(tapedTimeState_, parameters);
+  guardSurfacesADInterfacePtr_->getJacobian(tapedTimeState_, parameters, guardJacobian_);
 
   VectorFunctionLinearApproximation approximation;
   approximation.dfdx = guardJacobian_.rightCols(x.rows());
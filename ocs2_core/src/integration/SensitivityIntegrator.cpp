@@ -46,6 +46,12 @@ DynamicsDiscretizer selectDynamicsDiscretization(SensitivityIntegratorType integ
       return rk2Discretization;
     case SensitivityIntegratorType::RK4:
       return rk4Discretization;
+    case SensitivityIntegratorType::IMPLICIT_EULER:
+      return implicitEulerDiscretization;
+    case SensitivityIntegratorType::IMPLICIT_MIDPOINT:
+      return implicitMidpointDiscretization;
+    case SensitivityIntegratorType::RADAU_IIA2:
+      return radauIIA2Discretization;
     default:
       throw std::runtime_error("Integrator of type " + sensitivity_integrator::toString(integratorType) + " not supported.");
   }
@@ -62,6 +68,12 @@ DynamicsSensitivityDiscretizer selectDynamicsSensitivityDiscretization(Sensitivi
       return rk2SensitivityDiscretization;
     case SensitivityIntegratorType::RK4:
       return rk4SensitivityDiscretization;
+    case SensitivityIntegratorType::IMPLICIT_EULER:
+      return implicitEulerSensitivityDiscretization;
+    case SensitivityIntegratorType::IMPLICIT_MIDPOINT:
+      return implicitMidpointSensitivityDiscretization;
+    case SensitivityIntegratorType::RADAU_IIA2:
+      return radauIIA2SensitivityDiscretization;
     default:
       throw std::runtime_error("Integrator of type " + sensitivity_integrator::toString(integratorType) + " not supported.");
   }
@@ -74,7 +86,12 @@ namespace sensitivity_integrator {
 /******************************************************************************************************/
 std::string toString(SensitivityIntegratorType integratorType) {
   static const std::unordered_map<SensitivityIntegratorType, std::string> integratorMap = {
-      {SensitivityIntegratorType::EULER, "EULER"}, {SensitivityIntegratorType::RK2, "RK2"}, {SensitivityIntegratorType::RK4, "RK4"}};
+      {SensitivityIntegratorType::EULER, "EULER"},
+      {SensitivityIntegratorType::RK2, "RK2"},
+      {SensitivityIntegratorType::RK4, "RK4"},
+      {SensitivityIntegratorType::IMPLICIT_EULER, "IMPLICIT_EULER"},
+      {SensitivityIntegratorType::IMPLICIT_MIDPOINT, "IMPLICIT_MIDPOINT"},
+      {SensitivityIntegratorType::RADAU_IIA2, "RADAU_IIA2"}};
 
   return integratorMap.at(integratorType);
 }
@@ -84,7 +101,12 @@ std::string toString(SensitivityIntegratorType integratorType) {
 /******************************************************************************************************/
 SensitivityIntegratorType fromString(const std::string& name) {
   static const std::unordered_map<std::string, SensitivityIntegratorType> integratorMap = {
-      {"EULER", SensitivityIntegratorType::EULER}, {"RK2", SensitivityIntegratorType::RK2}, {"RK4", SensitivityIntegratorType::RK4}};
+      {"EULER", SensitivityIntegratorType::EULER},
+      {"RK2", SensitivityIntegratorType::RK2},
+      {"RK4", SensitivityIntegratorType::RK4},
+      {"IMPLICIT_EULER", SensitivityIntegratorType::IMPLICIT_EULER},
+      {"IMPLICIT_MIDPOINT", SensitivityIntegratorType::IMPLICIT_MIDPOINT},
+      {"RADAU_IIA2", SensitivityIntegratorType::RADAU_IIA2}};
 
   return integratorMap.at(name);
 }
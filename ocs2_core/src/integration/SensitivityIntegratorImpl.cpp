@@ -29,8 +29,158 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_core/integration/SensitivityIntegratorImpl.h"
 
+#include <iostream>
+
+#include <Eigen/LU>
+
 namespace ocs2 {
 
+namespace {
+
+/** Butcher tableau of an implicit Runge-Kutta method */
+struct ButcherTableau {
+  matrix_t a;
+  vector_t b;
+  vector_t c;
+};
+
+ButcherTableau makeButcherTableau(std::initializer_list<scalar_t> a, std::initializer_list<scalar_t> b, std::initializer_list<scalar_t> c) {
+  const int numStages = b.size();
+  ButcherTableau tableau;
+  tableau.a = Eigen::Map<const Eigen::Matrix<scalar_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>(a.begin(), numStages, numStages);
+  tableau.b = Eigen::Map<const vector_t>(b.begin(), numStages);
+  tableau.c = Eigen::Map<const vector_t>(c.begin(), numStages);
+  return tableau;
+}
+
+const ButcherTableau& implicitEulerTableau() {
+  static const ButcherTableau tableau = makeButcherTableau({1.0}, {1.0}, {1.0});
+  return tableau;
+}
+
+const ButcherTableau& implicitMidpointTableau() {
+  static const ButcherTableau tableau = makeButcherTableau({0.5}, {1.0}, {0.5});
+  return tableau;
+}
+
+const ButcherTableau& radauIIA2Tableau() {
+  static const ButcherTableau tableau =
+      makeButcherTableau({5.0 / 12.0, -1.0 / 12.0, 3.0 / 4.0, 1.0 / 4.0}, {3.0 / 4.0, 1.0 / 4.0}, {1.0 / 3.0, 1.0});
+  return tableau;
+}
+
+constexpr int maxNumNewtonIterations = 10;
+constexpr scalar_t newtonRelativeTolerance = 1e-10;
+
+/**
+ * Jacobian of the stage equations w.r.t. the stacked stage derivatives [k_1; ...; k_s]:
+ *      block (i, j) = delta_ij * Id - dt * a_ij * dfdx_i
+ */
+matrix_t stageJacobian(const ButcherTableau& tableau, const std::vector<VectorFunctionLinearApproximation>& stages, scalar_t dt) {
+  const int numStages = stages.size();
+  const int nx = stages.front().dfdx.rows();
+  matrix_t jacobian(numStages * nx, numStages * nx);
+  for (int i = 0; i < numStages; i++) {
+    for (int j = 0; j < numStages; j++) {
+      jacobian.block(i * nx, j * nx, nx, nx) = (-dt * tableau.a(i, j)) * stages[i].dfdx;
+    }
+  }
+  jacobian.diagonal().array() += 1.0;  // plus Identity()
+  return jacobian;
+}
+
+/**
+ * Solves the stage equations k_i = f(t + c_i * dt, x + dt * sum_j a_ij * k_j, u) with Newton's method. The iterations stop when the
+ * residual is below the tolerance scaled by (1 + |x|_inf), such that large states do not ask for more than machine precision. The number
+ * of iterations is bounded; if the tolerance is not reached, a warning is printed and the last iterate is used.
+ *
+ * @param [out] k : stacked stage derivatives [k_1; ...; k_s]
+ * Returns the linear approximations of the flow map at the final stages.
+ */
+std::vector<VectorFunctionLinearApproximation> solveStages(const ButcherTableau& tableau, SystemDynamicsBase& system, scalar_t t,
+                                                           const vector_t& x, const vector_t& u, scalar_t dt, vector_t& k) {
+  const int numStages = tableau.b.size();
+  const int nx = x.size();
+
+  std::vector<VectorFunctionLinearApproximation> stages(numStages);
+  vector_t residual(numStages * nx);
+  vector_t stageState;
+  const scalar_t tolerance = newtonRelativeTolerance * (1.0 + x.lpNorm<Eigen::Infinity>());
+  k.setZero(numStages * nx);  // First iterate linearizes all stages at the starting state
+  for (int iter = 0;; iter++) {
+    for (int i = 0; i < numStages; i++) {
+      stageState = x;
+      for (int j = 0; j < numStages; j++) {
+        stageState += (dt * tableau.a(i, j)) * k.segment(j * nx, nx);
+      }
+      stages[i] = system.linearApproximation(t + tableau.c(i) * dt, stageState, u);
+      residual.segment(i * nx, nx) = k.segment(i * nx, nx) - stages[i].f;
+    }
+
+    const scalar_t residualNorm = residual.lpNorm<Eigen::Infinity>();
+    if (residualNorm < tolerance) {
+      return stages;
+    } else if (iter == maxNumNewtonIterations) {
+      std::cerr << "[implicitRungeKutta] WARNING: Newton iterations on the stage equations did not converge within "
+                << maxNumNewtonIterations << " iterations. Residual: " << residualNorm << ", time: " << t << ", dt: " << dt << "\n";
+      return stages;
+    }
+
+    k -= stageJacobian(tableau, stages, dt).partialPivLu().solve(residual);
+  }
+}
+
+/** x_{k+1} = x_{k} + dt * sum_i b_i * k_i */
+vector_t implicitRungeKuttaDiscretization(const ButcherTableau& tableau, SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                          const vector_t& u, scalar_t dt) {
+  const int nx = x.size();
+  vector_t k;
+  solveStages(tableau, system, t, x, u, dt, k);
+
+  vector_t tmp = x;
+  for (int i = 0; i < tableau.b.size(); i++) {
+    tmp += (dt * tableau.b(i)) * k.segment(i * nx, nx);
+  }
+  return tmp;
+}
+
+/**
+ * The stage sensitivities follow from the implicit function theorem on the stage equations:
+ *      J * dk/dx_{k} = [dfdx_1; ...; dfdx_s],  J * dk/du_{k} = [dfdu_1; ...; dfdu_s]
+ * with J the stage jacobian at the solution.
+ */
+VectorFunctionLinearApproximation implicitRungeKuttaSensitivityDiscretization(const ButcherTableau& tableau, SystemDynamicsBase& system,
+                                                                              scalar_t t, const vector_t& x, const vector_t& u,
+                                                                              scalar_t dt) {
+  const int numStages = tableau.b.size();
+  const int nx = x.size();
+  const int nu = u.size();
+  vector_t k;
+  const auto stages = solveStages(tableau, system, t, x, u, dt, k);
+
+  matrix_t stageSensitivity(numStages * nx, nx + nu);
+  for (int i = 0; i < numStages; i++) {
+    stageSensitivity.block(i * nx, 0, nx, nx) = stages[i].dfdx;
+    stageSensitivity.block(i * nx, nx, nx, nu) = stages[i].dfdu;
+  }
+  stageSensitivity = stageJacobian(tableau, stages, dt).partialPivLu().solve(stageSensitivity);
+
+  // Assemble discrete approximation
+  VectorFunctionLinearApproximation discreteApproximation;
+  discreteApproximation.f = x;
+  discreteApproximation.dfdx.setIdentity(nx, nx);
+  discreteApproximation.dfdu.setZero(nx, nu);
+  for (int i = 0; i < numStages; i++) {
+    const scalar_t dt_b = dt * tableau.b(i);
+    discreteApproximation.f += dt_b * k.segment(i * nx, nx);
+    discreteApproximation.dfdx += dt_b * stageSensitivity.block(i * nx, 0, nx, nx);
+    discreteApproximation.dfdu += dt_b * stageSensitivity.block(i * nx, nx, nx, nu);
+  }
+  return discreteApproximation;
+}
+
+}  // namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -168,4 +318,49 @@ VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBas
   return k1;
 }
 
-}  // namespace ocs2
\ No newline at end of file
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t implicitEulerDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+  return implicitRungeKuttaDiscretization(implicitEulerTableau(), system, t, x, u, dt);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation implicitEulerSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                         const vector_t& u, scalar_t dt) {
+  return implicitRungeKuttaSensitivityDiscretization(implicitEulerTableau(), system, t, x, u, dt);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t implicitMidpointDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+  return implicitRungeKuttaDiscretization(implicitMidpointTableau(), system, t, x, u, dt);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation implicitMidpointSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                            const vector_t& u, scalar_t dt) {
+  return implicitRungeKuttaSensitivityDiscretization(implicitMidpointTableau(), system, t, x, u, dt);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t radauIIA2Discretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+  return implicitRungeKuttaDiscretization(radauIIA2Tableau(), system, t, x, u, dt);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation radauIIA2SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
+                                                                     const vector_t& u, scalar_t dt) {
+  return implicitRungeKuttaSensitivityDiscretization(radauIIA2Tableau(), system, t, x, u, dt);
+}
+
+}  // namespace ocs2
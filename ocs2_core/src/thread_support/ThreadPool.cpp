@@ -32,6 +32,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+/** Hint to the CPU that the calling thread is busy-waiting */
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#endif
+}
+}  // namespace
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
@@ -43,6 +52,26 @@ ThreadPool::ThreadPool(size_t nThreads, int priority) {
   }
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+ThreadPool::ThreadPool(size_t nThreads, int priority, std::chrono::microseconds spinDuration, bool pinWorkers)
+    : isSpinning_(spinDuration.count() > 0), spinDuration_(spinDuration) {
+  const auto numCores = std::max(std::thread::hardware_concurrency(), 1U);
+  workerThreads_.reserve(nThreads);
+  for (size_t i = 0; i < nThreads; i++) {
+    if (isSpinning_) {
+      workerThreads_.emplace_back(&ThreadPool::spinningWorker, this, i);
+    } else {
+      workerThreads_.emplace_back(&ThreadPool::worker, this, i);
+    }
+    setThreadPriority(priority, workerThreads_.back());
+    if (pinWorkers) {
+      setThreadAffinity(i % numCores, workerThreads_.back());
+    }
+  }
+}
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
@@ -78,6 +107,7 @@ void ThreadPool::worker(int workerIndex) {
       if (!taskQueue_.empty()) {
         taskPtr = std::move(taskQueue_.front());
         taskQueue_.pop();
+        --numQueuedTasks_;
       }
     }
 
@@ -87,6 +117,34 @@ void ThreadPool::worker(int workerIndex) {
   }
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::spinningWorker(int workerIndex) {
+  auto idleSince = std::chrono::steady_clock::now();
+  while (!stop_) {
+    if (runParallelTask(workerIndex) || runQueuedTask(workerIndex)) {
+      idleSince = std::chrono::steady_clock::now();
+      continue;
+    }
+
+    // spin
+    if (std::chrono::steady_clock::now() - idleSince < spinDuration_) {
+      cpuRelax();
+      continue;
+    }
+
+    // park until new work arrives
+    {
+      std::unique_lock<std::mutex> lock(taskQueueLock_);
+      ++numParkedWorkers_;
+      taskQueueCondition_.wait(lock, [this] { return numUnclaimedParallelTasks_ > 0 || !taskQueue_.empty() || stop_; });
+      --numParkedWorkers_;
+    }
+    idleSince = std::chrono::steady_clock::now();
+  }
+}
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
@@ -94,14 +152,95 @@ void ThreadPool::runTask(std::unique_ptr<TaskBase> taskPtr) {
   {
     std::lock_guard<std::mutex> lock(taskQueueLock_);
     taskQueue_.push(std::move(taskPtr));
+    ++numQueuedTasks_;
   }
   taskQueueCondition_.notify_one();
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+bool ThreadPool::runQueuedTask(int workerIndex) {
+  if (numQueuedTasks_ == 0) {
+    return false;
+  }
+
+  std::unique_ptr<ThreadPool::TaskBase> taskPtr;
+  {
+    std::lock_guard<std::mutex> lock(taskQueueLock_);
+    if (!taskQueue_.empty()) {
+      taskPtr = std::move(taskQueue_.front());
+      taskQueue_.pop();
+      --numQueuedTasks_;
+    }
+  }
+
+  if (taskPtr) {
+    taskPtr->operator()(workerIndex);
+    return true;
+  } else {
+    return false;
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+bool ThreadPool::runParallelTask(int workerIndex) {
+  int numUnclaimed = numUnclaimedParallelTasks_.load();
+  while (numUnclaimed > 0) {
+    if (numUnclaimedParallelTasks_.compare_exchange_weak(numUnclaimed, numUnclaimed - 1)) {
+      try {
+        (*parallelTaskPtr_)(workerIndex);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(parallelTaskExceptionLock_);
+        if (!parallelTaskException_) {
+          parallelTaskException_ = std::current_exception();
+        }
+      }
+      --numUnfinishedParallelTasks_;
+      return true;
+    }
+  }
+  return false;
+}
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::runParallel(std::function<void(int)> taskFunction, int N) {
+  const auto workerId = static_cast<int>(numThreads());  // threadpool workers use ID 0 -> nThreads - 1
+
+  if (isSpinning_ && N > 1 && !workerThreads_.empty()) {
+    std::lock_guard<std::mutex> jobLock(parallelJobLock_);
+
+    // Publish the tasks, the counter of unclaimed tasks is set last.
+    parallelTaskPtr_ = &taskFunction;
+    parallelTaskException_ = nullptr;
+    numUnfinishedParallelTasks_ = N;
+    numUnclaimedParallelTasks_ = N;
+
+    // Wake up the parked workers
+    if (numParkedWorkers_ > 0) {
+      std::lock_guard<std::mutex> lock(taskQueueLock_);
+      taskQueueCondition_.notify_all();
+    }
+
+    // This thread claims tasks as well, until all of them are taken.
+    while (runParallelTask(workerId)) {
+    }
+
+    // Wait for the workers to finish.
+    while (numUnfinishedParallelTasks_ > 0) {
+      cpuRelax();
+    }
+
+    if (parallelTaskException_) {
+      std::rethrow_exception(parallelTaskException_);
+    }
+    return;
+  }
+
   // Launch tasks in helper threads
   std::vector<std::future<void>> futures;
   if (N > 1) {
@@ -113,7 +252,6 @@ void ThreadPool::runParallel(std::function<void(int)> taskFunction, int N) {
   }
 
   // Execute one instance in this thread.
-  const auto workerId = static_cast<int>(numThreads());  // threadpool workers use ID 0 -> nThreads - 1
   taskFunction(workerId);
 
   // Wait for helpers to finish.
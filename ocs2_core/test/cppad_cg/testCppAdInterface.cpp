@@ -60,3 +60,85 @@ TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailable) {
   ASSERT_TRUE(gnApproximation.dfdx.isApprox(testJacobian(x, p).transpose() * testFun(x, p)));
   ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
 }
+
+TEST_F(CppAdInterfaceParameterizedFixture, copiesShareModelLibrary) {
+  std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr(
+      new ocs2::CppAdInterface(funImpl, variableDim_, parameterDim_, "testModelCopiesShareLibrary"));
+  adInterfacePtr->createModels(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+
+  // Copies outlive the original
+  std::vector<ocs2::CppAdInterface> copies(3, *adInterfacePtr);
+  adInterfacePtr.reset();
+
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  for (const auto& adInterface : copies) {
+    ASSERT_TRUE(adInterface.getFunctionValue(x, p).isApprox(testFun(x, p)));
+    ASSERT_TRUE(adInterface.getJacobian(x, p).isApprox(testJacobian(x, p)));
+    ASSERT_TRUE(adInterface.getHessian(0, x, p).isApprox(testHessian(0, x, p)));
+    ASSERT_TRUE(adInterface.getHessian(1, x, p).isApprox(testHessian(1, x, p)));
+  }
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailableDetectsOutdatedLibrary) {
+  // Library on disk generated from a different function under the same name
+  auto scaledFunImpl = [](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+    funImpl(x, p, y);
+    y *= ad_scalar_t(2.0);
+  };
+  ocs2::CppAdInterface outdatedInterface(scaledFunImpl, variableDim_, parameterDim_, "testModelOutdated");
+  outdatedInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelOutdated");
+  ASSERT_TRUE(adInterface.prepareModels(ocs2::CppAdInterface::ApproximationOrder::Second, false, true));
+  adInterface.compileModels(true);
+
+  // Up-to-date library is loaded
+  ocs2::CppAdInterface upToDateInterface(funImpl, variableDim_, parameterDim_, "testModelOutdated");
+  ASSERT_FALSE(upToDateInterface.prepareModels(ocs2::CppAdInterface::ApproximationOrder::Second, false, true));
+
+  // A library with different derivatives is outdated
+  ocs2::CppAdInterface firstOrderInterface(funImpl, variableDim_, parameterDim_, "testModelOutdated");
+  ASSERT_TRUE(firstOrderInterface.prepareModels(ocs2::CppAdInterface::ApproximationOrder::First, false, true));
+
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  ASSERT_TRUE(adInterface.getFunctionValue(x, p).isApprox(testFun(x, p)));
+  ASSERT_TRUE(upToDateInterface.getFunctionValue(x, p).isApprox(testFun(x, p)));
+  ASSERT_TRUE(upToDateInterface.getJacobian(x, p).isApprox(testJacobian(x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, loadOrCreateModelsConcurrently) {
+  ocs2::CppAdInterface firstInterface(funImpl, variableDim_, parameterDim_, "testModelConcurrentFirst");
+  ocs2::CppAdInterface secondInterface(funImpl, variableDim_, parameterDim_, "testModelConcurrentSecond");
+  ocs2::CppAdInterface::loadOrCreateModels({{&firstInterface, ocs2::CppAdInterface::ApproximationOrder::Second},
+                                            {&secondInterface, ocs2::CppAdInterface::ApproximationOrder::First}},
+                                           true, true);
+
+  vector_t x = vector_t::Random(variableDim_);
+  vector_t p = vector_t::Random(parameterDim_);
+  ASSERT_TRUE(firstInterface.getJacobian(x, p).isApprox(testJacobian(x, p)));
+  ASSERT_TRUE(firstInterface.getHessian(0, x, p).isApprox(testHessian(0, x, p)));
+  ASSERT_TRUE(secondInterface.getJacobian(x, p).isApprox(testJacobian(x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, preallocatedJacobian) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelPreallocatedJacobian");
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+
+  // The preallocated output is overwritten, including its structural zeros
+  matrix_t jacobian = matrix_t::Constant(rangeDim_, variableDim_, 42.0);
+  for (int i = 0; i < 2; i++) {
+    vector_t x = vector_t::Random(variableDim_);
+    vector_t p = vector_t::Random(parameterDim_);
+    vector_t w = vector_t::Random(rangeDim_);
+
+    adInterface.getJacobian(x, p, jacobian);
+    ASSERT_TRUE(jacobian.isApprox(testJacobian(x, p)));
+    ASSERT_TRUE(adInterface.getHessian(w, x, p).isApprox(w(0) * testHessian(0, x, p) + w(1) * testHessian(1, x, p)));
+    const auto gnApproximation = adInterface.getGaussNewtonApproximation(x, p);
+    ASSERT_DOUBLE_EQ(gnApproximation.f, 0.5 * testFun(x, p).squaredNorm());
+    ASSERT_TRUE(gnApproximation.dfdx.isApprox(testJacobian(x, p).transpose() * testFun(x, p)));
+    ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
+  }
+}
@@ -27,6 +27,9 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <iostream>
+#include <sstream>
+
 #include <gtest/gtest.h>
 
 #include "ocs2_core/integration/Integrator.h"
@@ -45,6 +48,63 @@ std::unique_ptr<ocs2::LinearSystemDynamics> getSystem() {
   B << 1, 0;
   return std::unique_ptr<ocs2::LinearSystemDynamics>(new ocs2::LinearSystemDynamics(A, B));
 }
+
+/** Van der Pol oscillator with an input on the acceleration */
+class VanDerPolDynamics final : public ocs2::SystemDynamicsBase {
+ public:
+  explicit VanDerPolDynamics(ocs2::scalar_t mu) : mu_(mu) {}
+  VanDerPolDynamics* clone() const override { return new VanDerPolDynamics(*this); }
+
+  ocs2::vector_t computeFlowMap(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u, const ocs2::PreComputation&) override {
+    ocs2::vector_t dxdt(2);
+    dxdt << x(1), -x(0) + mu_ * (1.0 - x(0) * x(0)) * x(1) + u(0);
+    return dxdt;
+  }
+
+  ocs2::VectorFunctionLinearApproximation linearApproximation(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                                                              const ocs2::PreComputation& preComp) override {
+    ocs2::VectorFunctionLinearApproximation approximation;
+    approximation.f = computeFlowMap(t, x, u, preComp);
+    approximation.dfdx.resize(2, 2);
+    approximation.dfdx << 0.0, 1.0,  // clang-format off
+        -1.0 - 2.0 * mu_ * x(0) * x(1), mu_ * (1.0 - x(0) * x(0));  // clang-format on
+    approximation.dfdu.resize(2, 1);
+    approximation.dfdu << 0.0, 1.0;
+    return approximation;
+  }
+
+ private:
+  ocs2::scalar_t mu_;
+};
+
+/** Checks the sensitivities of a discretization against central finite differences of its flowmap */
+void checkImplicitSensitivity(ocs2::SensitivityIntegratorType type) {
+  auto sensitivityDiscretization = ocs2::selectDynamicsSensitivityDiscretization(type);
+  auto discretization = ocs2::selectDynamicsDiscretization(type);
+
+  VanDerPolDynamics system(2.0);
+  const ocs2::scalar_t t = 0.5;
+  const ocs2::vector_t x = ocs2::vector_t::Random(2);
+  const ocs2::vector_t u = ocs2::vector_t::Random(1);
+  const ocs2::scalar_t dt = 0.1;
+  const ocs2::scalar_t eps = 1e-6;
+
+  const auto linearizedDynamics = sensitivityDiscretization(system, t, x, u, dt);
+  ASSERT_TRUE(linearizedDynamics.f.isApprox(discretization(system, t, x, u, dt)));
+
+  for (int i = 0; i < x.size(); i++) {
+    const ocs2::vector_t dx = eps * ocs2::vector_t::Unit(x.size(), i);
+    const ocs2::vector_t finiteDifference =
+        (discretization(system, t, x + dx, u, dt) - discretization(system, t, x - dx, u, dt)) / (2.0 * eps);
+    ASSERT_TRUE(linearizedDynamics.dfdx.col(i).isApprox(finiteDifference, 1e-6));
+  }
+  for (int i = 0; i < u.size(); i++) {
+    const ocs2::vector_t du = eps * ocs2::vector_t::Unit(u.size(), i);
+    const ocs2::vector_t finiteDifference =
+        (discretization(system, t, x, u + du, dt) - discretization(system, t, x, u - du, dt)) / (2.0 * eps);
+    ASSERT_TRUE(linearizedDynamics.dfdu.col(i).isApprox(finiteDifference, 1e-6));
+  }
+}
 }  // namespace
 
 TEST(test_sensitivity_integrator, eulerSensitivity) {
@@ -209,4 +269,161 @@ TEST(test_sensitivity_integrator, vsBoostRK4) {
 
   // Check
   ASSERT_TRUE(rk4ForwardDynamics.isApprox(boostRk4ForwardDynamics));
-}
\ No newline at end of file
+}
+
+TEST(test_sensitivity_integrator, implicitEulerSensitivity) {
+  auto type = ocs2::SensitivityIntegratorType::IMPLICIT_EULER;
+  auto implicitEulerSensitivityDiscretization = ocs2::selectDynamicsSensitivityDiscretization(type);
+  auto implicitEulerDiscretization = ocs2::selectDynamicsDiscretization(type);
+
+  ocs2::matrix_t A(2, 2);
+  A << -2, -1,  // clang-format off
+      1,  0;  // clang-format on
+  ocs2::matrix_t B(2, 1);
+  B << 1, 0;
+  ocs2::LinearSystemDynamics system(A, B);
+  ocs2::scalar_t t = 0.5;
+  ocs2::vector_t x = ocs2::vector_t::Random(2);
+  ocs2::vector_t u = ocs2::vector_t::Random(1);
+  ocs2::scalar_t dt = 0.1;
+
+  // For linear dynamics: x_{k+1} = (Id - dt * A)^-1 * (x_{k} + dt * B * u_{k})
+  const ocs2::matrix_t inverse = (ocs2::matrix_t::Identity(2, 2) - dt * A).inverse();
+  const ocs2::vector_t f_check = inverse * (x + dt * B * u);
+  const ocs2::matrix_t dfdx_check = inverse;
+  const ocs2::matrix_t dfdu_check = dt * inverse * B;
+
+  const auto implicitEulerForwardDynamics = implicitEulerDiscretization(system, t, x, u, dt);
+  ASSERT_TRUE(implicitEulerForwardDynamics.isApprox(f_check));
+  const auto implicitEulerLinearizedDynamics = implicitEulerSensitivityDiscretization(system, t, x, u, dt);
+  ASSERT_TRUE(implicitEulerLinearizedDynamics.f.isApprox(f_check));
+  ASSERT_TRUE(implicitEulerLinearizedDynamics.dfdx.isApprox(dfdx_check));
+  ASSERT_TRUE(implicitEulerLinearizedDynamics.dfdu.isApprox(dfdu_check));
+}
+
+TEST(test_sensitivity_integrator, implicitSensitivityVsFiniteDifference) {
+  checkImplicitSensitivity(ocs2::SensitivityIntegratorType::IMPLICIT_EULER);
+  checkImplicitSensitivity(ocs2::SensitivityIntegratorType::IMPLICIT_MIDPOINT);
+  checkImplicitSensitivity(ocs2::SensitivityIntegratorType::RADAU_IIA2);
+}
+
+TEST(test_sensitivity_integrator, implicitVsBoostRK4) {
+  VanDerPolDynamics system(2.0);
+  ocs2::scalar_t t = 0.5;
+  ocs2::vector_t x = ocs2::vector_t::Random(2);
+  ocs2::vector_t u = ocs2::vector_t::Random(1);
+  ocs2::scalar_t dt = 0.01;
+
+  // Boost version
+  auto integrator = newIntegrator(ocs2::IntegratorType::RK4);
+  ocs2::scalar_array_t timeTrajectory;
+  ocs2::vector_array_t stateTrajectory;
+  auto observer = ocs2::Observer(&stateTrajectory, &timeTrajectory);
+  ocs2::FeedforwardController controller({t, t}, {u, u});
+  system.setController(&controller);
+  integrator->integrateConst(system, observer, x, t, t + dt, dt / 10.0, 100);
+  const auto boostRk4ForwardDynamics = stateTrajectory.back();
+
+  // The local error of the implicit discretizations decreases with their order
+  const auto error = [&](ocs2::SensitivityIntegratorType type) {
+    return (ocs2::selectDynamicsDiscretization(type)(system, t, x, u, dt) - boostRk4ForwardDynamics).norm();
+  };
+  ASSERT_LT(error(ocs2::SensitivityIntegratorType::IMPLICIT_EULER), 1e-3);
+  ASSERT_LT(error(ocs2::SensitivityIntegratorType::IMPLICIT_MIDPOINT), 1e-5);
+  ASSERT_LT(error(ocs2::SensitivityIntegratorType::RADAU_IIA2), 1e-7);
+}
+
+TEST(test_sensitivity_integrator, stiffDynamics) {
+  // Eigenvalues at -1 and -1000
+  ocs2::matrix_t A(2, 2);
+  A << -1, 0,  // clang-format off
+      0, -1000;  // clang-format on
+  ocs2::matrix_t B(2, 1);
+  B << 1, 1;
+  ocs2::LinearSystemDynamics system(A, B);
+  const ocs2::vector_t u = ocs2::vector_t::Zero(1);
+  const ocs2::scalar_t dt = 0.01;  // far outside the stability region of the explicit schemes for the fast mode
+
+  // Ten steps from x = [1, 1]
+  const auto simulate = [&](ocs2::SensitivityIntegratorType type) {
+    auto discretization = ocs2::selectDynamicsDiscretization(type);
+    ocs2::vector_t x = ocs2::vector_t::Ones(2);
+    for (int k = 0; k < 10; k++) {
+      x = discretization(system, k * dt, x, u, dt);
+    }
+    return x;
+  };
+
+  ASSERT_GT(simulate(ocs2::SensitivityIntegratorType::RK4).norm(), 1e3);
+  for (const auto type : {ocs2::SensitivityIntegratorType::IMPLICIT_EULER, ocs2::SensitivityIntegratorType::IMPLICIT_MIDPOINT,
+                          ocs2::SensitivityIntegratorType::RADAU_IIA2}) {
+    const ocs2::vector_t x = simulate(type);
+    ASSERT_NEAR(x(0), std::exp(-0.1), 1e-2) << ocs2::sensitivity_integrator::toString(type);
+    ASSERT_LT(std::abs(x(1)), 1.0) << ocs2::sensitivity_integrator::toString(type);
+  }
+}
+
+TEST(test_sensitivity_integrator, implicitNoConvergence) {
+  // dx/dt = x^2: the implicit Euler step k = (x + dt * k)^2 has no real solution for x = 1 and dt = 1
+  class QuadraticDynamics final : public ocs2::SystemDynamicsBase {
+   public:
+    QuadraticDynamics* clone() const override { return new QuadraticDynamics(*this); }
+    ocs2::vector_t computeFlowMap(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u, const ocs2::PreComputation&) override {
+      return x.cwiseProduct(x);
+    }
+    ocs2::VectorFunctionLinearApproximation linearApproximation(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                                                                const ocs2::PreComputation& preComp) override {
+      ocs2::VectorFunctionLinearApproximation approximation;
+      approximation.f = computeFlowMap(t, x, u, preComp);
+      approximation.dfdx = (2.0 * x).asDiagonal();
+      approximation.dfdu.setZero(x.size(), u.size());
+      return approximation;
+    }
+  } system;
+  const ocs2::vector_t x = ocs2::vector_t::Ones(1);
+  const ocs2::vector_t u = ocs2::vector_t::Zero(1);
+
+  auto discretization = ocs2::selectDynamicsDiscretization(ocs2::SensitivityIntegratorType::IMPLICIT_EULER);
+  auto sensitivityDiscretization = ocs2::selectDynamicsSensitivityDiscretization(ocs2::SensitivityIntegratorType::IMPLICIT_EULER);
+
+  // Non-convergence warns and returns the last iterate
+  std::stringstream warning;
+  auto* cerrBuffer = std::cerr.rdbuf(warning.rdbuf());
+  const ocs2::vector_t xNext = discretization(system, 0.0, x, u, 1.0);
+  const auto linearization = sensitivityDiscretization(system, 0.0, x, u, 1.0);
+  std::cerr.rdbuf(cerrBuffer);
+  ASSERT_NE(warning.str().find("did not converge"), std::string::npos);
+  ASSERT_TRUE(xNext.allFinite());
+  ASSERT_TRUE(linearization.f.allFinite());
+  ASSERT_TRUE(linearization.dfdx.allFinite());
+
+  // A small step converges
+  warning.str("");
+  cerrBuffer = std::cerr.rdbuf(warning.rdbuf());
+  discretization(system, 0.0, x, u, 0.01);
+  std::cerr.rdbuf(cerrBuffer);
+  ASSERT_TRUE(warning.str().empty());
+}
+
+TEST(test_sensitivity_integrator, implicitLargeState) {
+  // The Newton tolerance scales with the state, such that round-off on large states does not count as non-convergence
+  ocs2::matrix_t A(2, 2);
+  A << -1, 0,  // clang-format off
+      0, -1000;  // clang-format on
+  ocs2::matrix_t B(2, 1);
+  B << 1, 1;
+  ocs2::LinearSystemDynamics system(A, B);
+  const ocs2::vector_t x = 1e8 * ocs2::vector_t::Ones(2);
+  const ocs2::vector_t u = ocs2::vector_t::Zero(1);
+  const ocs2::scalar_t dt = 0.01;
+
+  std::stringstream warning;
+  auto* cerrBuffer = std::cerr.rdbuf(warning.rdbuf());
+  for (const auto type : {ocs2::SensitivityIntegratorType::IMPLICIT_EULER, ocs2::SensitivityIntegratorType::IMPLICIT_MIDPOINT,
+                          ocs2::SensitivityIntegratorType::RADAU_IIA2}) {
+    const auto linearization = ocs2::selectDynamicsSensitivityDiscretization(type)(system, 0.0, x, u, dt);
+    ASSERT_TRUE(linearization.f.isApprox(linearization.dfdx * x, 1e-12)) << ocs2::sensitivity_integrator::toString(type);
+  }
+  std::cerr.rdbuf(cerrBuffer);
+  ASSERT_TRUE(warning.str().empty()) << warning.str();
+}
@@ -78,6 +78,17 @@ TEST(testLinearInterpolation, testEventTimeInterpolation) {
   }
 }
 
+TEST(testLinearInterpolation, testTimeSegmentCursor) {
+  std::vector<double> time{0.0, 1.0, 1.0, 2.0, 3.0};
+  int cursor = -1;
+  for (double t = -0.5; t < 3.5; t += 0.05) {
+    const auto indexAlpha = ocs2::LinearInterpolation::timeSegment(t, time, cursor);
+    ASSERT_EQ(indexAlpha, ocs2::LinearInterpolation::timeSegment(t, time));
+  }
+  // going back in time
+  ASSERT_EQ(ocs2::LinearInterpolation::timeSegment(0.5, time, cursor), ocs2::LinearInterpolation::timeSegment(0.5, time));
+}
+
 TEST(testLinearInterpolation, testSizeOneTime) {
   using Data_T = Eigen::Matrix<double, 2, 1>;
 
@@ -36,6 +36,22 @@ TEST(testLookup, findIndexInTimeArray) {
   ASSERT_EQ(findIndexInTimeArray(timeArrayEmpty, 1.0), 0);
 }
 
+TEST(testLookup, findIndexInTimeArrayWithHint) {
+  std::vector<double> timeArray{-1.0, 2.0, 2.0, 2.0, 3.0, 5.0};
+  const std::vector<double> queryTimes{-2.0, -1.0, 0.0, 1.9, 2.0, 2.1, 2.5, 3.0, 4.0, 6.0, 1.0, 2.0, 7.0, -3.0};
+  for (const int initialHint : {-1, 0, 3, 6, 7}) {
+    int hint = initialHint;
+    for (const auto time : queryTimes) {
+      hint = findIndexInTimeArray(timeArray, time, hint);
+      ASSERT_EQ(hint, findIndexInTimeArray(timeArray, time)) << "time: " << time << ", initial hint: " << initialHint;
+    }
+  }
+
+  // empty time
+  std::vector<double> timeArrayEmpty;
+  ASSERT_EQ(findIndexInTimeArray(timeArrayEmpty, 1.0, 0), 0);
+}
+
 TEST(testLookup, findIndexInTimeArray_precision_lowNumbers) {
   std::vector<double> timeArray{0.0};
   double tQuery = timeArray.front();
@@ -121,3 +121,51 @@ TEST(testThreadPool, testMoveOnlyTask) {
 
   EXPECT_EQ(result.get(), 3.14);
 }
+
+TEST(testThreadPool, testSpinningRunMultiple) {
+  ThreadPool pool(2, 0, std::chrono::microseconds(100));
+  std::atomic_int counter;
+  counter = 0;
+
+  for (int i = 0; i < 1000; i++) {
+    pool.runParallel([&](int) { counter++; }, 3);
+  }
+
+  EXPECT_EQ(counter, 3000);
+}
+
+TEST(testThreadPool, testSpinningParkedWorkers) {
+  ThreadPool pool(2, 0, std::chrono::microseconds(1));
+  std::atomic_int counter;
+  counter = 0;
+
+  // workers are parked between the calls
+  for (int i = 0; i < 10; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    pool.runParallel([&](int) { counter++; }, 42);
+  }
+
+  EXPECT_EQ(counter, 420);
+}
+
+TEST(testThreadPool, testSpinningRunTask) {
+  ThreadPool pool(2, 0, std::chrono::microseconds(100));
+
+  auto res = pool.run([](int) -> int { return 42; });
+
+  EXPECT_EQ(res.get(), 42);
+}
+
+TEST(testThreadPool, testSpinningPropagateException) {
+  ThreadPool pool(2, 0, std::chrono::microseconds(100));
+  std::atomic_int counter;
+  counter = 0;
+
+  auto task = [&](int) {
+    if (counter++ == 1) {
+      throw std::runtime_error("exception");
+    }
+  };
+  EXPECT_THROW(pool.runParallel(task, 3), std::runtime_error);
+  EXPECT_EQ(counter, 3);
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <ocs2_core/thread_support/TripleBuffer.h>
+
+TEST(testTripleBuffer, basicSetGet) {
+  ocs2::TripleBuffer<std::string> tripleBuffer;
+  ASSERT_EQ(tripleBuffer.get(), "");
+
+  // nothing published
+  ASSERT_FALSE(tripleBuffer.updateFromBuffer());
+
+  // publish
+  tripleBuffer.getBuffer() = "update";
+  tripleBuffer.publishBuffer();
+  ASSERT_EQ(tripleBuffer.get(), "");
+  ASSERT_TRUE(tripleBuffer.hasNewValue());
+
+  // update
+  ASSERT_TRUE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.get(), "update");
+
+  // update twice is false
+  ASSERT_FALSE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.get(), "update");
+
+  // only the latest of several publications is received
+  tripleBuffer.getBuffer() = "first";
+  tripleBuffer.publishBuffer();
+  tripleBuffer.getBuffer() = "second";
+  tripleBuffer.publishBuffer();
+  ASSERT_TRUE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.get(), "second");
+  ASSERT_FALSE(tripleBuffer.updateFromBuffer());
+
+  // reset
+  tripleBuffer.getBuffer() = "pending";
+  tripleBuffer.publishBuffer();
+  tripleBuffer.reset();
+  ASSERT_EQ(tripleBuffer.get(), "");
+  ASSERT_FALSE(tripleBuffer.updateFromBuffer());
+}
+
+TEST(testTripleBuffer, concurrentPublishUpdate) {
+  // the consumer should only see complete and increasing values
+  struct Value {
+    int first = 0;
+    int second = 0;
+  };
+  ocs2::TripleBuffer<Value> tripleBuffer;
+
+  constexpr int numValues = 100000;
+  std::thread producer([&]() {
+    for (int i = 1; i <= numValues; i++) {
+      auto& buffer = tripleBuffer.getBuffer();
+      buffer.first = i;
+      buffer.second = -i;
+      tripleBuffer.publishBuffer();
+    }
+  });
+
+  int lastValue = 0;
+  while (lastValue < numValues) {
+    if (tripleBuffer.updateFromBuffer()) {
+      const auto& value = tripleBuffer.get();
+      ASSERT_EQ(value.first, -value.second);
+      ASSERT_GT(value.first, lastValue);
+      lastValue = value.first;
+    }
+  }
+  producer.join();
+  ASSERT_EQ(lastValue, numValues);
+}
@@ -38,6 +38,46 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+/**
+ * The shooting nodes of the multiple-shooting forward pass. The rollout is integrated on independent shooting intervals which start at
+ * the shooting times. For a step length alpha, the state at a shooting time is states + alpha * stateIncrements.
+ */
+struct ShootingNodes {
+  // start times of the shooting intervals except the first one
+  scalar_array_t times;
+  // nominal states at the shooting times
+  vector_array_t states;
+  // state increments at the shooting times predicted by the LQ model for a full step
+  vector_array_t stateIncrements;
+
+  void clear() {
+    times.clear();
+    states.clear();
+    stateIncrements.clear();
+  }
+};
+
+/**
+ * The defects of a multiple-shooting rollout. The integration of a shooting interval generally does not end at the initial state of the
+ * next interval. The mismatch is a defect of the discrete-time dynamics from the last node of the interval to the next node.
+ */
+struct ShootingDefects {
+  // indices of the last node of each shooting interval except the final one
+  size_array_t indices;
+  // the end state of the interval's integration minus the initial state of the next interval
+  vector_array_t values;
+
+  void swap(ShootingDefects& other) {
+    indices.swap(other.indices);
+    values.swap(other.values);
+  }
+
+  void clear() {
+    indices.clear();
+    values.clear();
+  }
+};
+
 /**
  * Primal data container
  *
@@ -53,17 +93,21 @@ struct PrimalDataContainer {
   std::vector<ModelData> modelDataTrajectory;
   // event times model data
   std::vector<ModelData> modelDataEventTimes;
+  // defects of the multiple-shooting rollout
+  ShootingDefects shootingDefects;
 
   void swap(PrimalDataContainer& other) {
     primalSolution.swap(other.primalSolution);
     modelDataTrajectory.swap(other.modelDataTrajectory);
     modelDataEventTimes.swap(other.modelDataEventTimes);
+    shootingDefects.swap(other.shootingDefects);
   }
 
   void clear() {
     primalSolution.clear();
     modelDataTrajectory.clear();
     modelDataEventTimes.clear();
+    shootingDefects.clear();
   }
 };
 
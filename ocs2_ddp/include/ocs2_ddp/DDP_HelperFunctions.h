@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/penalties/MultidimensionalPenalty.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
 #include <ocs2_oc/oc_data/Metrics.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/PerformanceIndex.h>
@@ -60,6 +61,14 @@ void computeRolloutMetrics(OptimalControlProblem& problem, const PrimalSolution&
  */
 PerformanceIndex computeRolloutPerformanceIndex(const scalar_array_t& timeTrajectory, const MetricsCollection& metrics);
 
+/**
+ * Calculates the sum of squared errors (SSE) of the dynamics violation of a multiple-shooting rollout.
+ *
+ * @param [in] shootingDefects: The defects of the rollout.
+ * @return The SSE of the defects.
+ */
+scalar_t computeDynamicsViolationSSE(const ShootingDefects& shootingDefects);
+
 /**
  * Forward integrate the system dynamics with given controller. It uses the given control policies and initial state,
  * to integrate the system dynamics in time period [initTime, finalTime].
@@ -77,6 +86,28 @@ PerformanceIndex computeRolloutPerformanceIndex(const scalar_array_t& timeTrajec
 scalar_t rolloutTrajectory(RolloutBase& rollout, scalar_t initTime, const vector_t& initState, scalar_t finalTime,
                            PrimalSolution& primalSolution);
 
+/**
+ * Forward integrate the system dynamics with given controller on independent shooting intervals in parallel. The i-th interval is
+ * integrated from shootingStates[i] at shootingTimes[i] to the next shooting time, or to finalTime for the last interval. The last node
+ * of each interval is replaced by the first node of the next one, and the mismatch between the two is stored as the defect of the
+ * remaining last node.
+ *
+ * Note that the shooting times should not coincide with the event times.
+ *
+ * @param [in] threadPool: A reference to the thread pool instance.
+ * @param [in] rolloutRefStock: An array of references to the rollout. Each thread uses its own rollout.
+ * @param [in] shootingTimes: The start time of each shooting interval. The first one is the initial time.
+ * @param [in] shootingStates: The initial state of each shooting interval. The first one is the initial state.
+ * @param [in] finalTime: The final time.
+ * @param [in, out] primalSolution: The resulting primal solution. The requirements are the same as for the single rollout.
+ * @param [out] shootingDefects: The defects of the rollout.
+ *
+ * @return average time step.
+ */
+scalar_t rolloutTrajectory(ThreadPool& threadPool, const std::vector<std::reference_wrapper<RolloutBase>>& rolloutRefStock,
+                           const scalar_array_t& shootingTimes, const vector_array_t& shootingStates, scalar_t finalTime,
+                           PrimalSolution& primalSolution, ShootingDefects& shootingDefects);
+
 /**
  * Computes the integral of the squared (IS) norm of the controller update.
  *
@@ -68,6 +68,10 @@ struct Settings {
   size_t nThreads_ = 1;
   /** Priority of threads used in the multi-threading scheme. */
   int threadPriority_ = 99;
+  /** Time [us] that idle worker threads spin for new work before they are parked. A zero value uses the task queue thread pool. */
+  size_t threadSpinTime_ = 0;
+  /** Pins the worker threads to CPU cores. */
+  bool pinThreads_ = false;
 
   /** Maximum number of iterations of DDP. */
   size_t maxNumIterations_ = 15;
@@ -107,6 +111,27 @@ struct Settings {
   /** If true, terms of the Riccati equation will be precomputed before interpolation in the flow-map */
   bool preComputeRiccatiTerms_ = true;
 
+  /**
+   * If true, SLQ propagates the Riccati equations over the steps of the nominal time grid with the exact solution of the
+   * piecewise-constant LQ model (matrix exponential of the Hamiltonian) instead of the adaptive integrator. Only supported with the
+   * line-search strategy and without risk sensitivity.
+   */
+  bool matrixExponentialRiccati_ = false;
+
+  /**
+   * If true, ILQR computes the value functions at the boundaries of the time partitions of the parallel Riccati pass exactly, through an
+   * associative scan of the partitions' conditional value functions. Otherwise, the first iteration is solved sequentially and the later
+   * ones take the boundary values from the previous iteration. Only used with the line-search strategy and without risk sensitivity.
+   */
+  bool parallelRiccatiScan_ = false;
+
+  /**
+   * Number of shooting intervals of the forward pass. If larger than one, the horizon is split into shooting intervals which are integrated
+   * in parallel from the previous iterate. The defects between the intervals are closed by the Riccati pass. Only supported by ILQR with
+   * the line-search strategy.
+   */
+  size_t numShootingIntervals_ = 1;
+
   /** Use either the optimized control policy (true) or the optimized state-input trajectory (false). */
   bool useFeedbackPolicy_ = false;
 
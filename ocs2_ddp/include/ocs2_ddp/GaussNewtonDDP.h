@@ -180,6 +180,20 @@ class GaussNewtonDDP : public SolverBase {
   virtual void riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
                                       const ScalarFunctionQuadraticApproximation& finalValueFunction) = 0;
 
+  /**
+   * Computes the exact final value function of each partition, i.e. the value function at the start of the next partition. Unless it is
+   * overridden, this is not supported and the final value functions are taken from the previous iteration.
+   *
+   * @param [in] partitionIntervals: The partitions of the Riccati equations, [start, end).
+   * @param [out] finalValueFunctionOfEachPartition: The final value function of each partition. The one of the last partition is given.
+   * The constant terms of the others are not computed and set to zero.
+   * @return whether the final value functions are computed.
+   */
+  virtual bool computeFinalValueFunctionOfEachPartition(const std::vector<std::pair<int, int>>& partitionIntervals,
+                                                        std::vector<ScalarFunctionQuadraticApproximation>& finalValueFunctionOfEachPartition) {
+    return false;
+  }
+
  private:
   /**
    * Get the State Input Equality Constraint Lagrangian Impl object
@@ -253,6 +267,20 @@ class GaussNewtonDDP : public SolverBase {
    */
   void rolloutInitialTrajectory(PrimalDataContainer& primalData, ControllerBase* controller, size_t workerIndex = 0);
 
+  /**
+   * Splits the time horizon into the shooting intervals of the multiple-shooting forward pass. The shooting times close to the event times
+   * are skipped.
+   *
+   * @return The start time of each shooting interval except the first one. Empty if the multiple-shooting forward pass is not used.
+   */
+  scalar_array_t getShootingTimes() const;
+
+  /**
+   * Updates the nominal states and the state increments of the shooting nodes from the nominal trajectories and unoptimizedController_.
+   * The state increments are propagated through the discrete-time LQ model, thus a full step closes the defects of a linear system.
+   */
+  void updateShootingNodes();
+
   /**
    * Calculates the controller. This method uses the following variables. The method modifies unoptimizedController_.
    */
@@ -414,6 +442,9 @@ class GaussNewtonDDP : public SolverBase {
   PrimalDataContainer cachedPrimalData_;
   DualDataContainer cachedDualData_;
 
+  // shooting nodes of the multiple-shooting forward pass
+  ShootingNodes shootingNodes_;
+
   MetricsCollection metrics_;
 
   ScalarFunctionQuadraticApproximation heuristics_;
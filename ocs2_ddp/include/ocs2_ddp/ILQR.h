@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "GaussNewtonDDP.h"
 #include "riccati_equations/DiscreteTimeRiccatiEquations.h"
+#include "riccati_equations/DiscreteTimeRiccatiScan.h"
 
 namespace ocs2 {
 
@@ -64,6 +65,14 @@ class ILQR : public GaussNewtonDDP {
   void riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
                               const ScalarFunctionQuadraticApproximation& finalValueFunction) override;
 
+  /**
+   * If enabled by ddp::Settings::parallelRiccatiScan_, condenses the partitions into their conditional value functions in parallel and
+   * scans them backward from the final value function. The Riccati modification is computed with the projection of a zero Riccati matrix.
+   * Thus, the result is exact if the Hessian correction is inactive or independent of the Riccati matrix, e.g. for convex costs.
+   */
+  bool computeFinalValueFunctionOfEachPartition(const std::vector<std::pair<int, int>>& partitionIntervals,
+                                                std::vector<ScalarFunctionQuadraticApproximation>& finalValueFunctionOfEachPartition) override;
+
   void calculateControllerWorker(size_t timeIndex, const PrimalDataContainer& primalData, const DualDataContainer& dualData,
                                  LinearController& dstController) override;
 
@@ -85,6 +94,14 @@ class ILQR : public GaussNewtonDDP {
   void discreteLQWorker(SystemDynamicsBase& system, scalar_t time, const vector_t& state, const vector_t& input, scalar_t timeStep,
                         const ModelData& continuousTimeModelData, ModelData& modelData);
 
+  /**
+   * Condenses the nodes of the given partition into their conditional value function.
+   *
+   * @param [in] partitionInterval: The partition, [start, end).
+   * @param [out] valueFunction: The conditional value function from the start to the end of the partition.
+   */
+  void condensePartition(const std::pair<int, int>& partitionInterval, riccati_scan::ConditionalValueFunction& valueFunction) const;
+
   /****************
    *** Variables **
    ****************/
@@ -93,6 +110,7 @@ class ILQR : public GaussNewtonDDP {
 
   DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
   std::vector<std::unique_ptr<DiscreteTimeRiccatiEquations>> riccatiEquationsPtrStock_;
+  std::vector<riccati_scan::ConditionalValueFunction> partitionValueFunctionStock_;
 };
 
 }  // namespace ocs2
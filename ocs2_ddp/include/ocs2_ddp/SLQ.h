@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "GaussNewtonDDP.h"
 #include "riccati_equations/ContinuousTimeRiccatiEquations.h"
+#include "riccati_equations/MatrixExponentialRiccatiEquations.h"
 
 namespace ocs2 {
 
@@ -106,11 +107,23 @@ class SLQ final : public GaussNewtonDDP {
                                             vector_t allSsFinal, scalar_array_t& SsNormalizedTime,
                                             size_array_t& SsNormalizedPostEventIndices, vector_array_t& allSsTrajectory);
 
+  /**
+   * Propagates the riccati equation backward over the steps of the nominal time trajectory with the exact solution of the
+   * piecewise-constant LQ model and writes the value function of the partition directly in the dual solution.
+   *
+   * @param riccatiEquation [in] : Matrix-exponential Riccati equation object
+   * @param partitionInterval [in] : The time index interval of the partition.
+   * @param finalValueFunction [in] : The value function at the end of the partition.
+   */
+  void propagateRiccatiEquationNominalTime(MatrixExponentialRiccatiEquations& riccatiEquation, const std::pair<int, int>& partitionInterval,
+                                           const ScalarFunctionQuadraticApproximation& finalValueFunction);
+
   /****************
    *** Variables **
    ****************/
   std::vector<std::shared_ptr<ContinuousTimeRiccatiEquations>> riccatiEquationsPtrStock_;
   std::vector<std::unique_ptr<IntegratorBase>> riccatiIntegratorPtrStock_;
+  std::vector<MatrixExponentialRiccatiEquations> matrixExponentialRiccatiStock_;
   vector_array2_t allSsTrajectoryStock_;
   scalar_array2_t SsNormalizedTimeTrajectoryStock_;
   size_array2_t SsNormalizedEventsPastTheEndIndecesStock_;
@@ -0,0 +1,109 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/model_data/ModelData.h>
+
+#include "ocs2_ddp/riccati_equations/RiccatiModification.h"
+
+namespace ocs2 {
+namespace riccati_scan {
+
+/**
+ * The conditional value function of the discrete-time LQ problem from the state x at node k to the state y at node j > k, in its dual form
+ *  V(x, y) = max_l 0.5 x' J x - eta' x + l' (y - A x - b) - 0.5 l' C l.
+ *
+ * Appending conditional value functions is associative, such that the value functions at any set of nodes can be obtained from a scan
+ * over them. Refer to: S. Särkkä and Á. F. García-Fernández, "Temporal Parallelization of Dynamic Programming and Linear Quadratic
+ * Control", IEEE Transactions on Automatic Control, 2023.
+ */
+struct ConditionalValueFunction {
+  matrix_t A;
+  vector_t b;
+  matrix_t C;
+  vector_t eta;
+  matrix_t J;
+};
+
+/**
+ * Sets the conditional value function of an intermediate node of the ILQR problem. The input Hessian of the projected model data is
+ * assumed to be identity, which is the case for the projection of GaussNewtonDDP::computeProjectionAndRiccatiModification with a zero
+ * Riccati matrix.
+ *
+ * @param [in] projectedModelData: The projected model data.
+ * @param [in] riccatiModification: The Riccati modification.
+ * @param [out] valueFunction: The conditional value function from the node to the next one.
+ */
+void setIntermediateValueFunction(const ModelData& projectedModelData, const riccati_modification::Data& riccatiModification,
+                                  ConditionalValueFunction& valueFunction);
+
+/**
+ * Sets the conditional value function of an event, i.e. the jump from the pre-event to the post-event node.
+ *
+ * @param [in] jumpModelData: The model data of the jump map and the event cost.
+ * @param [out] valueFunction: The conditional value function from the pre-event to the post-event node.
+ */
+void setEventValueFunction(const ModelData& jumpModelData, ConditionalValueFunction& valueFunction);
+
+/**
+ * Appends the conditional value function of the next nodes to the one of the previous nodes: segment <- segment (x) next.
+ *
+ * @param [in, out] segment: The conditional value function of the previous nodes, overwritten by the one of both.
+ * @param [in] next: The conditional value function of the next nodes.
+ */
+void appendValueFunction(ConditionalValueFunction& segment, const ConditionalValueFunction& next);
+
+/**
+ * Computes the value function 0.5 x' Sm x + Sv' x at the start of a segment from the one at its end.
+ *
+ * @param [in] segment: The conditional value function of the segment.
+ * @param [in] SmNext: The Riccati matrix at the end of the segment.
+ * @param [in] SvNext: The Riccati vector at the end of the segment.
+ * @param [out] Sm: The Riccati matrix at the start of the segment.
+ * @param [out] Sv: The Riccati vector at the start of the segment.
+ */
+void computeValueFunction(const ConditionalValueFunction& segment, const matrix_t& SmNext, const vector_t& SvNext, matrix_t& Sm,
+                          vector_t& Sv);
+
+/**
+ * Computes the optimal state at the end of a segment from the one at its start.
+ *
+ * @param [in] segment: The conditional value function of the segment.
+ * @param [in] SmNext: The Riccati matrix at the end of the segment.
+ * @param [in] SvNext: The Riccati vector at the end of the segment.
+ * @param [in] initState: The state at the start of the segment.
+ * @param [out] finalState: The state at the end of the segment.
+ */
+void computeFinalState(const ConditionalValueFunction& segment, const matrix_t& SmNext, const vector_t& SvNext, const vector_t& initState,
+                       vector_t& finalState);
+
+}  // namespace riccati_scan
+}  // namespace ocs2
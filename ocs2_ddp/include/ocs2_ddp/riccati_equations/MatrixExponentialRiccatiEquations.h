@@ -0,0 +1,78 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/model_data/ModelData.h>
+
+namespace ocs2 {
+
+/**
+ * This class propagates the continuous-time Riccati equations of SLQ backward over one step of the nominal time grid. On the step, the
+ * projected LQ model is approximated by the average of the models at its two ends. For this piecewise-constant model the solution is exact:
+ * the affine terms are absorbed in the augmented state [x; 1] and the Riccati matrix of the augmented problem, [Sm, Sv; Sv', 2s], is
+ * obtained from the matrix exponential of the Hamiltonian matrix (Davison-Maki method).
+ *
+ * The projected input Hessian is assumed to be identity and the Riccati modification to only modify the state Hessian, which is the case
+ * for SLQ with the line-search strategy. The risk-sensitive Riccati equations are not supported.
+ */
+class MatrixExponentialRiccatiEquations {
+ public:
+  /**
+   * Computes the value function at the start of a step from the one at its end.
+   *
+   * @param [in] projectedModelData: The projected model data at the start of the step.
+   * @param [in] projectedModelDataNext: The projected model data at the end of the step.
+   * @param [in] deltaQm: The Riccati modifier to the state Hessian at the start of the step.
+   * @param [in] deltaQmNext: The Riccati modifier to the state Hessian at the end of the step.
+   * @param [in] timeStep: The duration of the step.
+   * @param [in] valueFunctionNext: The value function at the end of the step.
+   * @param [out] valueFunction: The value function at the start of the step.
+   */
+  void computeMap(const ModelData& projectedModelData, const ModelData& projectedModelDataNext, const matrix_t& deltaQm,
+                  const matrix_t& deltaQmNext, scalar_t timeStep, const ScalarFunctionQuadraticApproximation& valueFunctionNext,
+                  ScalarFunctionQuadraticApproximation& valueFunction);
+
+ private:
+  // augmented LQ model
+  matrix_t augmentedAm_;
+  matrix_t augmentedBm_;
+  matrix_t augmentedQm_;
+  matrix_t projectedPm_;
+  vector_t projectedRv_;
+
+  // Hamiltonian system
+  matrix_t hamiltonian_;
+  matrix_t hamiltonianExponential_;
+  matrix_t XY_;
+  matrix_t augmentedSm_;
+};
+
+}  // namespace ocs2
@@ -48,6 +48,9 @@ namespace ocs2 {
 /**
  * Line search strategy: The class computes the nominal controller and the nominal trajectories as well the corresponding performance
  * indices. It line-searches on the feedforward parts of the controller and chooses the largest acceptable step-size.
+ *
+ * The step lengths are evaluated in parallel, one rollout per thread. With shooting nodes, the shooting intervals of each rollout are
+ * integrated in parallel instead and the step lengths are evaluated one after another.
  */
 class LineSearchStrategy final : public SearchStrategyBase {
  public:
@@ -77,7 +80,8 @@ class LineSearchStrategy final : public SearchStrategyBase {
   void reset() override {}
 
   bool run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState, const scalar_t expectedCost,
-           const LinearController& unoptimizedController, const ModeSchedule& modeSchedule, search_strategy::SolutionRef solution) override;
+           const LinearController& unoptimizedController, const ModeSchedule& modeSchedule, const ShootingNodes& shootingNodes,
+           search_strategy::SolutionRef solution) override;
 
   std::pair<bool, std::string> checkConvergence(bool unreliableControllerIncrement, const PerformanceIndex& previousPerformanceIndex,
                                                 const PerformanceIndex& currentPerformanceIndex) const override;
@@ -93,6 +97,7 @@ class LineSearchStrategy final : public SearchStrategyBase {
     const vector_t* initStatePtr;
     const LinearController* unoptimizedControllerPtr;
     const ModeSchedule* modeSchedulePtr;
+    const ShootingNodes* shootingNodesPtr;
   };
 
   /** number of line search iterations (the if statements order is important) */
@@ -41,7 +41,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/oc_data/Metrics.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 #include <ocs2_oc/oc_solver/PerformanceIndex.h>
+#include <ocs2_oc/oc_solver/TimeBudget.h>
 
+#include "ocs2_ddp/DDP_Data.h"
 #include "ocs2_ddp/search_strategy/StrategySettings.h"
 
 namespace ocs2 {
@@ -80,11 +82,12 @@ class SearchStrategyBase {
    * @param [in] expectedCost: The expected cost based on the LQ model optimization.
    * @param [in] unoptimizedController: The unoptimized controller which search will be performed.
    * @param [in] ModeSchedule The current mode schedule.
-   * @param [out] solution: Output of search (primalSolution, performanceIndex, metrics, avgTimeStep)
+   * @param [in] shootingNodes: The shooting nodes of the multiple-shooting rollout. If empty, a single rollout is used.
+   * @param [out] solution: Output of search (primalSolution, performanceIndex, metrics, avgTimeStep, shootingDefects)
    * @return whether the search was successful or failed.
    */
   virtual bool run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState, const scalar_t expectedCost,
-                   const LinearController& unoptimizedController, const ModeSchedule& modeSchedule,
+                   const LinearController& unoptimizedController, const ModeSchedule& modeSchedule, const ShootingNodes& shootingNodes,
                    search_strategy::SolutionRef solution) = 0;
 
   /**
@@ -120,8 +123,22 @@ class SearchStrategyBase {
    */
   virtual matrix_t augmentHamiltonianHessian(const ModelData& modelData, const matrix_t& Hm) const = 0;
 
+  /**
+   * Sets the time budget of the solver run. Strategies which evaluate several candidates stop evaluating new ones once the
+   * budget is exhausted.
+   *
+   * @param [in] timeBudgetPtr: A pointer to the solver's time budget or nullptr for no limit.
+   */
+  void setTimeBudget(const TimeBudget* timeBudgetPtr) { timeBudgetPtr_ = timeBudgetPtr; }
+
  protected:
+  /** Whether the time budget of the solver run is exhausted. */
+  bool isTimeBudgetExhausted() const { return timeBudgetPtr_ != nullptr && timeBudgetPtr_->isExhausted(); }
+
   const search_strategy::Settings baseSettings_;
+
+ private:
+  const TimeBudget* timeBudgetPtr_ = nullptr;
 };
 
 }  // namespace ocs2
@@ -137,19 +154,29 @@ struct Solution {
   PerformanceIndex performanceIndex;
   MetricsCollection metrics;
   scalar_t avgTimeStep;
+  ShootingDefects shootingDefects;
 };
 
 struct SolutionRef {
   SolutionRef(Solution& s)
-      : primalSolution(s.primalSolution), performanceIndex(s.performanceIndex), metrics(s.metrics), avgTimeStep(s.avgTimeStep) {}
+      : primalSolution(s.primalSolution),
+        performanceIndex(s.performanceIndex),
+        metrics(s.metrics),
+        avgTimeStep(s.avgTimeStep),
+        shootingDefects(s.shootingDefects) {}
   SolutionRef(PrimalSolution& primalSolutionArg, PerformanceIndex& performanceIndexArg, MetricsCollection& metricsArg,
-              scalar_t& avgTimeStepArg)
-      : primalSolution(primalSolutionArg), performanceIndex(performanceIndexArg), metrics(metricsArg), avgTimeStep(avgTimeStepArg) {}
+              scalar_t& avgTimeStepArg, ShootingDefects& shootingDefectsArg)
+      : primalSolution(primalSolutionArg),
+        performanceIndex(performanceIndexArg),
+        metrics(metricsArg),
+        avgTimeStep(avgTimeStepArg),
+        shootingDefects(shootingDefectsArg) {}
 
   PrimalSolution& primalSolution;
   PerformanceIndex& performanceIndex;
   MetricsCollection& metrics;
   scalar_t& avgTimeStep;
+  ShootingDefects& shootingDefects;
 };
 
 inline void swap(SolutionRef lhs, SolutionRef rhs) {
@@ -157,6 +184,7 @@ inline void swap(SolutionRef lhs, SolutionRef rhs) {
   swap(lhs.performanceIndex, rhs.performanceIndex);
   swap(lhs.metrics, rhs.metrics);
   std::swap(lhs.avgTimeStep, rhs.avgTimeStep);
+  lhs.shootingDefects.swap(rhs.shootingDefects);
 }
 
 }  // namespace search_strategy
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_ddp/DDP_HelperFunctions.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 
 #include <ocs2_core/PreComputation.h>
@@ -143,6 +144,17 @@ PerformanceIndex computeRolloutPerformanceIndex(const scalar_array_t& timeTrajec
   return performanceIndex;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t computeDynamicsViolationSSE(const ShootingDefects& shootingDefects) {
+  scalar_t dynamicsViolationSSE = 0.0;
+  for (const auto& defect : shootingDefects.values) {
+    dynamicsViolationSSE += defect.squaredNorm();
+  }
+  return dynamicsViolationSSE;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -161,6 +173,76 @@ scalar_t rolloutTrajectory(RolloutBase& rollout, scalar_t initTime, const vector
   return (finalTime - initTime) / static_cast<scalar_t>(primalSolution.timeTrajectory_.size());
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t rolloutTrajectory(ThreadPool& threadPool, const std::vector<std::reference_wrapper<RolloutBase>>& rolloutRefStock,
+                           const scalar_array_t& shootingTimes, const vector_array_t& shootingStates, scalar_t finalTime,
+                           PrimalSolution& primalSolution, ShootingDefects& shootingDefects) {
+  assert(shootingTimes.size() == shootingStates.size());
+  const size_t numIntervals = shootingTimes.size();
+
+  // rollout of each shooting interval
+  std::vector<PrimalSolution> intervalSolutions(numIntervals);
+  std::atomic_size_t nextRolloutIndex{0};
+  std::atomic_size_t nextIntervalIndex{0};
+  auto task = [&](int) {
+    RolloutBase& rollout = rolloutRefStock[nextRolloutIndex++];
+
+    size_t i;
+    while ((i = nextIntervalIndex++) < numIntervals) {
+      const scalar_t intervalFinalTime = (i + 1 < numIntervals) ? shootingTimes[i + 1] : finalTime;
+      auto& intervalSolution = intervalSolutions[i];
+      const auto xCurrent = rollout.run(shootingTimes[i], shootingStates[i], intervalFinalTime, primalSolution.controllerPtr_.get(),
+                                        primalSolution.modeSchedule_, intervalSolution.timeTrajectory_, intervalSolution.postEventIndices_,
+                                        intervalSolution.stateTrajectory_, intervalSolution.inputTrajectory_);
+
+      if (!xCurrent.allFinite()) {
+        throw std::runtime_error("[rolloutTrajectory] System became unstable during the rollout of a shooting interval!");
+      }
+    }
+  };
+  threadPool.runParallel(task, std::min(rolloutRefStock.size(), numIntervals));
+
+  // concatenate the intervals
+  auto& timeTrajectory = primalSolution.timeTrajectory_;
+  auto& stateTrajectory = primalSolution.stateTrajectory_;
+  auto& inputTrajectory = primalSolution.inputTrajectory_;
+  auto& postEventIndices = primalSolution.postEventIndices_;
+  timeTrajectory.clear();
+  stateTrajectory.clear();
+  inputTrajectory.clear();
+  postEventIndices.clear();
+  shootingDefects.clear();
+  shootingDefects.indices.reserve(numIntervals - 1);
+  shootingDefects.values.reserve(numIntervals - 1);
+
+  for (size_t i = 0; i < numIntervals; i++) {
+    auto& intervalSolution = intervalSolutions[i];
+
+    // replace the last node by the initial node of the next interval
+    if (i + 1 < numIntervals) {
+      shootingDefects.values.push_back(intervalSolution.stateTrajectory_.back() - shootingStates[i + 1]);
+      intervalSolution.timeTrajectory_.pop_back();
+      intervalSolution.stateTrajectory_.pop_back();
+      intervalSolution.inputTrajectory_.pop_back();
+      shootingDefects.indices.push_back(timeTrajectory.size() + intervalSolution.timeTrajectory_.size() - 1);
+    }
+
+    for (const auto& eventIndex : intervalSolution.postEventIndices_) {
+      postEventIndices.push_back(eventIndex + timeTrajectory.size());
+    }
+    timeTrajectory.insert(timeTrajectory.end(), intervalSolution.timeTrajectory_.begin(), intervalSolution.timeTrajectory_.end());
+    stateTrajectory.insert(stateTrajectory.end(), std::make_move_iterator(intervalSolution.stateTrajectory_.begin()),
+                           std::make_move_iterator(intervalSolution.stateTrajectory_.end()));
+    inputTrajectory.insert(inputTrajectory.end(), std::make_move_iterator(intervalSolution.inputTrajectory_.begin()),
+                           std::make_move_iterator(intervalSolution.inputTrajectory_.end()));
+  }
+
+  // average time step
+  return (finalTime - shootingTimes.front()) / static_cast<scalar_t>(timeTrajectory.size());
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
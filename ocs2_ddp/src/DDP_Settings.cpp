@@ -69,6 +69,8 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
 
   loadData::loadPtreeValue(pt, settings.nThreads_, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority_, fieldName + ".threadPriority", verbose);
+  loadData::loadPtreeValue(pt, settings.threadSpinTime_, fieldName + ".threadSpinTime", verbose);
+  loadData::loadPtreeValue(pt, settings.pinThreads_, fieldName + ".pinThreads", verbose);
 
   loadData::loadPtreeValue(pt, settings.maxNumIterations_, fieldName + ".maxNumIterations", verbose);
   loadData::loadPtreeValue(pt, settings.minRelCost_, fieldName + ".minRelCost", verbose);
@@ -92,6 +94,9 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.constraintPenaltyIncreaseRate_, fieldName + ".constraintPenaltyIncreaseRate", verbose);
 
   loadData::loadPtreeValue(pt, settings.preComputeRiccatiTerms_, fieldName + ".preComputeRiccatiTerms", verbose);
+  loadData::loadPtreeValue(pt, settings.matrixExponentialRiccati_, fieldName + ".matrixExponentialRiccati", verbose);
+  loadData::loadPtreeValue(pt, settings.parallelRiccatiScan_, fieldName + ".parallelRiccatiScan", verbose);
+  loadData::loadPtreeValue(pt, settings.numShootingIntervals_, fieldName + ".numShootingIntervals", verbose);
 
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy_, fieldName + ".useFeedbackPolicy", verbose);
 
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_ddp/GaussNewtonDDP.h"
 
 #include <algorithm>
+#include <array>
 #include <numeric>
 
 #include <ocs2_core/control/FeedforwardController.h>
@@ -53,7 +54,9 @@ namespace ocs2 {
 /******************************************************************************************************/
 GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
                                const Initializer& initializer)
-    : ddpSettings_(std::move(ddpSettings)), threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_) {
+    : ddpSettings_(std::move(ddpSettings)),
+      threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_,
+                  std::chrono::microseconds(ddpSettings_.threadSpinTime_), ddpSettings_.pinThreads_) {
   // check OCP
   if (!optimalControlProblem.stateEqualityConstraintPtr->empty()) {
     throw std::runtime_error(
@@ -70,6 +73,20 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
         "[GaussNewtonDDP] DDP does not support final equality constraints (a.k.a. finalEqualityConstraintPtr), instead use the Lagrangian "
         "method!");
   }
+  if (!optimalControlProblem.inequalityConstraintPtr->empty() || !optimalControlProblem.finalInequalityConstraintPtr->empty() ||
+      !optimalControlProblem.stateBoxConstraint.empty() || !optimalControlProblem.inputBoxConstraint.empty()) {
+    throw std::runtime_error(
+        "[GaussNewtonDDP] DDP does not support inequality and box constraints (a.k.a. inequalityConstraintPtr, "
+        "finalInequalityConstraintPtr, stateBoxConstraint, and inputBoxConstraint), instead use the Lagrangian method!");
+  }
+
+  // check the multiple-shooting forward pass
+  if (ddpSettings_.numShootingIntervals_ > 1 &&
+      (ddpSettings_.algorithm_ != ddp::Algorithm::ILQR || ddpSettings_.strategy_ != search_strategy::Type::LINE_SEARCH)) {
+    throw std::runtime_error(
+        "[GaussNewtonDDP] The multiple-shooting forward pass (a.k.a. numShootingIntervals > 1) is only supported by ILQR with the "
+        "line-search strategy!");
+  }
 
   // Dynamics, Constraints, derivatives, and cost
   dynamicsForwardRolloutPtrStock_.reserve(ddpSettings_.nThreads_);
@@ -120,6 +137,7 @@ GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rol
       break;
     }
   }  // end of switch-case
+  searchStrategyPtr_->setTimeBudget(&getTimeBudget());
 
   // initialize controller
   nominalPrimalData_.primalSolution.controllerPtr_.reset(new LinearController);
@@ -181,6 +199,7 @@ void GaussNewtonDDP::reset() {
   cachedPrimalData_.clear();
   dualData_.clear();
   cachedDualData_.clear();
+  shootingNodes_.clear();
 
   // initialize Augmented Lagrangian parameters
   initializeConstraintPenalties();
@@ -441,9 +460,40 @@ void GaussNewtonDDP::rolloutInitialTrajectory(PrimalDataContainer& primalData, C
     }
   }
 
+  // shooting intervals of the controller rollout which are warm started from the cached trajectory
+  const auto& cachedSolution = cachedPrimalData_.primalSolution;
+  scalar_array_t shootingTimes{controllerRolloutFromTo.first};
+  vector_array_t shootingStates{initState_};
+  if (!cachedSolution.timeTrajectory_.empty()) {
+    for (const auto& shootingTime : shootingNodes_.times) {
+      if (shootingTime > controllerRolloutFromTo.first && shootingTime < controllerRolloutFromTo.second &&
+          shootingTime >= cachedSolution.timeTrajectory_.front() && shootingTime <= cachedSolution.timeTrajectory_.back()) {
+        shootingTimes.push_back(shootingTime);
+        shootingStates.push_back(
+            LinearInterpolation::interpolate(shootingTime, cachedSolution.timeTrajectory_, cachedSolution.stateTrajectory_));
+      }
+    }
+  }
+
   // rollout with controller
   vector_t xCurrent = initState_;
-  if (controllerRolloutFromTo.first < controllerRolloutFromTo.second) {
+  if (controllerRolloutFromTo.first < controllerRolloutFromTo.second && shootingTimes.size() > 1) {
+    std::vector<std::reference_wrapper<RolloutBase>> rolloutRefStock;
+    for (auto& rolloutPtr : dynamicsForwardRolloutPtrStock_) {
+      rolloutRefStock.emplace_back(*rolloutPtr);
+    }
+    PrimalSolution shootingSolution;
+    shootingSolution.modeSchedule_ = modeSchedule;
+    shootingSolution.controllerPtr_.reset(controller->clone());
+    std::ignore = rolloutTrajectory(threadPool_, rolloutRefStock, shootingTimes, shootingStates, controllerRolloutFromTo.second,
+                                    shootingSolution, primalData.shootingDefects);
+    timeTrajectory.swap(shootingSolution.timeTrajectory_);
+    postEventIndices.swap(shootingSolution.postEventIndices_);
+    stateTrajectory.swap(shootingSolution.stateTrajectory_);
+    inputTrajectory.swap(shootingSolution.inputTrajectory_);
+    xCurrent = stateTrajectory.back();
+
+  } else if (controllerRolloutFromTo.first < controllerRolloutFromTo.second) {
     xCurrent = dynamicsForwardRolloutPtrStock_[workerIndex]->run(controllerRolloutFromTo.first, initState_, controllerRolloutFromTo.second,
                                                                  controller, modeSchedule, timeTrajectory, postEventIndices,
                                                                  stateTrajectory, inputTrajectory);
@@ -494,6 +544,79 @@ void GaussNewtonDDP::rolloutInitialTrajectory(PrimalDataContainer& primalData, C
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_array_t GaussNewtonDDP::getShootingTimes() const {
+  scalar_array_t shootingTimes;
+  if (ddpSettings_.numShootingIntervals_ < 2) {
+    return shootingTimes;
+  }
+
+  const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
+  const scalar_t intervalLength = (finalTime_ - initTime_) / static_cast<scalar_t>(ddpSettings_.numShootingIntervals_);
+  shootingTimes.reserve(ddpSettings_.numShootingIntervals_ - 1);
+  for (size_t i = 1; i < ddpSettings_.numShootingIntervals_; i++) {
+    const scalar_t shootingTime = initTime_ + i * intervalLength;
+    // a shooting interval should not start close to an event time
+    const bool isCloseToEvent = std::any_of(eventTimes.begin(), eventTimes.end(), [&](scalar_t eventTime) {
+      return std::abs(eventTime - shootingTime) < ddpSettings_.timeStep_;
+    });
+    if (!isCloseToEvent) {
+      shootingTimes.push_back(shootingTime);
+    }
+  }
+  return shootingTimes;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void GaussNewtonDDP::updateShootingNodes() {
+  if (shootingNodes_.times.empty()) {
+    return;
+  }
+
+  const auto& timeTrajectory = nominalPrimalData_.primalSolution.timeTrajectory_;
+  const auto& stateTrajectory = nominalPrimalData_.primalSolution.stateTrajectory_;
+  const auto& postEventIndices = nominalPrimalData_.primalSolution.postEventIndices_;
+  const size_t N = timeTrajectory.size();
+
+  // the state increments of a full step, propagated through the discrete-time LQ model and the controller
+  vector_array_t stateIncrementTrajectory(N);
+  stateIncrementTrajectory.front().setZero(initState_.size());
+  auto nextEventItr = postEventIndices.begin();
+  for (size_t k = 0; k + 1 < N; k++) {
+    auto& nextStateIncrement = stateIncrementTrajectory[k + 1];
+    if (nextEventItr != postEventIndices.end() && *nextEventItr == k + 1) {
+      const auto& jumpModelData = nominalPrimalData_.modelDataEventTimes[std::distance(postEventIndices.begin(), nextEventItr)];
+      nextStateIncrement = jumpModelData.dynamicsBias;
+      nextStateIncrement.noalias() += jumpModelData.dynamics.dfdx * stateIncrementTrajectory[k];
+      ++nextEventItr;
+
+    } else if (numerics::almost_eq(timeTrajectory[k + 1], timeTrajectory[k])) {
+      nextStateIncrement = stateIncrementTrajectory[k];
+
+    } else {
+      const auto& modelData = nominalPrimalData_.modelDataTrajectory[k];
+      vector_t inputIncrement = unoptimizedController_.deltaBiasArray_[k];
+      inputIncrement.noalias() += unoptimizedController_.gainArray_[k] * stateIncrementTrajectory[k];
+      nextStateIncrement = modelData.dynamicsBias;
+      nextStateIncrement.noalias() += modelData.dynamics.dfdx * stateIncrementTrajectory[k];
+      nextStateIncrement.noalias() += modelData.dynamics.dfdu * inputIncrement;
+    }
+  }
+
+  // nominal states and state increments at the shooting times
+  shootingNodes_.states.clear();
+  shootingNodes_.stateIncrements.clear();
+  for (const auto& shootingTime : shootingNodes_.times) {
+    const auto indexAlpha = LinearInterpolation::timeSegment(shootingTime, timeTrajectory);
+    shootingNodes_.states.push_back(LinearInterpolation::interpolate(indexAlpha, stateTrajectory));
+    shootingNodes_.stateIncrements.push_back(LinearInterpolation::interpolate(indexAlpha, stateIncrementTrajectory));
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -511,6 +634,8 @@ scalar_t GaussNewtonDDP::calculateRolloutMerit(const PerformanceIndex& performan
   scalar_t merit = performanceIndex.cost;
   // state/state-input equality constraints
   merit += constraintPenaltyCoefficients_.penaltyCoeff * std::sqrt(performanceIndex.equalityConstraintsSSE);
+  // dynamics violation of the multiple-shooting rollout
+  merit += constraintPenaltyCoefficients_.penaltyCoeff * std::sqrt(performanceIndex.dynamicsViolationSSE);
   // state/state-input equality Lagrangian
   merit += performanceIndex.equalityLagrangian;
   // state/state-input inequality Lagrangian
@@ -534,24 +659,30 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
   // [first1,last1), [first2(last1), last2).
   dualData_.valueFunctionTrajectory.back() = finalValueFunction;
 
+  // do equal-time partitions based on available thread resource
+  const std::vector<std::pair<int, int>> partitionIntervals =
+      getPartitionIntervalsFromTimeTrajectory(nominalPrimalData_.primalSolution.timeTrajectory_, ddpSettings_.nThreads_);
+
+  // hold the final value function of each partition
+  std::vector<ScalarFunctionQuadraticApproximation> finalValueFunctionOfEachPartition(partitionIntervals.size());
+  finalValueFunctionOfEachPartition.back() = finalValueFunction;
+
+  const bool isFinalValueFunctionExact =
+      partitionIntervals.size() > 1 && computeFinalValueFunctionOfEachPartition(partitionIntervals, finalValueFunctionOfEachPartition);
+
   // solve it sequentially for the first iteration
-  if (totalNumIterations_ == 0) {
+  if (partitionIntervals.size() == 1 || (totalNumIterations_ == 0 && !isFinalValueFunctionExact)) {
     const std::pair<int, int> partitionInterval{0, outputN - 1};
     riccatiEquationsWorker(0, partitionInterval, finalValueFunction);
   } else {  // solve it in parallel
-    // do equal-time partitions based on available thread resource
-    std::vector<std::pair<int, int>> partitionIntervals =
-        getPartitionIntervalsFromTimeTrajectory(nominalPrimalData_.primalSolution.timeTrajectory_, ddpSettings_.nThreads_);
-
-    // hold the final value function of each partition
-    std::vector<ScalarFunctionQuadraticApproximation> finalValueFunctionOfEachPartition(partitionIntervals.size());
-    finalValueFunctionOfEachPartition.back() = finalValueFunction;
-    for (size_t i = 0; i < partitionIntervals.size() - 1; i++) {
-      const int startIndexOfNextPartition = partitionIntervals[i + 1].first;
-      const vector_t& xFinalUpdated = nominalPrimalData_.primalSolution.stateTrajectory_[startIndexOfNextPartition];
-      finalValueFunctionOfEachPartition[i] =
-          getValueFunctionFromCache(nominalPrimalData_.primalSolution.timeTrajectory_[startIndexOfNextPartition], xFinalUpdated);
-    }  // end of loop
+    if (!isFinalValueFunctionExact) {
+      for (size_t i = 0; i < partitionIntervals.size() - 1; i++) {
+        const int startIndexOfNextPartition = partitionIntervals[i + 1].first;
+        const vector_t& xFinalUpdated = nominalPrimalData_.primalSolution.stateTrajectory_[startIndexOfNextPartition];
+        finalValueFunctionOfEachPartition[i] =
+            getValueFunctionFromCache(nominalPrimalData_.primalSolution.timeTrajectory_[startIndexOfNextPartition], xFinalUpdated);
+      }  // end of loop
+    }
 
     nextTaskId_ = 0;
     auto task = [this, &partitionIntervals, &finalValueFunctionOfEachPartition]() {
@@ -559,6 +690,17 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
       riccatiEquationsWorker(taskId, partitionIntervals[taskId], finalValueFunctionOfEachPartition[taskId]);
     };
     runParallel(task, partitionIntervals.size());
+
+    // The constant term of the value function does not affect the rest of the solution. Therefore, it is added to the partitions once
+    // the constant term at their end is known.
+    if (isFinalValueFunctionExact) {
+      for (int i = static_cast<int>(partitionIntervals.size()) - 2; i >= 0; i--) {
+        const scalar_t sFinal = dualData_.valueFunctionTrajectory[partitionIntervals[i].second].f;
+        for (int k = partitionIntervals[i].first; k < partitionIntervals[i].second; k++) {
+          dualData_.valueFunctionTrajectory[k].f += sFinal;
+        }
+      }
+    }
   }
 
   // testing the numerical stability of the Riccati equations
@@ -677,6 +819,12 @@ void GaussNewtonDDP::approximateOptimalControlProblem() {
   // perform the LQ approximation for intermediate times
   approximateIntermediateLQ(nominalPrimalData_);
 
+  // the defects of the multiple-shooting rollout are the biases of the discrete-time dynamics
+  const auto& shootingDefects = nominalPrimalData_.shootingDefects;
+  for (size_t i = 0; i < shootingDefects.indices.size(); i++) {
+    nominalPrimalData_.modelDataTrajectory[shootingDefects.indices[i]].dynamicsBias = shootingDefects.values[i];
+  }
+
   /*
    * compute and augment the LQ approximation of the event times.
    * also call shiftHessian on the event time's cost 2nd order derivative.
@@ -896,9 +1044,9 @@ void GaussNewtonDDP::runSearchStrategy(scalar_t lqModelExpectedCost, const Linea
 
   // Primal solution controller is now optimized.
   scalar_t avgTimeStep;
-  search_strategy::SolutionRef solution(primalData.primalSolution, performanceIndex, metrics, avgTimeStep);
-  const bool success =
-      searchStrategyPtr_->run({initTime_, finalTime_}, initState_, lqModelExpectedCost, unoptimizedController, modeSchedule, solution);
+  search_strategy::SolutionRef solution(primalData.primalSolution, performanceIndex, metrics, avgTimeStep, primalData.shootingDefects);
+  const bool success = searchStrategyPtr_->run({initTime_, finalTime_}, initState_, lqModelExpectedCost, unoptimizedController,
+                                               modeSchedule, shootingNodes_, solution);
   avgTimeStepFP_ = 0.9 * avgTimeStepFP_ + 0.1 * avgTimeStep;
 
   // If fail, copy the entire cache back. To keep the consistency of cached data, all cache should be left untouched.
@@ -963,6 +1111,7 @@ void GaussNewtonDDP::runInit() {
     computeRolloutMetrics(optimalControlProblemStock_[taskId], nominalPrimalData_.primalSolution, metrics_);
 
     performanceIndex_ = computeRolloutPerformanceIndex(nominalPrimalData_.primalSolution.timeTrajectory_, metrics_);
+    performanceIndex_.dynamicsViolationSSE = computeDynamicsViolationSSE(nominalPrimalData_.shootingDefects);
 
     // calculates rollout merit
     performanceIndex_.merit = calculateRolloutMerit(performanceIndex_);
@@ -1001,6 +1150,9 @@ void GaussNewtonDDP::runInit() {
   calculateController();
   computeControllerTimer_.endTimer();
 
+  // shooting nodes of the next forward pass
+  updateShootingNodes();
+
   // display
   if (ddpSettings_.displayInfo_) {
     printRolloutInfo();
@@ -1043,6 +1195,9 @@ void GaussNewtonDDP::runIteration(scalar_t lqModelExpectedCost) {
   calculateController();
   computeControllerTimer_.endTimer();
 
+  // shooting nodes of the next forward pass
+  updateShootingNodes();
+
   // display
   if (ddpSettings_.displayInfo_) {
     printRolloutInfo();
@@ -1081,9 +1236,24 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
   initState_ = initState;
   initTime_ = initTime;
   finalTime_ = finalTime;
+  shootingNodes_.clear();
+  shootingNodes_.times = getShootingTimes();
   performanceIndexHistory_.clear();
   const auto initIteration = totalNumIterations_;
 
+  // the accumulated timings before this run, used to record the budget consumed by each phase
+  auto& timeBudget = getTimeBudget();
+  const std::array<std::pair<const char*, const benchmark::RepeatedTimer*>, 5> phaseTimers{
+      {{"Initialization", &initializationTimer_},
+       {"LQ Approximation", &linearQuadraticApproximationTimer_},
+       {"Backward Pass", &backwardPassTimer_},
+       {"Compute Controller", &computeControllerTimer_},
+       {"Search Strategy", &searchStrategyTimer_}}};
+  std::array<scalar_t, 5> phaseTotalsAtStart;
+  for (size_t i = 0; i < phaseTimers.size(); i++) {
+    phaseTotalsAtStart[i] = phaseTimers[i].second->getTotalInMilliseconds();
+  }
+
   // adjust controller
   if (!optimizedPrimalData_.primalSolution.controllerPtr_->empty()) {
     std::ignore = trajectorySpread(optimizedPrimalData_.primalSolution.modeSchedule_, getReferenceManager().getModeSchedule(),
@@ -1109,17 +1279,28 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
   // swap nominal trajectories (time, state, input, ...) to cache before new rollout
   swapDataToCache();
   // run DDP initializer and update the member variables
+  scalar_t iterationStartTime = timeBudget.getElapsedTime();
   runInit();
+  // the duration of the latest iteration, used as the estimate of the next one
+  scalar_t iterationDuration = timeBudget.getElapsedTime() - iterationStartTime;
 
   // increment iteration counter
   totalNumIterations_++;
 
   // convergence variables of the main loop
   bool isConverged = false;
+  bool isTimeBudgetExhausted = false;
   std::string convergenceInfo;
 
   // DDP main loop
   while (!isConverged && (totalNumIterations_ - initIteration) < ddpSettings_.maxNumIterations_) {
+    // stop if the time budget does not suffice for another iteration and the final search
+    const scalar_t finalSearchDuration = 1e-3 * searchStrategyTimer_.getLastIntervalInMilliseconds();
+    if (!timeBudget.hasTimeFor(iterationDuration + finalSearchDuration)) {
+      isTimeBudgetExhausted = true;
+      break;
+    }
+
     // display the iteration's input update norm (before caching the old nominals)
     if (ddpSettings_.displayInfo_) {
       std::cerr << "\n###################";
@@ -1138,7 +1319,9 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 
     // cache the nominal trajectories before the new rollout (time, state, input, ...)
     swapDataToCache();
+    iterationStartTime = timeBudget.getElapsedTime();
     runIteration(lqModelExpectedCost);
+    iterationDuration = timeBudget.getElapsedTime() - iterationStartTime;
 
     // increment iteration counter
     totalNumIterations_++;
@@ -1167,6 +1350,11 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 
   performanceIndexHistory_.push_back(performanceIndex_);
 
+  // record the time spent in each phase of this run
+  for (size_t i = 0; i < phaseTimers.size(); i++) {
+    timeBudget.addPhaseDuration(phaseTimers[i].first, 1e-3 * (phaseTimers[i].second->getTotalInMilliseconds() - phaseTotalsAtStart[i]));
+  }
+
   // display
   if (ddpSettings_.displayInfo_ || ddpSettings_.displayShortSummary_) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
@@ -1182,6 +1370,10 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
     } else if (totalNumIterations_ - initIteration == ddpSettings_.maxNumIterations_) {
       std::cerr << "The algorithm has terminated as: \n";
       std::cerr << "    * The maximum number of iterations (i.e., " << ddpSettings_.maxNumIterations_ << ") has reached." << std::endl;
+    } else if (isTimeBudgetExhausted) {
+      std::cerr << "The algorithm has terminated as: \n";
+      std::cerr << "    * The time budget does not suffice for another iteration (elapsed time: " << timeBudget.getElapsedTime()
+                << " [s])." << std::endl;
     } else {
       std::cerr << "The algorithm has terminated for an unknown reason!" << std::endl;
     }
@@ -73,6 +73,71 @@ ILQR::ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalC
   Eigen::initParallel();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ILQR::computeFinalValueFunctionOfEachPartition(const std::vector<std::pair<int, int>>& partitionIntervals,
+                                                    std::vector<ScalarFunctionQuadraticApproximation>& finalValueFunctionOfEachPartition) {
+  const bool isRiskSensitive = !numerics::almost_eq(settings().riskSensitiveCoeff_, 0.0);
+  if (!settings().parallelRiccatiScan_ || settings().strategy_ != search_strategy::Type::LINE_SEARCH || isRiskSensitive) {
+    return false;
+  }
+
+  // condense the partitions except the first one
+  const size_t numPartitions = partitionIntervals.size();
+  partitionValueFunctionStock_.resize(numPartitions);
+  nextTaskId_ = 1;
+  auto task = [&]() {
+    size_t partitionIndex;
+    while ((partitionIndex = nextTaskId_++) < numPartitions) {
+      condensePartition(partitionIntervals[partitionIndex], partitionValueFunctionStock_[partitionIndex]);
+    }
+  };
+  runParallel(task, numPartitions - 1);
+
+  // scan backward from the final value function
+  for (size_t i = numPartitions - 1; i > 0; i--) {
+    auto& valueFunction = finalValueFunctionOfEachPartition[i - 1];
+    riccati_scan::computeValueFunction(partitionValueFunctionStock_[i], finalValueFunctionOfEachPartition[i].dfdxx,
+                                       finalValueFunctionOfEachPartition[i].dfdx, valueFunction.dfdxx, valueFunction.dfdx);
+    valueFunction.f = 0.0;
+  }
+
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ILQR::condensePartition(const std::pair<int, int>& partitionInterval, riccati_scan::ConditionalValueFunction& valueFunction) const {
+  const auto& postEventIndices = nominalPrimalData_.primalSolution.postEventIndices_;
+  auto nextEventItr = std::upper_bound(postEventIndices.begin(), postEventIndices.end(), partitionInterval.first);
+
+  const auto stateDim = nominalPrimalData_.modelDataTrajectory[partitionInterval.first].stateDim;
+  const matrix_t SmZero = matrix_t::Zero(stateDim, stateDim);
+  ModelData projectedModelData;
+  riccati_modification::Data riccatiModification;
+  riccati_scan::ConditionalValueFunction nodeValueFunction;
+
+  for (int k = partitionInterval.first; k < partitionInterval.second; k++) {
+    auto& dstValueFunction = (k == partitionInterval.first) ? valueFunction : nodeValueFunction;
+
+    if (nextEventItr != postEventIndices.end() && *nextEventItr == k + 1) {
+      // the pre-event node only contributes the jump map
+      const int eventIndex = std::distance(postEventIndices.begin(), nextEventItr);
+      riccati_scan::setEventValueFunction(nominalPrimalData_.modelDataEventTimes[eventIndex], dstValueFunction);
+      ++nextEventItr;
+    } else {
+      computeProjectionAndRiccatiModification(nominalPrimalData_.modelDataTrajectory[k], SmZero, projectedModelData, riccatiModification);
+      riccati_scan::setIntermediateValueFunction(projectedModelData, riccatiModification, dstValueFunction);
+    }
+
+    if (k > partitionInterval.first) {
+      riccati_scan::appendValueFunction(valueFunction, nodeValueFunction);
+    }
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
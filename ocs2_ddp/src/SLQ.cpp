@@ -29,8 +29,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ddp/SLQ.h"
 
+#include <ocs2_core/NumericTraits.h>
+
 #include "ocs2_ddp/DDP_HelperFunctions.h"
 #include "ocs2_ddp/riccati_equations/RiccatiModificationInterpolation.h"
+#include "ocs2_ddp/riccati_equations/RiccatiTransversalityConditions.h"
 
 namespace ocs2 {
 
@@ -69,6 +72,16 @@ SLQ::SLQ(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalCon
     riccatiIntegratorPtrStock_.emplace_back(newIntegrator(integratorType));
   }  // end of i loop
 
+  // the exact step requires the reduced form of the Riccati equations
+  if (settings().matrixExponentialRiccati_) {
+    if (settings().strategy_ != search_strategy::Type::LINE_SEARCH || !numerics::almost_eq(settings().riskSensitiveCoeff_, 0.0)) {
+      throw std::runtime_error(
+          "[SLQ] The matrix exponential Riccati step (a.k.a. matrixExponentialRiccati) is only supported with the line-search strategy and "
+          "without risk sensitivity!");
+    }
+    matrixExponentialRiccatiStock_.resize(settings().nThreads_);
+  }
+
   Eigen::initParallel();
 }
 
@@ -211,6 +224,11 @@ matrix_t SLQ::computeHamiltonianHessian(const ModelData& modelData, const matrix
 /******************************************************************************************************/
 void SLQ::riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
                                  const ScalarFunctionQuadraticApproximation& finalValueFunction) {
+  if (settings().matrixExponentialRiccati_) {
+    propagateRiccatiEquationNominalTime(matrixExponentialRiccatiStock_[workerIndex], partitionInterval, finalValueFunction);
+    return;
+  }
+
   // set data for Riccati equations
   riccatiEquationsPtrStock_[workerIndex]->resetNumFunctionCalls();
   riccatiEquationsPtrStock_[workerIndex]->setData(&(nominalPrimalData_.primalSolution.timeTrajectory_),
@@ -300,6 +318,46 @@ void SLQ::integrateRiccatiEquationNominalTime(IntegratorBase& riccatiIntegrator,
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SLQ::propagateRiccatiEquationNominalTime(MatrixExponentialRiccatiEquations& riccatiEquation,
+                                              const std::pair<int, int>& partitionInterval,
+                                              const ScalarFunctionQuadraticApproximation& finalValueFunction) {
+  const auto& nominalTimeTrajectory = nominalPrimalData_.primalSolution.timeTrajectory_;
+  const auto& postEventIndices = nominalPrimalData_.primalSolution.postEventIndices_;
+  const auto& projectedModelDataTrajectory = dualData_.projectedModelDataTrajectory;
+  const auto& riccatiModificationTrajectory = dualData_.riccatiModificationTrajectory;
+  auto& valueFunctionTrajectory = dualData_.valueFunctionTrajectory;
+
+  // the last event of the partition. Its post-event index can be the end of the partition
+  auto nextEventItr = std::upper_bound(postEventIndices.begin(), postEventIndices.end(), partitionInterval.second);
+
+  const ScalarFunctionQuadraticApproximation* valueFunctionNext = &finalValueFunction;
+  for (int k = partitionInterval.second - 1; k >= partitionInterval.first; k--) {
+    if (nextEventItr != postEventIndices.begin() && *std::prev(nextEventItr) == k + 1) {
+      // jump to the pre-event value
+      --nextEventItr;
+      const auto index = std::distance(postEventIndices.begin(), nextEventItr);
+      auto& valueFunction = valueFunctionTrajectory[k];
+      std::tie(valueFunction.dfdxx, valueFunction.dfdx, valueFunction.f) = riccatiTransversalityConditions(
+          nominalPrimalData_.modelDataEventTimes[index], valueFunctionNext->dfdxx, valueFunctionNext->dfdx, valueFunctionNext->f);
+
+    } else {
+      const scalar_t timeStep = nominalTimeTrajectory[k + 1] - nominalTimeTrajectory[k];
+      if (timeStep > numeric_traits::weakEpsilon<scalar_t>()) {
+        riccatiEquation.computeMap(projectedModelDataTrajectory[k], projectedModelDataTrajectory[k + 1],
+                                   riccatiModificationTrajectory[k].deltaQm_, riccatiModificationTrajectory[k + 1].deltaQm_, timeStep,
+                                   *valueFunctionNext, valueFunctionTrajectory[k]);
+      } else {
+        valueFunctionTrajectory[k] = *valueFunctionNext;
+      }
+    }
+
+    valueFunctionNext = &valueFunctionTrajectory[k];
+  }  // end of k loop
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
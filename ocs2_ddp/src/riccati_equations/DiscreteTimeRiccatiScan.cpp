@@ -0,0 +1,121 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "ocs2_ddp/riccati_equations/DiscreteTimeRiccatiScan.h"
+
+namespace ocs2 {
+namespace riccati_scan {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void setIntermediateValueFunction(const ModelData& projectedModelData, const riccati_modification::Data& riccatiModification,
+                                  ConditionalValueFunction& valueFunction) {
+  const auto& Am = projectedModelData.dynamics.dfdx;
+  const auto& Bm = projectedModelData.dynamics.dfdu;
+  const auto& Pm = projectedModelData.cost.dfdux;
+  const vector_t Rv = projectedModelData.cost.dfdu + riccatiModification.deltaGv_;
+
+  // minimizing over the input: u = Bm^T * l - Pm * x - Rv
+  valueFunction.A = Am;
+  valueFunction.A.noalias() -= Bm * Pm;
+  valueFunction.b = projectedModelData.dynamicsBias;
+  valueFunction.b.noalias() -= Bm * Rv;
+  valueFunction.C.noalias() = Bm * Bm.transpose();
+  valueFunction.J = projectedModelData.cost.dfdxx + riccatiModification.deltaQm_;
+  valueFunction.J.noalias() -= Pm.transpose() * Pm;
+  valueFunction.eta = -projectedModelData.cost.dfdx;
+  valueFunction.eta.noalias() += Pm.transpose() * Rv;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void setEventValueFunction(const ModelData& jumpModelData, ConditionalValueFunction& valueFunction) {
+  const auto stateDim = jumpModelData.dynamics.dfdx.rows();
+  valueFunction.A = jumpModelData.dynamics.dfdx;
+  valueFunction.b = jumpModelData.dynamicsBias;
+  valueFunction.C.setZero(stateDim, stateDim);
+  valueFunction.J = jumpModelData.cost.dfdxx;
+  valueFunction.eta = -jumpModelData.cost.dfdx;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void appendValueFunction(ConditionalValueFunction& segment, const ConditionalValueFunction& next) {
+  // eliminate the intermediate state and its multiplier: with M = (I + C1 * J2)^{-1}, it holds that (I + J2 * C1)^{-1} = M^T
+  const Eigen::PartialPivLU<matrix_t> lu(matrix_t::Identity(segment.C.rows(), segment.C.rows()) + segment.C * next.J);
+  const matrix_t MA = lu.solve(segment.A);
+  const vector_t Mb = lu.solve(segment.b + segment.C * next.eta);
+  const matrix_t MC = lu.solve(segment.C);
+
+  segment.eta.noalias() += MA.transpose() * (next.eta - next.J * segment.b);
+  segment.J.noalias() += MA.transpose() * next.J * segment.A;
+  segment.J = 0.5 * (segment.J + segment.J.transpose()).eval();
+
+  segment.A = next.A * MA;
+  segment.b = next.b;
+  segment.b.noalias() += next.A * Mb;
+  segment.C = next.C;
+  segment.C.noalias() += next.A * MC * next.A.transpose();
+  segment.C = 0.5 * (segment.C + segment.C.transpose()).eval();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void computeValueFunction(const ConditionalValueFunction& segment, const matrix_t& SmNext, const vector_t& SvNext, matrix_t& Sm,
+                          vector_t& Sv) {
+  const Eigen::PartialPivLU<matrix_t> lu(matrix_t::Identity(SmNext.rows(), SmNext.rows()) + segment.C * SmNext);
+  const matrix_t MA = lu.solve(segment.A);
+
+  Sm = segment.J;
+  Sm.noalias() += MA.transpose() * SmNext * segment.A;
+  Sm = 0.5 * (Sm + Sm.transpose()).eval();
+
+  Sv = -segment.eta;
+  Sv.noalias() += MA.transpose() * (SvNext + SmNext * segment.b);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void computeFinalState(const ConditionalValueFunction& segment, const matrix_t& SmNext, const vector_t& SvNext, const vector_t& initState,
+                       vector_t& finalState) {
+  // maximizing over the multiplier: y = (I + C * SmNext)^{-1} (A x + b - C * SvNext)
+  const Eigen::PartialPivLU<matrix_t> lu(matrix_t::Identity(SmNext.rows(), SmNext.rows()) + segment.C * SmNext);
+  vector_t rhs = segment.b;
+  rhs.noalias() += segment.A * initState;
+  rhs.noalias() -= segment.C * SvNext;
+  finalState = lu.solve(rhs);
+}
+
+}  // namespace riccati_scan
+}  // namespace ocs2
@@ -0,0 +1,103 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#include "ocs2_ddp/riccati_equations/MatrixExponentialRiccatiEquations.h"
+
+#include <unsupported/Eigen/MatrixFunctions>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MatrixExponentialRiccatiEquations::computeMap(const ModelData& projectedModelData, const ModelData& projectedModelDataNext,
+                                                   const matrix_t& deltaQm, const matrix_t& deltaQmNext, scalar_t timeStep,
+                                                   const ScalarFunctionQuadraticApproximation& valueFunctionNext,
+                                                   ScalarFunctionQuadraticApproximation& valueFunction) {
+  const auto stateDim = projectedModelData.dynamics.dfdx.rows();
+  const auto projectedInputDim = projectedModelData.dynamics.dfdu.cols();
+  const auto augmentedStateDim = stateDim + 1;
+
+  // averaged cross terms
+  projectedPm_ = 0.5 * (projectedModelData.cost.dfdux + projectedModelDataNext.cost.dfdux);
+  projectedRv_ = 0.5 * (projectedModelData.cost.dfdu + projectedModelDataNext.cost.dfdu);
+
+  // augmentedBm = [Bm; 0]
+  augmentedBm_.setZero(augmentedStateDim, projectedInputDim);
+  augmentedBm_.topRows(stateDim) = 0.5 * (projectedModelData.dynamics.dfdu + projectedModelDataNext.dynamics.dfdu);
+  const auto Bm = augmentedBm_.topRows(stateDim);
+
+  // augmentedAm = [Am - Bm * Pm, Hv - Bm * Rv; 0, 0]
+  augmentedAm_.setZero(augmentedStateDim, augmentedStateDim);
+  augmentedAm_.topLeftCorner(stateDim, stateDim) = 0.5 * (projectedModelData.dynamics.dfdx + projectedModelDataNext.dynamics.dfdx);
+  augmentedAm_.topLeftCorner(stateDim, stateDim).noalias() -= Bm * projectedPm_;
+  augmentedAm_.topRightCorner(stateDim, 1) = 0.5 * (projectedModelData.dynamicsBias + projectedModelDataNext.dynamicsBias);
+  augmentedAm_.topRightCorner(stateDim, 1).noalias() -= Bm * projectedRv_;
+
+  // augmentedQm = [Qm + deltaQm - Pm' * Pm, Qv - Pm' * Rv; (Qv - Pm' * Rv)', 2q - Rv' * Rv]
+  augmentedQm_.resize(augmentedStateDim, augmentedStateDim);
+  augmentedQm_.topLeftCorner(stateDim, stateDim) =
+      0.5 * (projectedModelData.cost.dfdxx + projectedModelDataNext.cost.dfdxx + deltaQm + deltaQmNext);
+  augmentedQm_.topLeftCorner(stateDim, stateDim).noalias() -= projectedPm_.transpose() * projectedPm_;
+  augmentedQm_.topRightCorner(stateDim, 1) = 0.5 * (projectedModelData.cost.dfdx + projectedModelDataNext.cost.dfdx);
+  augmentedQm_.topRightCorner(stateDim, 1).noalias() -= projectedPm_.transpose() * projectedRv_;
+  augmentedQm_.bottomLeftCorner(1, stateDim) = augmentedQm_.topRightCorner(stateDim, 1).transpose();
+  augmentedQm_(stateDim, stateDim) = projectedModelData.cost.f + projectedModelDataNext.cost.f - projectedRv_.squaredNorm();
+
+  /*
+   * With Sm = Y * X^-1, the Riccati equation -dSm/dt = Qm + Am' * Sm + Sm * Am - Sm * Bm * Bm' * Sm is the linear Hamiltonian system
+   * d[X; Y]/dt = [Am, -Bm * Bm'; -Qm, -Am'] * [X; Y]. Backward over the step: [X; Y] = exp(-timeStep * H) * [I; SmNext].
+   */
+  hamiltonian_.resize(2 * augmentedStateDim, 2 * augmentedStateDim);
+  hamiltonian_.topLeftCorner(augmentedStateDim, augmentedStateDim) = -timeStep * augmentedAm_;
+  hamiltonian_.topRightCorner(augmentedStateDim, augmentedStateDim).noalias() = timeStep * augmentedBm_ * augmentedBm_.transpose();
+  hamiltonian_.bottomLeftCorner(augmentedStateDim, augmentedStateDim) = timeStep * augmentedQm_;
+  hamiltonian_.bottomRightCorner(augmentedStateDim, augmentedStateDim) = timeStep * augmentedAm_.transpose();
+  hamiltonianExponential_ = hamiltonian_.exp();
+
+  // augmented Riccati matrix at the end of the step: [Sm, Sv; Sv', 2s]
+  augmentedSm_.resize(augmentedStateDim, augmentedStateDim);
+  augmentedSm_.topLeftCorner(stateDim, stateDim) = valueFunctionNext.dfdxx;
+  augmentedSm_.topRightCorner(stateDim, 1) = valueFunctionNext.dfdx;
+  augmentedSm_.bottomLeftCorner(1, stateDim) = valueFunctionNext.dfdx.transpose();
+  augmentedSm_(stateDim, stateDim) = 2.0 * valueFunctionNext.f;
+
+  // [X; Y]
+  XY_.noalias() = hamiltonianExponential_.rightCols(augmentedStateDim) * augmentedSm_;
+  XY_ += hamiltonianExponential_.leftCols(augmentedStateDim);
+
+  // Sm = Y * X^-1, i.e. X' * Sm = Y' for the symmetric Sm
+  augmentedSm_ = XY_.topRows(augmentedStateDim).transpose().partialPivLu().solve(XY_.bottomRows(augmentedStateDim).transpose());
+
+  valueFunction.dfdxx = 0.5 * (augmentedSm_.topLeftCorner(stateDim, stateDim) + augmentedSm_.topLeftCorner(stateDim, stateDim).transpose());
+  valueFunction.dfdx = 0.5 * (augmentedSm_.topRightCorner(stateDim, 1) + augmentedSm_.bottomLeftCorner(1, stateDim).transpose());
+  valueFunction.f = 0.5 * augmentedSm_(stateDim, stateDim);
+}
+
+}  // namespace ocs2
@@ -58,7 +58,8 @@ void LevenbergMarquardtStrategy::reset() {
 /******************************************************************************************************/
 bool LevenbergMarquardtStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState,
                                      const scalar_t expectedCost, const LinearController& unoptimizedController,
-                                     const ModeSchedule& modeSchedule, search_strategy::SolutionRef solution) {
+                                     const ModeSchedule& modeSchedule, const ShootingNodes& /*shootingNodes*/,
+                                     search_strategy::SolutionRef solution) {
   constexpr size_t taskId = 0;
 
   // previous merit and the expected reduction
@@ -73,6 +74,7 @@ bool LevenbergMarquardtStrategy::run(const std::pair<scalar_t, scalar_t>& timePe
     solution.primalSolution.modeSchedule_ = modeSchedule;
     incrementController(stepLength, unoptimizedController, getLinearController(solution.primalSolution));
     solution.avgTimeStep = rolloutTrajectory(rolloutRef_, timePeriod.first, initState, timePeriod.second, solution.primalSolution);
+    solution.shootingDefects.clear();
 
     // compute metrics
     computeRolloutMetrics(optimalControlProblemRef_, solution.primalSolution, solution.metrics);
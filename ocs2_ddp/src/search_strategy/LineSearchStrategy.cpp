@@ -86,14 +86,29 @@ void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, sea
   // compute primal solution
   solution.primalSolution.modeSchedule_ = *lineSearchInputRef_.modeSchedulePtr;
   incrementController(stepLength, *lineSearchInputRef_.unoptimizedControllerPtr, getLinearController(solution.primalSolution));
-  solution.avgTimeStep = rolloutTrajectory(rollout, lineSearchInputRef_.timePeriodPtr->first, *lineSearchInputRef_.initStatePtr,
-                                           lineSearchInputRef_.timePeriodPtr->second, solution.primalSolution);
+  const auto& shootingNodes = *lineSearchInputRef_.shootingNodesPtr;
+  if (shootingNodes.times.empty()) {
+    solution.avgTimeStep = rolloutTrajectory(rollout, lineSearchInputRef_.timePeriodPtr->first, *lineSearchInputRef_.initStatePtr,
+                                             lineSearchInputRef_.timePeriodPtr->second, solution.primalSolution);
+    solution.shootingDefects.clear();
+
+  } else {
+    scalar_array_t shootingTimes{lineSearchInputRef_.timePeriodPtr->first};
+    vector_array_t shootingStates{*lineSearchInputRef_.initStatePtr};
+    shootingTimes.insert(shootingTimes.end(), shootingNodes.times.begin(), shootingNodes.times.end());
+    for (size_t i = 0; i < shootingNodes.times.size(); i++) {
+      shootingStates.push_back(shootingNodes.states[i] + stepLength * shootingNodes.stateIncrements[i]);
+    }
+    solution.avgTimeStep = rolloutTrajectory(threadPoolRef_, rolloutRefStock_, shootingTimes, shootingStates,
+                                             lineSearchInputRef_.timePeriodPtr->second, solution.primalSolution, solution.shootingDefects);
+  }
 
   // compute metrics
   computeRolloutMetrics(problem, solution.primalSolution, solution.metrics);
 
   // compute performanceIndex
   solution.performanceIndex = computeRolloutPerformanceIndex(solution.primalSolution.timeTrajectory_, solution.metrics);
+  solution.performanceIndex.dynamicsViolationSSE = computeDynamicsViolationSSE(solution.shootingDefects);
   solution.performanceIndex.merit = meritFunc_(solution.performanceIndex);
 
   // display
@@ -110,12 +125,13 @@ void LineSearchStrategy::computeSolution(size_t taskId, scalar_t stepLength, sea
 /******************************************************************************************************/
 bool LineSearchStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, const vector_t& initState, const scalar_t expectedCost,
                              const LinearController& unoptimizedController, const ModeSchedule& modeSchedule,
-                             search_strategy::SolutionRef solutionRef) {
+                             const ShootingNodes& shootingNodes, search_strategy::SolutionRef solutionRef) {
   // initialize lineSearchModule inputs
   lineSearchInputRef_.timePeriodPtr = &timePeriod;
   lineSearchInputRef_.initStatePtr = &initState;
   lineSearchInputRef_.unoptimizedControllerPtr = &unoptimizedController;
   lineSearchInputRef_.modeSchedulePtr = &modeSchedule;
+  lineSearchInputRef_.shootingNodesPtr = &shootingNodes;
   bestSolutionRef_ = &solutionRef;
 
   // perform a rollout with steplength zero.
@@ -142,8 +158,13 @@ bool LineSearchStrategy::run(const std::pair<scalar_t, scalar_t>& timePeriod, co
   nextTaskId_ = 0;
   alphaExpNext_ = 0;
   alphaProcessed_ = std::vector<bool>(maxNumOfSearches(), false);
-  auto task = [&](int) { lineSearchTask(nextTaskId_++); };
-  threadPoolRef_.runParallel(task, threadPoolRef_.numThreads());
+  if (shootingNodes.times.empty()) {
+    auto task = [&](int) { lineSearchTask(nextTaskId_++); };
+    threadPoolRef_.runParallel(task, threadPoolRef_.numThreads());
+  } else {
+    // the multiple-shooting rollouts use the thread pool
+    lineSearchTask(nextTaskId_++);
+  }
 
   // revitalize all integrators
   for (RolloutBase& rollout : rolloutRefStock_) {
@@ -187,6 +208,15 @@ void LineSearchStrategy::lineSearchTask(const size_t taskId) {
       break;
     }
 
+    // stop if the time budget is exhausted. The rollout with step length zero is already recorded as the fallback.
+    if (isTimeBudgetExhausted()) {
+      if (baseSettings_.displayInfo) {
+        printString("    [Thread " + std::to_string(taskId) + "] rollout with step length " + std::to_string(stepLength) +
+                    " is skipped: The time budget is exhausted!\n");
+      }
+      break;
+    }
+
     try {
       computeSolution(taskId, stepLength, workersSolution_[taskId]);
     } catch (const std::exception& error) {
@@ -258,7 +288,8 @@ std::pair<bool, std::string> LineSearchStrategy::checkConvergence(bool unreliabl
       previousPerformanceIndex.cost + previousPerformanceIndex.equalityLagrangian + previousPerformanceIndex.inequalityLagrangian;
   const scalar_t relCost = std::abs(currentTotalCost - previousTotalCost);
   const bool isCostFunctionConverged = relCost <= baseSettings_.minRelCost;
-  const bool isConstraintsSatisfied = currentPerformanceIndex.equalityConstraintsSSE <= baseSettings_.constraintTolerance;
+  const bool isConstraintsSatisfied = currentPerformanceIndex.equalityConstraintsSSE <= baseSettings_.constraintTolerance &&
+                                      currentPerformanceIndex.dynamicsViolationSSE <= baseSettings_.constraintTolerance;
   const bool isOptimizationConverged = isCostFunctionConverged && isConstraintsSatisfied;
 
   // convergence info
@@ -271,6 +302,11 @@ std::pair<bool, std::string> LineSearchStrategy::checkConvergence(bool unreliabl
 
     infoStream << "    * The SSE of equality constraints (i.e., " << currentPerformanceIndex.equalityConstraintsSSE
                << ") has reached to its minimum value (" << baseSettings_.constraintTolerance << ").";
+
+    if (currentPerformanceIndex.dynamicsViolationSSE > 0.0) {
+      infoStream << "\n    * The SSE of dynamics violation (i.e., " << currentPerformanceIndex.dynamicsViolationSSE
+                 << ") has reached to its minimum value (" << baseSettings_.constraintTolerance << ").";
+    }
   }
 
   return {isOptimizationConverged, infoStream.str()};
@@ -28,9 +28,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include <gtest/gtest.h>
+#include <cmath>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
+#include <limits>
 
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
@@ -259,6 +261,147 @@ TEST_P(Exp1, ILQR) {
   performanceIndexTest(ddpSettings, performanceIndex);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, ILQR_parallelRiccatiScan) {
+  // dynamics and rollout
+  ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  // sequential Riccati pass
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::ILQR, 1, ocs2::search_strategy::Type::LINE_SEARCH);
+  ocs2::ILQR ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+  ddp.run(startTime, initState, finalTime);
+
+  // parallel Riccati pass with exact partition boundaries
+  auto ddpScanSettings = getSettings(ocs2::ddp::Algorithm::ILQR, 3, ocs2::search_strategy::Type::LINE_SEARCH);
+  ddpScanSettings.parallelRiccatiScan_ = true;
+  ocs2::ILQR ddpScan(ddpScanSettings, rollout, problem, *initializerPtr);
+  ddpScan.setReferenceManager(referenceManagerPtr);
+  ddpScan.run(startTime, initState, finalTime);
+
+  // The Riccati solutions match up to round-off errors, which the adaptive rollouts amplify until the convergence tolerance is met.
+  performanceIndexTest(ddpScanSettings, ddpScan.getPerformanceIndeces());
+  EXPECT_NEAR(ddpScan.getPerformanceIndeces().cost, ddp.getPerformanceIndeces().cost, ddpSettings.minRelCost_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, SLQ_matrixExponentialRiccati) {
+  // dynamics and rollout
+  ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  auto getBackwardPassDuration = [](const ocs2::SLQ& ddp) {
+    for (const auto& phase : ddp.getTimeBudget().getPhaseDurations()) {
+      if (phase.first == "Backward Pass") {
+        return phase.second;
+      }
+    }
+    return std::numeric_limits<ocs2::scalar_t>::quiet_NaN();
+  };
+
+  // backward pass with the adaptive integrator
+  const auto ddpOdeSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 3, ocs2::search_strategy::Type::LINE_SEARCH);
+  ocs2::SLQ ddpOde(ddpOdeSettings, rollout, problem, *initializerPtr);
+  ddpOde.setReferenceManager(referenceManagerPtr);
+  ddpOde.run(startTime, initState, finalTime);
+
+  // backward pass with the exact step
+  auto ddpSettings = ddpOdeSettings;
+  ddpSettings.matrixExponentialRiccati_ = true;
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+  ddp.run(startTime, initState, finalTime);
+
+  std::cerr << "[SLQ] backward pass, ODE: " << 1e3 * getBackwardPassDuration(ddpOde) << " [ms] in " << ddpOde.getIterationsLog().size()
+            << " iterations, matrix exponential: " << 1e3 * getBackwardPassDuration(ddp) << " [ms] in " << ddp.getIterationsLog().size()
+            << " iterations\n";
+
+  performanceIndexTest(ddpOdeSettings, ddpOde.getPerformanceIndeces());
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+
+  // unsupported settings
+  auto ddpLmSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 3, ocs2::search_strategy::Type::LEVENBERG_MARQUARDT);
+  ddpLmSettings.matrixExponentialRiccati_ = true;
+  EXPECT_THROW(ocs2::SLQ(ddpLmSettings, rollout, problem, *initializerPtr), std::runtime_error);
+
+  auto ddpRiskSettings = ddpSettings;
+  ddpRiskSettings.riskSensitiveCoeff_ = 0.1;
+  EXPECT_THROW(ocs2::SLQ(ddpRiskSettings, rollout, problem, *initializerPtr), std::runtime_error);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, ILQR_multipleShooting) {
+  // dynamics and rollout
+  ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  auto ddpSettings = getSettings(ocs2::ddp::Algorithm::ILQR, 3, ocs2::search_strategy::Type::LINE_SEARCH);
+  ddpSettings.numShootingIntervals_ = 6;
+  ocs2::ILQR ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+
+  // cold start
+  ddp.run(startTime, initState, finalTime);
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+  EXPECT_LT(ddp.getPerformanceIndeces().dynamicsViolationSSE, ddpSettings.constraintTolerance_);
+
+  // warm start, the shooting intervals start from the previous solution
+  ddp.run(startTime, initState, finalTime);
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+  EXPECT_LT(ddp.getPerformanceIndeces().dynamicsViolationSSE, ddpSettings.constraintTolerance_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp1, SLQ_timeBudget) {
+  // dynamics and rollout
+  ocs2::EXP1_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::SLQ, 1, ocs2::search_strategy::Type::LINE_SEARCH);
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setReferenceManager(referenceManagerPtr);
+
+  // without a budget the solver converges
+  ddp.run(startTime, initState, finalTime);
+  const auto numConvergedIterations = ddp.getIterationsLog().size();
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+  EXPECT_FALSE(ddp.getTimeBudget().isLimited());
+
+  // a budget which does not suffice for a single iteration returns the rollout of the initial controller
+  ddp.reset();
+  ddp.setTimeBudget(1e-9);
+  ddp.run(startTime, initState, finalTime);
+  EXPECT_LT(ddp.getIterationsLog().size(), numConvergedIterations);
+  EXPECT_TRUE(std::isfinite(ddp.getPerformanceIndeces().merit));
+  EXPECT_FALSE(ddp.primalSolution(finalTime).timeTrajectory_.empty());
+
+  // the time spent in each phase is recorded
+  const auto& phaseDurations = ddp.getTimeBudget().getPhaseDurations();
+  EXPECT_EQ(phaseDurations.size(), 5);
+  ocs2::scalar_t totalPhaseDuration = 0.0;
+  for (const auto& phase : phaseDurations) {
+    EXPECT_GE(phase.second, 0.0);
+    totalPhaseDuration += phase.second;
+  }
+  EXPECT_LE(totalPhaseDuration, ddp.getTimeBudget().getElapsedTime());
+
+  // an ample budget does not change the solution
+  ddp.reset();
+  ddp.setTimeBudget(100.0);
+  ddp.run(startTime, initState, finalTime);
+  EXPECT_EQ(ddp.getIterationsLog().size(), numConvergedIterations);
+  performanceIndexTest(ddpSettings, ddp.getPerformanceIndeces());
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -34,6 +34,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_core/misc/randomMatrices.h>
 #include <ocs2_ddp/riccati_equations/ContinuousTimeRiccatiEquations.h>
+#include <ocs2_ddp/riccati_equations/DiscreteTimeRiccatiEquations.h>
+#include <ocs2_ddp/riccati_equations/DiscreteTimeRiccatiScan.h>
+#include <ocs2_ddp/riccati_equations/MatrixExponentialRiccatiEquations.h>
+#include <ocs2_ddp/riccati_equations/RiccatiTransversalityConditions.h>
 
 class RiccatiInitializer {
  public:
@@ -104,6 +108,49 @@ TEST(RiccatiTest, compareImplementations) {
   EXPECT_LE((dSdz_precompute - dSdz_noPrecompute).array().abs().maxCoeff(), 1e-9);
 }
 
+TEST(RiccatiTest, matrixExponentialRiccati) {
+  constexpr int STATE_DIM = 6;
+  constexpr int INPUT_DIM = 2;
+  constexpr int numSubsteps = 1000;
+
+  using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
+
+  // the reduced form assumes the same projected LQ model as the matrix-exponential step
+  riccati_t riccatiEquation(true);
+  RiccatiInitializer ri(STATE_DIM, INPUT_DIM);
+  ri.initialize(riccatiEquation);
+
+  ocs2::ScalarFunctionQuadraticApproximation valueFunctionFinal;
+  valueFunctionFinal.dfdxx = ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(STATE_DIM);
+  valueFunctionFinal.dfdx = ocs2::vector_t::Random(STATE_DIM);
+  valueFunctionFinal.f = 0.5;
+
+  // reference solution with RK4 on a fine grid in the normalized time z = -t
+  const ocs2::scalar_t dz = (ri.timeStamp.back() - ri.timeStamp.front()) / numSubsteps;
+  ocs2::vector_t allSs = riccati_t::convert2Vector(valueFunctionFinal);
+  for (int i = 0; i < numSubsteps; i++) {
+    const ocs2::scalar_t z = -ri.timeStamp.back() + i * dz;
+    const ocs2::vector_t k1 = riccatiEquation.computeFlowMap(z, allSs);
+    const ocs2::vector_t k2 = riccatiEquation.computeFlowMap(z + 0.5 * dz, allSs + 0.5 * dz * k1);
+    const ocs2::vector_t k3 = riccatiEquation.computeFlowMap(z + 0.5 * dz, allSs + 0.5 * dz * k2);
+    const ocs2::vector_t k4 = riccatiEquation.computeFlowMap(z + dz, allSs + dz * k3);
+    allSs += dz / 6.0 * (k1 + 2.0 * k2 + 2.0 * k3 + k4);
+  }
+  ocs2::ScalarFunctionQuadraticApproximation valueFunctionReference;
+  riccati_t::convert2Matrix(allSs, valueFunctionReference);
+
+  // a single exact step
+  ocs2::MatrixExponentialRiccatiEquations matrixExponentialRiccati;
+  ocs2::ScalarFunctionQuadraticApproximation valueFunction;
+  matrixExponentialRiccati.computeMap(ri.projectedModelDataTrajectory[0], ri.projectedModelDataTrajectory[1],
+                                      ri.riccatiModificationTrajectory[0].deltaQm_, ri.riccatiModificationTrajectory[1].deltaQm_,
+                                      ri.timeStamp.back() - ri.timeStamp.front(), valueFunctionFinal, valueFunction);
+
+  EXPECT_TRUE(valueFunction.dfdxx.isApprox(valueFunctionReference.dfdxx, 1e-6));
+  EXPECT_TRUE(valueFunction.dfdx.isApprox(valueFunctionReference.dfdx, 1e-6));
+  EXPECT_NEAR(valueFunction.f, valueFunctionReference.f, 1e-6 * std::max(1.0, std::abs(valueFunctionReference.f)));
+}
+
 TEST(RiccatiTest, testFlattenSMatrix) {
   const int stateDim = 4;
   using riccati_t = ocs2::ContinuousTimeRiccatiEquations;
@@ -155,3 +202,81 @@ TEST(RiccatiTest, testFlattenAndUnflatten) {
   ASSERT_TRUE(Sv.isApprox(Sv_out));
   ASSERT_TRUE(Sm.isApprox(Sm_out));
 }
+
+TEST(RiccatiTest, discreteTimeRiccatiScan) {
+  constexpr int STATE_DIM = 6;
+  constexpr int INPUT_DIM = 2;
+  constexpr int N = 24;
+  constexpr int eventIndex = 10;  // the node before the event
+  const std::vector<int> segmentStarts{0, 5, 10, 11, 17, N};
+
+  // random projected LQ problem and a jump at the event
+  std::vector<ocs2::ModelData> projectedModelDataTrajectory;
+  std::vector<ocs2::riccati_modification::Data> riccatiModificationTrajectory;
+  for (int k = 0; k < N; k++) {
+    RiccatiInitializer ri(STATE_DIM, INPUT_DIM);
+    auto& projectedModelData = ri.projectedModelDataTrajectory.front();
+    projectedModelData.dynamics.dfdx = ocs2::matrix_t::Identity(STATE_DIM, STATE_DIM) + 0.1 * ocs2::matrix_t::Random(STATE_DIM, STATE_DIM);
+    projectedModelData.dynamics.dfdu *= 0.1;
+    projectedModelDataTrajectory.push_back(projectedModelData);
+    riccatiModificationTrajectory.push_back(ri.riccatiModificationTrajectory.front());
+  }
+  ocs2::ModelData jumpModelData = RiccatiInitializer(STATE_DIM, INPUT_DIM).projectedModelDataTrajectory.front();
+
+  // sequential Riccati recursion
+  ocs2::matrix_array_t Sm(N + 1);
+  ocs2::vector_array_t Sv(N + 1);
+  ocs2::scalar_array_t s(N + 1);
+  Sm[N] = ocs2::LinearAlgebra::generateSPDmatrix<ocs2::matrix_t>(STATE_DIM);
+  Sv[N] = ocs2::vector_t::Random(STATE_DIM);
+  s[N] = 0.0;
+  for (int k = N - 1; k >= 0; k--) {
+    if (k == eventIndex) {
+      std::tie(Sm[k], Sv[k], s[k]) = ocs2::riccatiTransversalityConditions(jumpModelData, Sm[k + 1], Sv[k + 1], s[k + 1]);
+    } else {
+      const auto& Am = projectedModelDataTrajectory[k].dynamics.dfdx;
+      const auto& Bm = projectedModelDataTrajectory[k].dynamics.dfdu;
+      const auto& Hv = projectedModelDataTrajectory[k].dynamicsBias;
+      const auto& cost = projectedModelDataTrajectory[k].cost;
+      const ocs2::matrix_t Hm = cost.dfduu + Bm.transpose() * Sm[k + 1] * Bm;
+      const ocs2::matrix_t Gm = cost.dfdux + Bm.transpose() * Sm[k + 1] * Am;
+      const ocs2::vector_t Gv = cost.dfdu + Bm.transpose() * (Sv[k + 1] + Sm[k + 1] * Hv);
+      const ocs2::matrix_t Km = -Hm.ldlt().solve(Gm);
+      const ocs2::vector_t Lv = -Hm.ldlt().solve(Gv);
+      Sm[k] = cost.dfdxx + riccatiModificationTrajectory[k].deltaQm_ + Am.transpose() * Sm[k + 1] * Am + Gm.transpose() * Km;
+      Sv[k] = cost.dfdx + Am.transpose() * (Sv[k + 1] + Sm[k + 1] * Hv) + Gm.transpose() * Lv;
+      s[k] = 0.0;
+    }
+  }
+
+  // condense the segments and scan them backward
+  const int numSegments = segmentStarts.size() - 1;
+  std::vector<ocs2::riccati_scan::ConditionalValueFunction> segmentValueFunctions(numSegments);
+  for (int j = 0; j < numSegments; j++) {
+    ocs2::riccati_scan::ConditionalValueFunction nodeValueFunction;
+    for (int k = segmentStarts[j]; k < segmentStarts[j + 1]; k++) {
+      auto& dstValueFunction = (k == segmentStarts[j]) ? segmentValueFunctions[j] : nodeValueFunction;
+      if (k == eventIndex) {
+        ocs2::riccati_scan::setEventValueFunction(jumpModelData, dstValueFunction);
+      } else {
+        ocs2::riccati_scan::setIntermediateValueFunction(projectedModelDataTrajectory[k], riccatiModificationTrajectory[k],
+                                                         dstValueFunction);
+      }
+      if (k > segmentStarts[j]) {
+        ocs2::riccati_scan::appendValueFunction(segmentValueFunctions[j], nodeValueFunction);
+      }
+    }
+  }
+
+  ocs2::matrix_t SmScan = Sm[N];
+  ocs2::vector_t SvScan = Sv[N];
+  for (int j = numSegments - 1; j >= 0; j--) {
+    ocs2::matrix_t SmStart;
+    ocs2::vector_t SvStart;
+    ocs2::riccati_scan::computeValueFunction(segmentValueFunctions[j], SmScan, SvScan, SmStart, SvStart);
+    SmScan = std::move(SmStart);
+    SvScan = std::move(SvStart);
+    ASSERT_TRUE(SmScan.isApprox(Sm[segmentStarts[j]], 1e-9)) << "segment " << j;
+    ASSERT_TRUE(SvScan.isApprox(Sv[segmentStarts[j]], 1e-9)) << "segment " << j;
+  }
+}
@@ -0,0 +1,126 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_mpc/PolicyCodec.h>
+
+#include "ocs2_mpc/test/testPolicies.h"
+
+namespace {
+
+constexpr size_t STATE_DIM = 12;
+constexpr size_t INPUT_DIM = 12;
+constexpr size_t NUM_NODES = 100;
+
+using ocs2::policy_codec::Precision;
+
+/** The size of the policy as ocs2_msgs::mpc_flattened_controller: float32 trajectories and LinearController::flatten. */
+size_t getFlattenedSize(const ocs2::PrimalSolution& primalSolution) {
+  const auto N = primalSolution.timeTrajectory_.size();
+  std::vector<std::vector<float>> data(N);
+  std::vector<std::vector<float>*> dataPtrs;
+  for (auto& d : data) {
+    dataPtrs.push_back(&d);
+  }
+  primalSolution.controllerPtr_->flatten(primalSolution.timeTrajectory_, dataPtrs);
+
+  size_t size = N * sizeof(double) + N * (STATE_DIM + INPUT_DIM) * sizeof(float);
+  for (const auto& d : data) {
+    size += d.size() * sizeof(float);
+  }
+  return size;
+}
+
+}  // unnamed namespace
+
+int main() {
+  constexpr size_t numPolicies = 100;
+  constexpr ocs2::scalar_t mpcPeriod = 0.01;
+
+  struct Case {
+    std::string name;
+    Precision trajectoryPrecision;
+    Precision gainPrecision;
+    bool deltaEncoding;
+    ocs2::scalar_t deltaTolerance;
+  };
+  const std::vector<Case> cases{{"float64", Precision::FLOAT64, Precision::FLOAT64, false, 0.0},
+                                {"float32", Precision::FLOAT32, Precision::FLOAT32, false, 0.0},
+                                {"float32 + float16 gains", Precision::FLOAT32, Precision::FLOAT16, false, 0.0},
+                                {"float16 + int8 gains", Precision::FLOAT16, Precision::INT8, false, 0.0},
+                                {"delta float32 + float16 gains", Precision::FLOAT32, Precision::FLOAT16, true, 0.0},
+                                {"delta float32 + float16 gains, 1e-3 tolerance", Precision::FLOAT32, Precision::FLOAT16, true, 1e-3}};
+
+  // the policies of consecutive MPC cycles with a small change of the solution
+  std::vector<ocs2::PrimalSolution> policies;
+  for (size_t i = 0; i < numPolicies; i++) {
+    policies.push_back(ocs2::getSmoothPolicy(STATE_DIM, INPUT_DIM, NUM_NODES, i * mpcPeriod, true, 1e-4 * i));
+  }
+  std::cout << "[PolicyCodec] flattened controller message: " << getFlattenedSize(policies.front()) << " [bytes]\n";
+
+  for (const auto& c : cases) {
+    ocs2::policy_codec::Settings settings;
+    settings.trajectoryPrecision = c.trajectoryPrecision;
+    settings.gainPrecision = c.gainPrecision;
+    settings.deltaEncoding = c.deltaEncoding;
+    settings.deltaTolerance = c.deltaTolerance;
+    ocs2::PolicyEncoder encoder(settings);
+    ocs2::PolicyDecoder decoder;
+
+    std::vector<uint8_t> message;
+    ocs2::PrimalSolution decoded;
+    size_t totalSize = 0;
+    double encodeDuration = 0.0;
+    double decodeDuration = 0.0;
+    for (const auto& primalSolution : policies) {
+      auto startTime = std::chrono::steady_clock::now();
+      encoder.encode(primalSolution, message);
+      encodeDuration += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+      totalSize += message.size();
+
+      startTime = std::chrono::steady_clock::now();
+      if (!decoder.decode(message, decoded)) {
+        std::cerr << "[PolicyCodec] " << c.name << ": decoding failed\n";
+        return 1;
+      }
+      decodeDuration += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    std::cout << "[PolicyCodec] " << c.name << ": " << totalSize / numPolicies << " [bytes], encode: " << encodeDuration / numPolicies
+              << " [us], decode: " << decodeDuration / numPolicies << " [us]\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,82 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <chrono>
+#include <iostream>
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_mpc/PolicyEvaluator.h>
+
+#include "ocs2_mpc/test/testPolicies.h"
+
+namespace {
+
+constexpr size_t STATE_DIM = 12;
+constexpr size_t INPUT_DIM = 6;
+
+}  // unnamed namespace
+
+int main() {
+  constexpr ocs2::scalar_t controlRate = 1000.0;
+
+  for (const size_t numNodes : {100, 1000, 10000}) {
+    const auto primalSolution = ocs2::getRandomPolicy(STATE_DIM, INPUT_DIM, numNodes, true);
+    const auto numQueries = static_cast<size_t>(controlRate * primalSolution.timeTrajectory_.back());
+    const ocs2::vector_t state = ocs2::vector_t::Random(STATE_DIM);
+
+    // evaluation through the controller interface
+    auto& controller = *primalSolution.controllerPtr_;
+    ocs2::vector_t input, nominalState;
+    size_t mode;
+    auto startTime = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < numQueries; i++) {
+      const ocs2::scalar_t t = i / controlRate;
+      input = controller.computeInput(t, state);
+      nominalState = ocs2::LinearInterpolation::interpolate(t, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+      mode = primalSolution.modeSchedule_.modeAtTime(t);
+    }
+    const auto controllerDuration = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+
+    // evaluation with the cursors. The first call sizes the outputs.
+    ocs2::PolicyEvaluator policyEvaluator;
+    policyEvaluator.setPolicy(primalSolution);
+    policyEvaluator.evaluate(0.0, state, input, nominalState, mode);
+    startTime = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < numQueries; i++) {
+      policyEvaluator.evaluate(i / controlRate, state, input, nominalState, mode);
+    }
+    const auto evaluatorDuration = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+
+    std::cout << "[PolicyEvaluator] nodes: " << primalSolution.timeTrajectory_.size()
+              << ", computeInput + interpolate + modeAtTime: " << controllerDuration / numQueries << " [us]"
+              << ", PolicyEvaluator: " << evaluatorDuration / numQueries << " [us]\n";
+  }
+
+  return 0;
+}
@@ -65,7 +65,24 @@ class MPC_BASE {
    * @param [in] currentTime: The given time.
    * @param [in] currentState: The given state.
    */
-  virtual bool run(scalar_t currentTime, const vector_t& currentState);
+  virtual bool run(scalar_t currentTime, const vector_t& currentState) { return run(currentTime, currentState, mpcSettings_.timeBudget_); }
+
+  /**
+   * The main routine of MPC which runs MPC for the given state and time within the given wall-clock budget. When the budget
+   * does not suffice for another iteration, the solver stops and the policy of its best iterate so far is used. The time spent
+   * in each phase of the solver is available through getSolverPtr()->getTimeBudget().
+   *
+   * @param [in] currentTime: The given time.
+   * @param [in] currentState: The given state.
+   * @param [in] timeBudget: The time budget in seconds. Any non-positive number lets the solver run until convergence.
+   */
+  bool run(scalar_t currentTime, const vector_t& currentState, scalar_t timeBudget);
+
+  /**
+   * Prepares the next call to run() with all the work that does not depend on the next observation. It is called by the MPC
+   * interfaces once the policy of the latest run() is published. The default implementation does nothing.
+   */
+  virtual void prepareNextRun() {}
 
   /** Gets a pointer to the underlying solver used in the MPC. */
   virtual SolverBase* getSolverPtr() = 0;
@@ -68,6 +68,12 @@ struct Settings {
    * set to a positive number which can be interpreted as the tracking controller's frequency.
    */
   scalar_t mrtDesiredFrequency_ = 100.0;
+
+  /**
+   * The wall-clock budget of each MPC call in seconds. The solver stops iterating when the remaining time does not suffice for
+   * another iteration and returns its best iterate so far. Any non-positive number lets the solver run until convergence.
+   */
+  scalar_t timeBudget_ = -1;
 };
 
 /**
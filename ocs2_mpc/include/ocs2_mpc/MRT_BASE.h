@@ -41,12 +41,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/reference/ModeSchedule.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_core/thread_support/TripleBuffer.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 #include <ocs2_oc/oc_solver/PerformanceIndex.h>
 #include <ocs2_oc/rollout/RolloutBase.h>
 
 #include "ocs2_mpc/CommandData.h"
 #include "ocs2_mpc/MrtObserver.h"
+#include "ocs2_mpc/PolicyEvaluator.h"
 #include "ocs2_mpc/SystemObservation.h"
 
 namespace ocs2 {
@@ -54,6 +56,9 @@ namespace ocs2 {
 /**
  * This class implements core MRT (Model Reference Tracking) functionality.
  * The responsibility of filling the buffer variables is left to the deriving classes.
+ *
+ * The policy is exchanged through a wait-free triple buffer: updatePolicy() never blocks and always loads the latest policy that was
+ * moved to the buffer.
  */
 class MRT_BASE {
  public:
@@ -64,7 +69,7 @@ class MRT_BASE {
   virtual ~MRT_BASE() = default;
 
   /**
-   * Resets the class to its instantiated state.
+   * Resets the class to its instantiated state. This method should not be called concurrently with updatePolicy().
    */
   void reset();
 
@@ -117,7 +122,8 @@ class MRT_BASE {
   void initRollout(const RolloutBase* rolloutPtr);
 
   /**
-   * @brief Evaluates the controller
+   * @brief Evaluates the controller. The evaluation does not allocate memory for the linear and feedforward controllers once the outputs
+   * have the right size, and is amortized O(1) for monotonically increasing query times.
    *
    * @param [in] currentTime: the query time.
    * @param [in] currentState: the query state.
@@ -143,7 +149,7 @@ class MRT_BASE {
   /**
    * Checks the data buffer for an update of the MPC policy. If a new policy
    * is available on the buffer this method will load it to the in-use policy.
-   * This method also calls the modifyActiveSolution() method.
+   * This method also calls the modifyActiveSolution() method. It is wait-free and does not allocate or release memory.
    *
    * @return True if the policy is updated.
    */
@@ -165,30 +171,30 @@ class MRT_BASE {
                     std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
 
  private:
-  /** Calls modifyActiveSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** The MPC output of a single policy update */
+  struct Policy {
+    std::unique_ptr<CommandData> commandPtr;
+    std::unique_ptr<PrimalSolution> primalSolutionPtr;
+    std::unique_ptr<PerformanceIndex> performanceIndicesPtr;
+  };
+
+  /** Calls modifyActiveSolution on all mrt observers. This function is called from updatePolicy on the active policy */
   void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution);
 
-  /** Calls modifyBufferedSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** Calls modifyBufferedSolution on all mrt observers. This function is called while holding the bufferMutex_ lock */
   void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer);
 
   // flags on state of the class
   std::atomic_bool policyReceivedEver_;
-  bool newPolicyInBuffer_;  // whether a new policy is waiting to be swapped in
 
   // variables related to the MPC output
-  std::unique_ptr<CommandData> activeCommandPtr_;
-  std::unique_ptr<CommandData> bufferCommandPtr_;
-  std::unique_ptr<PrimalSolution> activePrimalSolutionPtr_;
-  std::unique_ptr<PrimalSolution> bufferPrimalSolutionPtr_;
-  std::unique_ptr<PerformanceIndex> activePerformanceIndicesPtr_;
-  std::unique_ptr<PerformanceIndex> bufferPerformanceIndicesPtr_;
+  TripleBuffer<Policy> policyBuffer_;
 
   // thread safety
-  mutable std::mutex bufferMutex_;  // for policy variables with the prefix (buffer*)
-  const size_t mrtTrylockWarningThreshold_ = 5;
-  size_t mrtTrylockWarningCount_;
+  std::mutex bufferMutex_;  // serializes the writers of policyBuffer_ (moveToBuffer and reset). The reader never locks it.
 
   // variables needed for policy evaluation
+  PolicyEvaluator policyEvaluator_;  // bound to the active policy
   std::unique_ptr<RolloutBase> rolloutPtr_;
 
   std::vector<std::shared_ptr<MrtObserver>> observerPtrArray_;
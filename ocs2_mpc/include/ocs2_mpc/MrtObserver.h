@@ -46,7 +46,8 @@ namespace ocs2 {
  * When a user requests an update, the in-use policy is swapped for the buffered policy.
  *      - At this point the "modifyActiveSolution" of this class is called.
  *
- * Both filling of the buffer and the update swapping are protected by the same mutex.
+ * The buffer and the in-use policy are exchanged wait-free, so the two methods can be called concurrently from different threads on
+ * different policies. An observer which shares data between the two methods has to protect it itself.
  */
 class MrtObserver {
  public:
@@ -66,7 +67,7 @@ class MrtObserver {
    * This function is executed sequentially with updatePolicy and thus blocks the main thread. Computationally expensive modifications
    * should therefore rather be done in "modifyBufferedSolution".
    *
-   * A call to this function is protected by the same mutex as modifyBufferedSolution.
+   * A call to this function can run concurrently with modifyBufferedSolution.
    */
   virtual void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution) {}
 
@@ -76,7 +77,7 @@ class MrtObserver {
    *
    * When using a multi-threaded MRT, this function does not block the main thread.
    *
-   * A call to this function is protected by the same mutex as modifyActiveSolution.
+   * A call to this function can run concurrently with modifyActiveSolution.
    */
   virtual void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer) {}
 };
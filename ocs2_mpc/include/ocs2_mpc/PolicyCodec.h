@@ -0,0 +1,148 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+namespace ocs2 {
+namespace policy_codec {
+
+/** The numeric precision of the encoded trajectories and gains. */
+enum class Precision : uint8_t {
+  FLOAT64,  // lossless
+  FLOAT32,
+  FLOAT16,  // IEEE half precision, saturated to its largest finite value
+  INT8      // quantized with one float32 scale per vector or matrix
+};
+
+/**
+ * The settings of the policy encoder.
+ */
+struct Settings {
+  /** The precision of the state, input, and feedforward trajectories. */
+  Precision trajectoryPrecision = Precision::FLOAT32;
+
+  /** The precision of the feedback gains. */
+  Precision gainPrecision = Precision::FLOAT16;
+
+  /**
+   * Whether to encode a policy as its difference to the previously encoded policy, interpolated at the new time stamps. The
+   * difference of a node's vector or matrix is quantized with the same precision as the full values.
+   */
+  bool deltaEncoding = false;
+
+  /** In delta encoding, the vectors and matrices whose largest change does not exceed this tolerance are not sent. */
+  scalar_t deltaTolerance = 0.0;
+
+  /** In delta encoding, every keyframeInterval-th policy is encoded in full, so that a decoder recovers from lost messages. */
+  size_t keyframeInterval = 10;
+
+  /**
+   * The time window (in seconds) of the encoded policy, starting from its first time stamp. The policy is truncated one node
+   * beyond the window as in the solvers' getPrimalSolution(). Any negative number encodes the whole horizon. This is usually set
+   * to mpc::Settings::solutionTimeWindow_.
+   */
+  scalar_t timeWindow = -1.0;
+};
+
+}  // namespace policy_codec
+
+/**
+ * Decodes the policies encoded by PolicyEncoder. The decoder keeps the latest decoded policy as the reference for the next delta
+ * encoded policy.
+ */
+class PolicyDecoder {
+ public:
+  /**
+   * Decodes a policy.
+   *
+   * @param [in] message: The encoded policy.
+   * @param [out] primalSolution: The decoded policy.
+   * @return False if the message is a delta to a policy that was not decoded, e.g. because a message was lost. The decoder
+   * recovers with the next keyframe.
+   * @throw std::runtime_error if the message is malformed or has an unsupported version.
+   */
+  bool decode(const std::vector<uint8_t>& message, PrimalSolution& primalSolution);
+
+  /** Drops the reference policy. */
+  void reset() { hasReference_ = false; }
+
+ private:
+  PrimalSolution reference_;
+  uint32_t referenceSequence_ = 0;
+  bool hasReference_ = false;
+};
+
+/**
+ * Encodes an MPC policy into a compact, versioned binary message. It is an alternative to LinearController::flatten() for transports
+ * with a limited bandwidth. The encoder supports the linear and the feedforward controllers. The gains and the trajectories can be
+ * sent with reduced precision, and the policy can be encoded as its change to the previously encoded one.
+ *
+ * The time stamps, post-event indices, and the mode schedule are always encoded losslessly.
+ */
+class PolicyEncoder {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] settings: The settings of the encoder.
+   */
+  explicit PolicyEncoder(policy_codec::Settings settings);
+
+  /**
+   * Encodes a policy.
+   *
+   * @param [in] primalSolution: The policy.
+   * @param [out] message: The encoded policy.
+   * @throw std::runtime_error if the controller type is not supported or the state and input dimensions are not constant.
+   */
+  void encode(const PrimalSolution& primalSolution, std::vector<uint8_t>& message);
+
+  /** Resets the encoder. The next policy is encoded in full. */
+  void reset();
+
+  /** Gets the settings. */
+  const policy_codec::Settings& settings() const { return settings_; }
+
+ private:
+  const policy_codec::Settings settings_;
+  uint32_t sequence_ = 0;
+
+  // the decoded policies, the reference of the delta encoding
+  PolicyDecoder decoder_;
+  PrimalSolution decodedPolicy_;
+  bool hasReference_ = false;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,87 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+namespace ocs2 {
+
+/**
+ * Evaluates an MPC policy at the rate of the control loop. The time lookups start from the result of the previous query, so for
+ * monotonically increasing query times an evaluation is amortized O(1). The input and the nominal state are written into the given
+ * outputs, which does not allocate memory once they have the right size.
+ *
+ * The linear and the feedforward controllers are evaluated allocation-free. Other controller types are evaluated through
+ * ControllerBase::computeInput().
+ */
+class PolicyEvaluator {
+ public:
+  /**
+   * Sets the policy to be evaluated and resets the time cursors.
+   *
+   * @param [in] primalSolution: The policy. It should not be modified or destroyed while it is set.
+   */
+  void setPolicy(const PrimalSolution& primalSolution);
+
+  /** Removes the policy. */
+  void clear();
+
+  /** Whether a policy is set. */
+  bool isSet() const { return primalSolutionPtr_ != nullptr; }
+
+  /**
+   * Evaluates the policy.
+   *
+   * @param [in] time: The query time.
+   * @param [in] state: The query state.
+   * @param [out] input: The optimized control input.
+   * @param [out] nominalState: The nominal state of the policy.
+   * @param [out] mode: The active mode.
+   */
+  void evaluate(scalar_t time, const vector_t& state, vector_t& input, vector_t& nominalState, size_t& mode);
+
+ private:
+  void computeLinearControllerInput(scalar_t time, const vector_t& state, vector_t& input);
+  void computeFeedforwardControllerInput(scalar_t time, vector_t& input);
+
+  const PrimalSolution* primalSolutionPtr_ = nullptr;
+  const LinearController* linearControllerPtr_ = nullptr;
+  const FeedforwardController* feedforwardControllerPtr_ = nullptr;
+
+  // cursors into the time arrays
+  int stateTimeIndex_ = -1;
+  int controllerTimeIndex_ = -1;
+  int eventTimeIndex_ = -1;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,150 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+#include <ocs2_oc/oc_solver/PerformanceIndex.h>
+
+#include "ocs2_mpc/CommandData.h"
+
+namespace ocs2 {
+
+/**
+ * The capacities of a shared-memory policy channel. They fix the layout of the shared-memory segment.
+ */
+struct SharedMemoryPolicyLayout {
+  size_t stateDim = 0;
+  size_t inputDim = 0;
+  size_t maxNumNodes = 0;        // maximum length of the time, state, input, and controller trajectories
+  size_t maxNumEvents = 0;       // maximum number of event times and post-event indices
+  size_t maxNumTargetNodes = 0;  // maximum length of the target trajectories
+  size_t numSlots = 3;           // number of policy slots in the ring
+};
+
+/**
+ * The MPC side of a policy channel over POSIX shared memory. It creates a named segment with a fixed layout that holds a ring of
+ * policy slots. A policy is copied element-wise straight into the next slot, without any intermediate serialization, and is then
+ * published by incrementing a sequence counter. Only the linear and the feedforward controllers are supported.
+ *
+ * The segment is removed from the system when the writer is destroyed.
+ */
+class SharedMemoryPolicyWriter {
+ public:
+  /**
+   * Constructor. Creates the shared-memory segment, replacing any stale segment of the same name.
+   *
+   * @param [in] name: The name of the segment. It should start with a slash, e.g. "/ocs2_policy".
+   * @param [in] layout: The capacities of the channel.
+   */
+  SharedMemoryPolicyWriter(std::string name, const SharedMemoryPolicyLayout& layout);
+
+  /** Destructor. Unmaps and removes the segment. */
+  ~SharedMemoryPolicyWriter();
+
+  SharedMemoryPolicyWriter(const SharedMemoryPolicyWriter&) = delete;
+  SharedMemoryPolicyWriter& operator=(const SharedMemoryPolicyWriter&) = delete;
+
+  /**
+   * Writes a policy into the next slot and publishes it. The sizes of the policy should not exceed the capacities of the layout.
+   *
+   * @param [in] command: The MPC command data.
+   * @param [in] primalSolution: The MPC policy.
+   * @param [in] performanceIndices: The performance indices of the policy.
+   */
+  void write(const CommandData& command, const PrimalSolution& primalSolution, const PerformanceIndex& performanceIndices);
+
+  /** The number of published policies. */
+  uint64_t getSequence() const { return sequence_; }
+
+  /** The capacities of the channel. */
+  const SharedMemoryPolicyLayout& getLayout() const { return layout_; }
+
+ private:
+  std::string name_;
+  SharedMemoryPolicyLayout layout_;
+  size_t segmentSize_;
+  void* segmentPtr_;
+  uint64_t sequence_ = 0;
+};
+
+/**
+ * The MRT side of a policy channel over POSIX shared memory. It maps the segment of a SharedMemoryPolicyWriter read-only and copies
+ * the latest published policy out of its slot. The reader never blocks the writer: a slot which is overwritten while it is being
+ * read is detected by its sequence counter, and the read is repeated with the latest policy.
+ */
+class SharedMemoryPolicyReader {
+ public:
+  /**
+   * Constructor. Maps the segment of a writer. The layout is read from the segment.
+   *
+   * @param [in] name: The name of the segment.
+   * @throw std::runtime_error if the segment does not exist or has an incompatible version.
+   */
+  explicit SharedMemoryPolicyReader(const std::string& name);
+
+  /** Destructor. Unmaps the segment. */
+  ~SharedMemoryPolicyReader();
+
+  SharedMemoryPolicyReader(const SharedMemoryPolicyReader&) = delete;
+  SharedMemoryPolicyReader& operator=(const SharedMemoryPolicyReader&) = delete;
+
+  /** Whether a policy which has not been read yet is published. */
+  bool hasNewPolicy() const;
+
+  /**
+   * Reads the latest published policy if it has not been read yet. The outputs do not allocate memory once their sizes match the
+   * policy and the controller type does not change.
+   *
+   * @param [out] command: The MPC command data.
+   * @param [out] primalSolution: The MPC policy.
+   * @param [out] performanceIndices: The performance indices of the policy.
+   * @return True if a new policy is read.
+   */
+  bool read(CommandData& command, PrimalSolution& primalSolution, PerformanceIndex& performanceIndices);
+
+  /** The sequence number of the latest read policy. Zero if none is read. */
+  uint64_t getSequence() const { return sequence_; }
+
+  /** The capacities of the channel. */
+  const SharedMemoryPolicyLayout& getLayout() const { return layout_; }
+
+ private:
+  SharedMemoryPolicyLayout layout_;
+  size_t segmentSize_;
+  const void* segmentPtr_;
+  uint64_t sequence_ = 0;
+};
+
+}  // namespace ocs2
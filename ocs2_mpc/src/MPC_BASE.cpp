@@ -50,7 +50,7 @@ void MPC_BASE::reset() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
+bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState, scalar_t timeBudget) {
   // check if the current time exceeds the solver final limit
   if (!initRun_ && currentTime >= getSolverPtr()->getFinalTime()) {
     std::cerr << "WARNING: The MPC time-horizon is smaller than the MPC starting time.\n";
@@ -72,6 +72,7 @@ bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
   }
 
   // calculate the MPC policy
+  getSolverPtr()->setTimeBudget(timeBudget);
   calculateController(currentTime, currentState, finalTime);
 
   // set initRun flag to false
@@ -84,6 +85,13 @@ bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
     std::cerr << "\n###   Maximum : " << mpcTimer_.getMaxIntervalInMilliseconds() << "[ms].";
     std::cerr << "\n###   Average : " << mpcTimer_.getAverageInMilliseconds() << "[ms].";
     std::cerr << "\n###   Latest  : " << mpcTimer_.getLastIntervalInMilliseconds() << "[ms]." << std::endl;
+    if (timeBudget > 0.0) {
+      std::cerr << "### Time Budget : " << 1e3 * timeBudget << "[ms].";
+      for (const auto& phase : getSolverPtr()->getTimeBudget().getPhaseDurations()) {
+        std::cerr << "\n###   " << phase.first << " : " << 1e3 * phase.second << "[ms].";
+      }
+      std::cerr << std::endl;
+    }
   }
 
   return true;
@@ -110,6 +110,9 @@ void MPC_MRT_Interface::advanceMpc() {
     std::cerr << "\n###   Average : " << mpcTimer_.getAverageInMilliseconds() << "[ms].";
     std::cerr << "\n###   Latest  : " << mpcTimer_.getLastIntervalInMilliseconds() << "[ms]." << std::endl;
   }
+
+  // use the time until the next observation to prepare the next run
+  mpc_.prepareNextRun();
 }
 
 /******************************************************************************************************/
@@ -57,6 +57,8 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.mpcDesiredFrequency_, fieldName + ".mpcDesiredFrequency", verbose);
   loadData::loadPtreeValue(pt, settings.mrtDesiredFrequency_, fieldName + ".mrtDesiredFrequency", verbose);
 
+  loadData::loadPtreeValue(pt, settings.timeBudget_, fieldName + ".timeBudget", verbose);
+
   if (verbose) {
     std::cerr << " #### =============================================================================" << std::endl;
   }
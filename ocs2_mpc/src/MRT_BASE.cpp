@@ -47,23 +47,16 @@ void MRT_BASE::reset() {
   std::lock_guard<std::mutex> lock(bufferMutex_);
 
   policyReceivedEver_ = false;
-  newPolicyInBuffer_ = false;
-  mrtTrylockWarningCount_ = 0;
-
-  activeCommandPtr_.reset();
-  bufferCommandPtr_.reset();
-  activePrimalSolutionPtr_.reset();
-  bufferPrimalSolutionPtr_.reset();
-  activePerformanceIndicesPtr_.reset();
-  bufferPerformanceIndicesPtr_.reset();
+  policyEvaluator_.clear();
+  policyBuffer_.reset();
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 const CommandData& MRT_BASE::getCommand() const {
-  if (activeCommandPtr_ != nullptr) {
-    return *activeCommandPtr_;
+  if (policyBuffer_.get().commandPtr != nullptr) {
+    return *policyBuffer_.get().commandPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getCommand] updatePolicy() should be called first!");
   }
@@ -73,8 +66,8 @@ const CommandData& MRT_BASE::getCommand() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 const PrimalSolution& MRT_BASE::getPolicy() const {
-  if (activePrimalSolutionPtr_ != nullptr) {
-    return *activePrimalSolutionPtr_;
+  if (policyBuffer_.get().primalSolutionPtr != nullptr) {
+    return *policyBuffer_.get().primalSolutionPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getPolicy] updatePolicy() should be called first!");
   }
@@ -84,8 +77,8 @@ const PrimalSolution& MRT_BASE::getPolicy() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 const PerformanceIndex& MRT_BASE::getPerformanceIndices() const {
-  if (activePerformanceIndicesPtr_ != nullptr) {
-    return *activePerformanceIndicesPtr_;
+  if (policyBuffer_.get().performanceIndicesPtr != nullptr) {
+    return *policyBuffer_.get().performanceIndicesPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getPerformanceIndices] updatePolicy() should be called first!");
   }
@@ -102,20 +95,17 @@ void MRT_BASE::initRollout(const RolloutBase* rolloutPtr) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_BASE::evaluatePolicy(scalar_t currentTime, const vector_t& currentState, vector_t& mpcState, vector_t& mpcInput, size_t& mode) {
-  if (activePrimalSolutionPtr_ == nullptr) {
+  if (!policyEvaluator_.isSet()) {
     throw std::runtime_error("[MRT_BASE::evaluatePolicy] updatePolicy() should be called first!");
   }
 
-  if (currentTime > activePrimalSolutionPtr_->timeTrajectory_.back()) {
+  const auto& activePrimalSolution = *policyBuffer_.get().primalSolutionPtr;
+  if (currentTime > activePrimalSolution.timeTrajectory_.back()) {
     std::cerr << "The requested currentTime is greater than the received plan: " << std::to_string(currentTime) << ">"
-              << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
+              << std::to_string(activePrimalSolution.timeTrajectory_.back()) << "\n";
   }
 
-  mpcInput = activePrimalSolutionPtr_->controllerPtr_->computeInput(currentTime, currentState);
-  mpcState =
-      LinearInterpolation::interpolate(currentTime, activePrimalSolutionPtr_->timeTrajectory_, activePrimalSolutionPtr_->stateTrajectory_);
-
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(currentTime);
+  policyEvaluator_.evaluate(currentTime, currentState, mpcInput, mpcState, mode);
 }
 
 /******************************************************************************************************/
@@ -127,13 +117,14 @@ void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState,
     throw std::runtime_error("[MRT_BASE::rolloutPolicy] rollout class is not set! Use initRollout() to initialize it!");
   }
 
-  if (activePrimalSolutionPtr_ == nullptr) {
+  const auto& activePrimalSolutionPtr = policyBuffer_.get().primalSolutionPtr;
+  if (activePrimalSolutionPtr == nullptr) {
     throw std::runtime_error("[MRT_BASE::rolloutPolicy] updatePolicy() should be called first!");
   }
 
-  if (currentTime > activePrimalSolutionPtr_->timeTrajectory_.back()) {
+  if (currentTime > activePrimalSolutionPtr->timeTrajectory_.back()) {
     std::cerr << "The requested currentTime is greater than the received plan: " << std::to_string(currentTime) << ">"
-              << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
+              << std::to_string(activePrimalSolutionPtr->timeTrajectory_.back()) << "\n";
   }
 
   // perform a rollout
@@ -141,41 +132,27 @@ void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState,
   size_array_t postEventIndicesStock;
   vector_array_t stateTrajectory, inputTrajectory;
   const scalar_t finalTime = currentTime + timeStep;
-  rolloutPtr_->run(currentTime, currentState, finalTime, activePrimalSolutionPtr_->controllerPtr_.get(),
-                   activePrimalSolutionPtr_->modeSchedule_, timeTrajectory, postEventIndicesStock, stateTrajectory, inputTrajectory);
+  rolloutPtr_->run(currentTime, currentState, finalTime, activePrimalSolutionPtr->controllerPtr_.get(),
+                   activePrimalSolutionPtr->modeSchedule_, timeTrajectory, postEventIndicesStock, stateTrajectory, inputTrajectory);
 
   mpcState = stateTrajectory.back();
   mpcInput = inputTrajectory.back();
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(finalTime);
+  mode = activePrimalSolutionPtr->modeSchedule_.modeAtTime(finalTime);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 bool MRT_BASE::updatePolicy() {
-  std::unique_lock<std::mutex> lock(bufferMutex_, std::try_to_lock);
-  if (lock.owns_lock()) {
-    mrtTrylockWarningCount_ = 0;
-    if (newPolicyInBuffer_) {
-      // update the active solution from buffer
-      activeCommandPtr_.swap(bufferCommandPtr_);
-      activePrimalSolutionPtr_.swap(bufferPrimalSolutionPtr_);
-      activePerformanceIndicesPtr_.swap(bufferPerformanceIndicesPtr_);
-      newPolicyInBuffer_ = false;  // make sure we don't swap in the old policy again
-
-      modifyActiveSolution(*activeCommandPtr_, *activePrimalSolutionPtr_);
-      return true;
-    } else {
-      return false;  // No policy update: the buffer contains nothing new.
-    }
+  // the previous active policy is handed back to the writer, so it is released on the MPC side
+  if (policyBuffer_.updateFromBuffer()) {
+    auto& activePolicy = policyBuffer_.get();
+    modifyActiveSolution(*activePolicy.commandPtr, *activePolicy.primalSolutionPtr);
+    policyEvaluator_.setPolicy(*activePolicy.primalSolutionPtr);
+    return true;
   } else {
-    ++mrtTrylockWarningCount_;
-    if (mrtTrylockWarningCount_ > mrtTrylockWarningThreshold_) {
-      std::cerr << "[MRT_BASE::updatePolicy] failed to lock the policyBufferMutex for " << mrtTrylockWarningCount_
-                << " consecutive times.\n";
-    }
-    return false;  // No policy update: the lock could not be acquired.
+    return false;  // No policy update: the buffer contains nothing new.
   }
 }
 
@@ -198,14 +175,16 @@ void MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::un
 
   std::lock_guard<std::mutex> lk(bufferMutex_);
   // use swap such that the old objects are destroyed after releasing the lock.
-  bufferCommandPtr_.swap(commandDataPtr);
-  bufferPrimalSolutionPtr_.swap(primalSolutionPtr);
-  bufferPerformanceIndicesPtr_.swap(performanceIndicesPtr);
+  auto& bufferPolicy = policyBuffer_.getBuffer();
+  bufferPolicy.commandPtr.swap(commandDataPtr);
+  bufferPolicy.primalSolutionPtr.swap(primalSolutionPtr);
+  bufferPolicy.performanceIndicesPtr.swap(performanceIndicesPtr);
 
   // allow user to modify the buffer
-  modifyBufferedSolution(*bufferCommandPtr_, *bufferPrimalSolutionPtr_);
+  modifyBufferedSolution(*bufferPolicy.commandPtr, *bufferPolicy.primalSolutionPtr);
 
-  newPolicyInBuffer_ = true;
+  // hand the buffer over to updatePolicy()
+  policyBuffer_.publishBuffer();
   policyReceivedEver_ = true;
 }
 
@@ -0,0 +1,606 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/PolicyCodec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+namespace ocs2 {
+
+namespace {
+
+using policy_codec::Precision;
+
+constexpr uint32_t MAGIC = 0x4c4f5050;  // "PPOL"
+constexpr uint8_t VERSION = 1;
+constexpr uint8_t DELTA_FLAG = 0x1;                  // the policy is encoded relative to the reference
+constexpr uint8_t SHARED_CONTROLLER_TIME_FLAG = 0x2;  // the controller time stamps are the time trajectory
+
+/** Converts to IEEE half precision with round to nearest even. Finite values beyond the half range saturate. */
+uint16_t floatToHalf(float value) {
+  uint32_t f;
+  std::memcpy(&f, &value, sizeof(f));
+  const auto sign = static_cast<uint16_t>((f >> 16) & 0x8000);
+  f &= 0x7fffffff;
+
+  if (f >= 0x7f800000) {  // infinity or NaN
+    return sign | 0x7c00 | (f > 0x7f800000 ? 0x0200 : 0);
+  } else if (f >= 0x477ff000) {  // rounds beyond the largest finite half
+    return sign | 0x7bff;
+  } else if (f < 0x33000000) {  // rounds to zero
+    return sign;
+  }
+
+  uint32_t half;
+  uint32_t remainder;
+  uint32_t halfway;
+  if (f < 0x38800000) {  // subnormal half
+    const uint32_t mantissa = (f & 0x007fffff) | 0x00800000;
+    const uint32_t shift = 126 - (f >> 23);
+    half = mantissa >> shift;
+    remainder = mantissa & ((1u << shift) - 1);
+    halfway = 1u << (shift - 1);
+  } else {  // normal half
+    half = (f >> 13) - (112u << 10);
+    remainder = f & 0x1fff;
+    halfway = 0x1000;
+  }
+  if (remainder > halfway || (remainder == halfway && (half & 1) != 0)) {
+    ++half;
+  }
+  return sign | static_cast<uint16_t>(half);
+}
+
+/** Converts from IEEE half precision. */
+float halfToFloat(uint16_t half) {
+  const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+  const uint32_t exponent = (half >> 10) & 0x1f;
+  const uint32_t mantissa = half & 0x03ff;
+
+  if (exponent == 0) {  // zero or subnormal
+    const float value = std::ldexp(static_cast<float>(mantissa), -24);
+    return sign != 0 ? -value : value;
+  }
+  const uint32_t f = (exponent == 0x1f) ? (sign | 0x7f800000 | (mantissa << 13)) : (sign | ((exponent + 112) << 23) | (mantissa << 13));
+  float value;
+  std::memcpy(&value, &f, sizeof(value));
+  return value;
+}
+
+/** Appends plain data to a message. */
+class ByteWriter {
+ public:
+  explicit ByteWriter(std::vector<uint8_t>& message) : message_(message) { message_.clear(); }
+
+  template <typename T>
+  void write(T value) {
+    const auto size = message_.size();
+    message_.resize(size + sizeof(T));
+    std::memcpy(message_.data() + size, &value, sizeof(T));
+  }
+
+ private:
+  std::vector<uint8_t>& message_;
+};
+
+/** Reads plain data from a message. */
+class ByteReader {
+ public:
+  explicit ByteReader(const std::vector<uint8_t>& message) : ptr_(message.data()), end_(message.data() + message.size()) {}
+
+  template <typename T>
+  T read() {
+    checkRemaining(sizeof(T));
+    T value;
+    std::memcpy(&value, ptr_, sizeof(T));
+    ptr_ += sizeof(T);
+    return value;
+  }
+
+  bool isAtEnd() const { return ptr_ == end_; }
+
+  size_t getRemaining() const { return static_cast<size_t>(end_ - ptr_); }
+
+  /** Checks that the message holds at least the given number of bytes, before they are allocated. */
+  void checkRemaining(size_t numBytes) const {
+    if (getRemaining() < numBytes) {
+      throw std::runtime_error("[PolicyDecoder] The message is truncated.");
+    }
+  }
+
+ private:
+  const uint8_t* ptr_;
+  const uint8_t* end_;
+};
+
+/** Writes the coefficients of a vector or matrix with the given precision. */
+void writeBlock(ByteWriter& writer, Precision precision, const scalar_t* data, size_t size) {
+  switch (precision) {
+    case Precision::FLOAT64:
+      for (size_t i = 0; i < size; i++) {
+        writer.write<double>(data[i]);
+      }
+      break;
+    case Precision::FLOAT32:
+      for (size_t i = 0; i < size; i++) {
+        writer.write<float>(static_cast<float>(data[i]));
+      }
+      break;
+    case Precision::FLOAT16:
+      for (size_t i = 0; i < size; i++) {
+        writer.write<uint16_t>(floatToHalf(static_cast<float>(data[i])));
+      }
+      break;
+    case Precision::INT8: {
+      scalar_t maxAbs = 0.0;
+      for (size_t i = 0; i < size; i++) {
+        maxAbs = std::max(maxAbs, std::abs(data[i]));
+      }
+      const auto scale = static_cast<float>(maxAbs / 127.0);
+      writer.write<float>(scale);
+      for (size_t i = 0; i < size; i++) {
+        writer.write<int8_t>(scale > 0.0f ? static_cast<int8_t>(std::lround(data[i] / scale)) : 0);
+      }
+      break;
+    }
+  }
+}
+
+/** Reads the coefficients of a vector or matrix with the given precision. */
+void readBlock(ByteReader& reader, Precision precision, scalar_t* data, size_t size) {
+  switch (precision) {
+    case Precision::FLOAT64:
+      for (size_t i = 0; i < size; i++) {
+        data[i] = reader.read<double>();
+      }
+      break;
+    case Precision::FLOAT32:
+      for (size_t i = 0; i < size; i++) {
+        data[i] = reader.read<float>();
+      }
+      break;
+    case Precision::FLOAT16:
+      for (size_t i = 0; i < size; i++) {
+        data[i] = halfToFloat(reader.read<uint16_t>());
+      }
+      break;
+    case Precision::INT8: {
+      const auto scale = static_cast<scalar_t>(reader.read<float>());
+      for (size_t i = 0; i < size; i++) {
+        data[i] = scale * reader.read<int8_t>();
+      }
+      break;
+    }
+  }
+}
+
+/** Checks that the message holds numBlocks blocks of rows x cols coefficients with the given precision, before they are allocated. */
+void checkBlocks(const ByteReader& reader, Precision precision, size_t numBlocks, Eigen::Index rows, Eigen::Index cols) {
+  if (numBlocks == 0 || rows == 0 || cols == 0) {
+    return;
+  }
+  // every coefficient takes at least one byte, which also bounds the block size below against overflow
+  const size_t remaining = reader.getRemaining();
+  if (static_cast<size_t>(rows) > remaining / static_cast<size_t>(cols)) {
+    throw std::runtime_error("[PolicyDecoder] The message is truncated.");
+  }
+  const auto blockSize = static_cast<size_t>(rows * cols);
+  size_t blockBytes = 0;
+  switch (precision) {
+    case Precision::FLOAT64:
+      blockBytes = blockSize * sizeof(double);
+      break;
+    case Precision::FLOAT32:
+      blockBytes = blockSize * sizeof(float);
+      break;
+    case Precision::FLOAT16:
+      blockBytes = blockSize * sizeof(uint16_t);
+      break;
+    case Precision::INT8:
+      blockBytes = sizeof(float) + blockSize * sizeof(int8_t);
+      break;
+  }
+  if (numBlocks > remaining / blockBytes) {
+    throw std::runtime_error("[PolicyDecoder] The message is truncated.");
+  }
+}
+
+/** The previously encoded array which a delta encoded array refers to. */
+template <typename Array>
+struct Reference {
+  const scalar_array_t* timeArrayPtr;
+  const Array* dataArrayPtr;
+};
+
+/** Writes the first length entries of an array, either in full or as the difference to the reference. */
+template <typename Array>
+void encodeArray(ByteWriter& writer, Precision precision, const scalar_array_t& timeArray, const Array& dataArray, size_t length,
+                 const Reference<Array>* referencePtr, scalar_t tolerance) {
+  typename Array::value_type difference;
+  int index = -1;
+  for (size_t k = 0; k < length; k++) {
+    if (referencePtr == nullptr) {
+      writeBlock(writer, precision, dataArray[k].data(), dataArray[k].size());
+    } else {
+      const auto indexAlpha = LinearInterpolation::timeSegment(timeArray[k], *referencePtr->timeArrayPtr, index);
+      difference = dataArray[k] - LinearInterpolation::interpolate(indexAlpha, *referencePtr->dataArrayPtr);
+      if (difference.size() == 0 || difference.cwiseAbs().maxCoeff() <= tolerance) {
+        writer.write<uint8_t>(0);
+      } else {
+        writer.write<uint8_t>(1);
+        writeBlock(writer, precision, difference.data(), difference.size());
+      }
+    }
+  }
+}
+
+/** Reads an array of the given length which was written by encodeArray. */
+template <typename Array>
+void decodeArray(ByteReader& reader, Precision precision, const scalar_array_t& timeArray, size_t length, Eigen::Index rows,
+                 Eigen::Index cols, const Reference<Array>* referencePtr, Array& dataArray) {
+  if (referencePtr == nullptr) {
+    checkBlocks(reader, precision, length, rows, cols);
+  } else {
+    // every entry takes at least its flag byte, and is interpolated from the reference
+    reader.checkRemaining(length);
+    if (length > 0 && referencePtr->dataArrayPtr->empty()) {
+      throw std::runtime_error("[PolicyDecoder] The reference policy is empty.");
+    }
+  }
+  typename Array::value_type difference;
+  dataArray.resize(length);
+  int index = -1;
+  for (size_t k = 0; k < length; k++) {
+    auto& value = dataArray[k];
+    if (referencePtr == nullptr) {
+      value.resize(rows, cols);
+      readBlock(reader, precision, value.data(), value.size());
+    } else {
+      const auto indexAlpha = LinearInterpolation::timeSegment(timeArray[k], *referencePtr->timeArrayPtr, index);
+      value = LinearInterpolation::interpolate(indexAlpha, *referencePtr->dataArrayPtr);
+      if (value.rows() != rows || value.cols() != cols) {
+        throw std::runtime_error("[PolicyDecoder] The reference policy has different dimensions.");
+      }
+      if (reader.read<uint8_t>() != 0) {
+        // the dimensions are the ones of the reference, hence the allocation is bounded
+        difference.resize(rows, cols);
+        readBlock(reader, precision, difference.data(), difference.size());
+        value += difference;
+      }
+    }
+  }
+}
+
+/** The number of nodes within the time window, including one node beyond it. */
+size_t getTruncatedLength(const scalar_array_t& timeArray, scalar_t finalTime) {
+  const auto length = static_cast<size_t>(std::distance(timeArray.cbegin(), std::upper_bound(timeArray.cbegin(), timeArray.cend(), finalTime)));
+  return std::min(length + 1, timeArray.size());
+}
+
+template <typename Array>
+bool hasSize(const Array& dataArray, size_t length, Eigen::Index rows, Eigen::Index cols) {
+  return dataArray.size() >= length &&
+         std::all_of(dataArray.begin(), dataArray.begin() + length, [&](const typename Array::value_type& v) {
+           return v.rows() == rows && v.cols() == cols;
+         });
+}
+
+Precision toPrecision(uint8_t value) {
+  if (value > static_cast<uint8_t>(Precision::INT8)) {
+    throw std::runtime_error("[PolicyDecoder] Unknown precision " + std::to_string(value) + ".");
+  }
+  return static_cast<Precision>(value);
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PolicyEncoder::PolicyEncoder(policy_codec::Settings settings) : settings_(std::move(settings)) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyEncoder::reset() {
+  sequence_ = 0;
+  decoder_.reset();
+  hasReference_ = false;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyEncoder::encode(const PrimalSolution& primalSolution, std::vector<uint8_t>& message) {
+  // controller data
+  if (primalSolution.controllerPtr_ == nullptr) {
+    throw std::runtime_error("[PolicyEncoder] The policy has no controller.");
+  }
+  const auto controllerType = primalSolution.controllerPtr_->getType();
+  const scalar_array_t* controllerTimePtr;
+  const vector_array_t* biasPtr;
+  const matrix_array_t* gainPtr = nullptr;
+  switch (controllerType) {
+    case ControllerType::LINEAR: {
+      const auto& controller = static_cast<const LinearController&>(*primalSolution.controllerPtr_);
+      controllerTimePtr = &controller.timeStamp_;
+      biasPtr = &controller.biasArray_;
+      gainPtr = &controller.gainArray_;
+      break;
+    }
+    case ControllerType::FEEDFORWARD: {
+      const auto& controller = static_cast<const FeedforwardController&>(*primalSolution.controllerPtr_);
+      controllerTimePtr = &controller.timeStamp_;
+      biasPtr = &controller.uffArray_;
+      break;
+    }
+    default:
+      throw std::runtime_error("[PolicyEncoder] Only the linear and the feedforward controllers are supported.");
+  }
+
+  // truncation to the time window
+  const auto& timeTrajectory = primalSolution.timeTrajectory_;
+  size_t N = timeTrajectory.size();
+  size_t controllerN = controllerTimePtr->size();
+  if (settings_.timeWindow >= 0.0 && !timeTrajectory.empty()) {
+    const scalar_t finalTime = timeTrajectory.front() + settings_.timeWindow;
+    N = getTruncatedLength(timeTrajectory, finalTime);
+    controllerN = getTruncatedLength(*controllerTimePtr, finalTime);
+  }
+  const auto numPostEventIndices = static_cast<size_t>(std::distance(
+      primalSolution.postEventIndices_.cbegin(),
+      std::lower_bound(primalSolution.postEventIndices_.cbegin(), primalSolution.postEventIndices_.cend(), N)));
+  const auto& modeSchedule = primalSolution.modeSchedule_;
+
+  // dimensions
+  const Eigen::Index nx = (N > 0) ? primalSolution.stateTrajectory_.front().size() : 0;
+  const Eigen::Index nu = (controllerN > 0) ? biasPtr->front().size() : (N > 0) ? primalSolution.inputTrajectory_.front().size() : 0;
+  if (!hasSize(primalSolution.stateTrajectory_, N, nx, 1) || !hasSize(primalSolution.inputTrajectory_, N, nu, 1) ||
+      !hasSize(*biasPtr, controllerN, nu, 1) || (gainPtr != nullptr && !hasSize(*gainPtr, controllerN, nu, nx))) {
+    throw std::runtime_error("[PolicyEncoder] The state and input dimensions of the policy should be constant.");
+  }
+  const bool isControllerTimeShared =
+      controllerN == N && std::equal(timeTrajectory.begin(), timeTrajectory.begin() + N, controllerTimePtr->begin());
+
+  // delta encoding is used if the reference is compatible
+  ++sequence_;
+  const bool isKeyframe = settings_.keyframeInterval <= 1 || (sequence_ - 1) % settings_.keyframeInterval == 0;
+  bool isDelta = settings_.deltaEncoding && hasReference_ && !isKeyframe;
+  const LinearController* referenceLinearPtr = nullptr;
+  const FeedforwardController* referenceFeedforwardPtr = nullptr;
+  if (isDelta) {
+    const auto& reference = decodedPolicy_;
+    const auto referenceN = reference.timeTrajectory_.size();
+    if (reference.controllerPtr_->getType() == ControllerType::LINEAR) {
+      referenceLinearPtr = static_cast<const LinearController*>(reference.controllerPtr_.get());
+    } else {
+      referenceFeedforwardPtr = static_cast<const FeedforwardController*>(reference.controllerPtr_.get());
+    }
+    const auto* referenceTimePtr = referenceLinearPtr != nullptr ? &referenceLinearPtr->timeStamp_ : &referenceFeedforwardPtr->timeStamp_;
+    isDelta = reference.controllerPtr_->getType() == controllerType && referenceN > 0 && !referenceTimePtr->empty() &&
+              reference.stateTrajectory_.front().size() == nx && reference.inputTrajectory_.front().size() == nu;
+  }
+
+  // header
+  ByteWriter writer(message);
+  writer.write<uint32_t>(MAGIC);
+  writer.write<uint8_t>(VERSION);
+  writer.write<uint8_t>((isDelta ? DELTA_FLAG : 0) | (isControllerTimeShared ? SHARED_CONTROLLER_TIME_FLAG : 0));
+  writer.write<uint8_t>(static_cast<uint8_t>(controllerType));
+  writer.write<uint8_t>(static_cast<uint8_t>(settings_.trajectoryPrecision));
+  writer.write<uint8_t>(static_cast<uint8_t>(settings_.gainPrecision));
+  writer.write<uint32_t>(sequence_);
+  writer.write<uint32_t>(sequence_ - 1);  // the reference of a delta
+  writer.write<uint32_t>(static_cast<uint32_t>(nx));
+  writer.write<uint32_t>(static_cast<uint32_t>(nu));
+  writer.write<uint32_t>(static_cast<uint32_t>(N));
+  writer.write<uint32_t>(static_cast<uint32_t>(controllerN));
+  writer.write<uint32_t>(static_cast<uint32_t>(numPostEventIndices));
+  writer.write<uint32_t>(static_cast<uint32_t>(modeSchedule.eventTimes.size()));
+  writer.write<uint32_t>(static_cast<uint32_t>(modeSchedule.modeSequence.size()));
+
+  // lossless data
+  for (size_t k = 0; k < N; k++) {
+    writer.write<double>(timeTrajectory[k]);
+  }
+  if (!isControllerTimeShared) {
+    for (size_t k = 0; k < controllerN; k++) {
+      writer.write<double>((*controllerTimePtr)[k]);
+    }
+  }
+  for (size_t k = 0; k < numPostEventIndices; k++) {
+    writer.write<uint32_t>(static_cast<uint32_t>(primalSolution.postEventIndices_[k]));
+  }
+  for (const auto eventTime : modeSchedule.eventTimes) {
+    writer.write<double>(eventTime);
+  }
+  for (const auto mode : modeSchedule.modeSequence) {
+    writer.write<uint32_t>(static_cast<uint32_t>(mode));
+  }
+
+  // trajectories and controller
+  const auto& tolerance = settings_.deltaTolerance;
+  const auto& trajectoryPrecision = settings_.trajectoryPrecision;
+  Reference<vector_array_t> stateReference{&decodedPolicy_.timeTrajectory_, &decodedPolicy_.stateTrajectory_};
+  Reference<vector_array_t> inputReference{&decodedPolicy_.timeTrajectory_, &decodedPolicy_.inputTrajectory_};
+  encodeArray(writer, trajectoryPrecision, timeTrajectory, primalSolution.stateTrajectory_, N, isDelta ? &stateReference : nullptr,
+              tolerance);
+  encodeArray(writer, trajectoryPrecision, timeTrajectory, primalSolution.inputTrajectory_, N, isDelta ? &inputReference : nullptr,
+              tolerance);
+  if (controllerType == ControllerType::LINEAR) {
+    Reference<vector_array_t> biasReference{nullptr, nullptr};
+    Reference<matrix_array_t> gainReference{nullptr, nullptr};
+    if (isDelta) {
+      biasReference = {&referenceLinearPtr->timeStamp_, &referenceLinearPtr->biasArray_};
+      gainReference = {&referenceLinearPtr->timeStamp_, &referenceLinearPtr->gainArray_};
+    }
+    encodeArray(writer, trajectoryPrecision, *controllerTimePtr, *biasPtr, controllerN, isDelta ? &biasReference : nullptr, tolerance);
+    encodeArray(writer, settings_.gainPrecision, *controllerTimePtr, *gainPtr, controllerN, isDelta ? &gainReference : nullptr, tolerance);
+  } else {
+    Reference<vector_array_t> feedforwardReference{nullptr, nullptr};
+    if (isDelta) {
+      feedforwardReference = {&referenceFeedforwardPtr->timeStamp_, &referenceFeedforwardPtr->uffArray_};
+    }
+    encodeArray(writer, trajectoryPrecision, *controllerTimePtr, *biasPtr, controllerN, isDelta ? &feedforwardReference : nullptr,
+                tolerance);
+  }
+
+  // the decoded policy is the reference of the next delta, such that the quantization errors do not accumulate
+  if (settings_.deltaEncoding) {
+    hasReference_ = decoder_.decode(message, decodedPolicy_);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool PolicyDecoder::decode(const std::vector<uint8_t>& message, PrimalSolution& primalSolution) {
+  ByteReader reader(message);
+  if (reader.read<uint32_t>() != MAGIC) {
+    throw std::runtime_error("[PolicyDecoder] The message is not an encoded policy.");
+  }
+  const auto version = reader.read<uint8_t>();
+  if (version != VERSION) {
+    throw std::runtime_error("[PolicyDecoder] Unsupported version " + std::to_string(version) + ".");
+  }
+  const auto flags = reader.read<uint8_t>();
+  const auto controllerType = static_cast<ControllerType>(reader.read<uint8_t>());
+  const auto trajectoryPrecision = toPrecision(reader.read<uint8_t>());
+  const auto gainPrecision = toPrecision(reader.read<uint8_t>());
+  const auto sequence = reader.read<uint32_t>();
+  const auto referenceSequence = reader.read<uint32_t>();
+  const Eigen::Index nx = reader.read<uint32_t>();
+  const Eigen::Index nu = reader.read<uint32_t>();
+  const size_t N = reader.read<uint32_t>();
+  const size_t controllerN = reader.read<uint32_t>();
+  const size_t numPostEventIndices = reader.read<uint32_t>();
+  const size_t numEventTimes = reader.read<uint32_t>();
+  const size_t numModes = reader.read<uint32_t>();
+  if (controllerType != ControllerType::LINEAR && controllerType != ControllerType::FEEDFORWARD) {
+    throw std::runtime_error("[PolicyDecoder] Unknown controller type.");
+  }
+
+  // a delta can only be decoded with its reference
+  const bool isDelta = (flags & DELTA_FLAG) != 0;
+  if (isDelta && (!hasReference_ || referenceSequence != referenceSequence_)) {
+    return false;
+  }
+  if (isDelta && reference_.controllerPtr_->getType() != controllerType) {
+    throw std::runtime_error("[PolicyDecoder] The reference policy has a different controller type.");
+  }
+
+  // lossless data
+  reader.checkRemaining(N * sizeof(double) + numPostEventIndices * sizeof(uint32_t) + numEventTimes * sizeof(double) +
+                        numModes * sizeof(uint32_t));
+  PrimalSolution decoded;
+  decoded.timeTrajectory_.resize(N);
+  for (auto& t : decoded.timeTrajectory_) {
+    t = reader.read<double>();
+  }
+  scalar_array_t controllerTime;
+  if ((flags & SHARED_CONTROLLER_TIME_FLAG) != 0) {
+    if (controllerN != N) {
+      throw std::runtime_error("[PolicyDecoder] The controller shares the time trajectory but has a different length.");
+    }
+    controllerTime = decoded.timeTrajectory_;
+  } else {
+    reader.checkRemaining(controllerN * sizeof(double));
+    controllerTime.resize(controllerN);
+    for (auto& t : controllerTime) {
+      t = reader.read<double>();
+    }
+  }
+  decoded.postEventIndices_.resize(numPostEventIndices);
+  for (auto& index : decoded.postEventIndices_) {
+    index = reader.read<uint32_t>();
+  }
+  decoded.modeSchedule_.eventTimes.resize(numEventTimes);
+  for (auto& eventTime : decoded.modeSchedule_.eventTimes) {
+    eventTime = reader.read<double>();
+  }
+  decoded.modeSchedule_.modeSequence.resize(numModes);
+  for (auto& mode : decoded.modeSchedule_.modeSequence) {
+    mode = reader.read<uint32_t>();
+  }
+
+  // trajectories and controller
+  Reference<vector_array_t> stateReference{&reference_.timeTrajectory_, &reference_.stateTrajectory_};
+  Reference<vector_array_t> inputReference{&reference_.timeTrajectory_, &reference_.inputTrajectory_};
+  decodeArray(reader, trajectoryPrecision, decoded.timeTrajectory_, N, nx, 1, isDelta ? &stateReference : nullptr,
+              decoded.stateTrajectory_);
+  decodeArray(reader, trajectoryPrecision, decoded.timeTrajectory_, N, nu, 1, isDelta ? &inputReference : nullptr,
+              decoded.inputTrajectory_);
+  if (controllerType == ControllerType::LINEAR) {
+    std::unique_ptr<LinearController> controllerPtr(new LinearController);
+    Reference<vector_array_t> biasReference{nullptr, nullptr};
+    Reference<matrix_array_t> gainReference{nullptr, nullptr};
+    if (isDelta) {
+      const auto& referenceController = static_cast<const LinearController&>(*reference_.controllerPtr_);
+      biasReference = {&referenceController.timeStamp_, &referenceController.biasArray_};
+      gainReference = {&referenceController.timeStamp_, &referenceController.gainArray_};
+    }
+    decodeArray(reader, trajectoryPrecision, controllerTime, controllerN, nu, 1, isDelta ? &biasReference : nullptr,
+                controllerPtr->biasArray_);
+    decodeArray(reader, gainPrecision, controllerTime, controllerN, nu, nx, isDelta ? &gainReference : nullptr, controllerPtr->gainArray_);
+    controllerPtr->timeStamp_ = std::move(controllerTime);
+    decoded.controllerPtr_ = std::move(controllerPtr);
+  } else {
+    std::unique_ptr<FeedforwardController> controllerPtr(new FeedforwardController);
+    Reference<vector_array_t> feedforwardReference{nullptr, nullptr};
+    if (isDelta) {
+      const auto& referenceController = static_cast<const FeedforwardController&>(*reference_.controllerPtr_);
+      feedforwardReference = {&referenceController.timeStamp_, &referenceController.uffArray_};
+    }
+    decodeArray(reader, trajectoryPrecision, controllerTime, controllerN, nu, 1, isDelta ? &feedforwardReference : nullptr,
+                controllerPtr->uffArray_);
+    controllerPtr->timeStamp_ = std::move(controllerTime);
+    decoded.controllerPtr_ = std::move(controllerPtr);
+  }
+
+  if (!reader.isAtEnd()) {
+    throw std::runtime_error("[PolicyDecoder] The message has trailing data.");
+  }
+
+  // the decoded policy is the reference of the next delta
+  reference_ = decoded;
+  referenceSequence_ = sequence;
+  hasReference_ = true;
+  primalSolution = std::move(decoded);
+  return true;
+}
+
+}  // namespace ocs2
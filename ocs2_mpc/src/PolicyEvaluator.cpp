@@ -0,0 +1,151 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/PolicyEvaluator.h"
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_core/misc/Lookup.h>
+
+namespace ocs2 {
+
+namespace {
+
+/** Interpolates in place, dst = alpha * data[index] + (1 - alpha) * data[index + 1], see LinearInterpolation::interpolate. */
+void interpolateInPlace(const LinearInterpolation::index_alpha_t& indexAlpha, const vector_array_t& dataArray, vector_t& dst) {
+  if (dataArray.empty()) {
+    dst.setZero(0);
+  } else if (dataArray.size() == 1) {
+    dst = dataArray.front();
+  } else {
+    const auto index = indexAlpha.first;
+    const auto alpha = indexAlpha.second;
+    const auto& lhs = dataArray[index];
+    const auto& rhs = dataArray[index + 1];
+    if (lhs.size() == rhs.size()) {
+      dst = alpha * lhs + (scalar_t(1.0) - alpha) * rhs;
+    } else {
+      dst = (alpha > 0.5) ? lhs : rhs;
+    }
+  }
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyEvaluator::setPolicy(const PrimalSolution& primalSolution) {
+  primalSolutionPtr_ = &primalSolution;
+
+  const auto controllerPtr = primalSolution.controllerPtr_.get();
+  const auto controllerType = (controllerPtr != nullptr) ? controllerPtr->getType() : ControllerType::UNKNOWN;
+  linearControllerPtr_ = (controllerType == ControllerType::LINEAR) ? static_cast<const LinearController*>(controllerPtr) : nullptr;
+  feedforwardControllerPtr_ =
+      (controllerType == ControllerType::FEEDFORWARD) ? static_cast<const FeedforwardController*>(controllerPtr) : nullptr;
+
+  stateTimeIndex_ = -1;
+  controllerTimeIndex_ = -1;
+  eventTimeIndex_ = -1;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyEvaluator::clear() {
+  primalSolutionPtr_ = nullptr;
+  linearControllerPtr_ = nullptr;
+  feedforwardControllerPtr_ = nullptr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyEvaluator::evaluate(scalar_t time, const vector_t& state, vector_t& input, vector_t& nominalState, size_t& mode) {
+  if (primalSolutionPtr_ == nullptr) {
+    throw std::runtime_error("[PolicyEvaluator::evaluate] setPolicy() should be called first!");
+  }
+
+  // input
+  if (linearControllerPtr_ != nullptr) {
+    computeLinearControllerInput(time, state, input);
+  } else if (feedforwardControllerPtr_ != nullptr) {
+    computeFeedforwardControllerInput(time, input);
+  } else {
+    input = primalSolutionPtr_->controllerPtr_->computeInput(time, state);
+  }
+
+  // nominal state
+  const auto indexAlpha = LinearInterpolation::timeSegment(time, primalSolutionPtr_->timeTrajectory_, stateTimeIndex_);
+  interpolateInPlace(indexAlpha, primalSolutionPtr_->stateTrajectory_, nominalState);
+
+  // mode
+  const auto& modeSchedule = primalSolutionPtr_->modeSchedule_;
+  eventTimeIndex_ = lookup::findIndexInTimeArray(modeSchedule.eventTimes, time, eventTimeIndex_);
+  mode = modeSchedule.modeSequence[eventTimeIndex_];
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyEvaluator::computeLinearControllerInput(scalar_t time, const vector_t& state, vector_t& input) {
+  const auto& biasArray = linearControllerPtr_->biasArray_;
+  const auto& gainArray = linearControllerPtr_->gainArray_;
+  const auto indexAlpha = LinearInterpolation::timeSegment(time, linearControllerPtr_->timeStamp_, controllerTimeIndex_);
+
+  // u = alpha * (uff[i] + K[i] * x) + (1 - alpha) * (uff[i+1] + K[i+1] * x), which avoids interpolating the gain matrix
+  interpolateInPlace(indexAlpha, biasArray, input);
+  if (gainArray.size() == 1) {
+    input.noalias() += gainArray.front() * state;
+  } else if (gainArray.size() > 1) {
+    const auto index = indexAlpha.first;
+    const auto alpha = indexAlpha.second;
+    const auto& lhs = gainArray[index];
+    const auto& rhs = gainArray[index + 1];
+    if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols()) {
+      input.noalias() += (alpha > 0.5 ? lhs : rhs) * state;
+    } else {
+      if (alpha > 0.0) {
+        input.noalias() += alpha * lhs * state;
+      }
+      if (alpha < 1.0) {
+        input.noalias() += (scalar_t(1.0) - alpha) * rhs * state;
+      }
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyEvaluator::computeFeedforwardControllerInput(scalar_t time, vector_t& input) {
+  const auto indexAlpha = LinearInterpolation::timeSegment(time, feedforwardControllerPtr_->timeStamp_, controllerTimeIndex_);
+  interpolateInPlace(indexAlpha, feedforwardControllerPtr_->uffArray_, input);
+}
+
+}  // namespace ocs2
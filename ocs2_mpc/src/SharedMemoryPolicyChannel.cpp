@@ -0,0 +1,518 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/SharedMemoryPolicyChannel.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+
+namespace ocs2 {
+
+namespace {
+
+constexpr uint64_t MAGIC = 0x4f4353325f504f4cULL;  // "OCS2_POL"
+constexpr uint64_t VERSION = 1;
+constexpr size_t ALIGNMENT = 64;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "The shared-memory policy channel requires lock-free 64 bit atomics.");
+static_assert(sizeof(scalar_t) == sizeof(uint64_t), "All elements of a policy slot are 8 bytes.");
+static_assert(std::is_trivially_copyable<PerformanceIndex>::value, "PerformanceIndex is copied as raw memory.");
+
+/** The header of the shared-memory segment. The writer sets the magic number last, once the segment is initialized. */
+struct SegmentHeader {
+  std::atomic<uint64_t> magic;
+  uint64_t version;
+  uint64_t stateDim;
+  uint64_t inputDim;
+  uint64_t maxNumNodes;
+  uint64_t maxNumEvents;
+  uint64_t maxNumTargetNodes;
+  uint64_t numSlots;
+  alignas(ALIGNMENT) std::atomic<uint64_t> publishedSequence;  // sequence number of the latest published policy
+};
+
+/** The header of a policy slot. The arrays follow the header at the offsets given by SlotOffsets. */
+struct SlotHeader {
+  std::atomic<uint64_t> sequence;  // 2 * s - 1 while the policy s is written, 2 * s once it is complete
+  uint64_t controllerType;
+  uint64_t numNodes;
+  uint64_t numControllerNodes;
+  uint64_t numPostEventIndices;
+  uint64_t numEventTimes;
+  uint64_t numTargetNodes;
+  uint64_t targetInputDim;
+  uint64_t observationMode;
+  uint64_t observationInputDim;
+  scalar_t observationTime;
+  PerformanceIndex performanceIndices;
+};
+
+size_t alignUp(size_t size) {
+  return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+/** Byte offsets of the arrays of a policy slot. All elements are 8 bytes. */
+struct SlotOffsets {
+  explicit SlotOffsets(const SharedMemoryPolicyLayout& layout) {
+    const size_t nx = layout.stateDim;
+    const size_t nu = layout.inputDim;
+    const size_t maxN = layout.maxNumNodes;
+    const size_t maxE = layout.maxNumEvents;
+    const size_t maxT = layout.maxNumTargetNodes;
+
+    size_t offset = alignUp(sizeof(SlotHeader));
+    auto allocate = [&offset](size_t numElements) {
+      const size_t begin = offset;
+      offset += numElements * sizeof(scalar_t);
+      return begin;
+    };
+    time = allocate(maxN);
+    state = allocate(maxN * nx);
+    input = allocate(maxN * nu);
+    controllerTime = allocate(maxN);
+    bias = allocate(maxN * nu);
+    gain = allocate(maxN * nu * nx);
+    postEventIndices = allocate(maxE);
+    eventTimes = allocate(maxE);
+    modeSequence = allocate(maxE + 1);
+    observationState = allocate(nx);
+    observationInput = allocate(nu);
+    targetTime = allocate(maxT);
+    targetState = allocate(maxT * nx);
+    targetInput = allocate(maxT * nu);
+    slotSize = alignUp(offset);
+  }
+
+  size_t time, state, input;
+  size_t controllerTime, bias, gain;
+  size_t postEventIndices, eventTimes, modeSequence;
+  size_t observationState, observationInput;
+  size_t targetTime, targetState, targetInput;
+  size_t slotSize;
+};
+
+size_t getSegmentSize(const SharedMemoryPolicyLayout& layout) {
+  return alignUp(sizeof(SegmentHeader)) + layout.numSlots * SlotOffsets(layout).slotSize;
+}
+
+template <typename T>
+T* getSlot(void* segmentPtr, const SharedMemoryPolicyLayout& layout, uint64_t sequence) {
+  const size_t slotIndex = (sequence - 1) % layout.numSlots;
+  return reinterpret_cast<T*>(static_cast<char*>(segmentPtr) + alignUp(sizeof(SegmentHeader)) + slotIndex * SlotOffsets(layout).slotSize);
+}
+
+template <typename T>
+const T* getSlot(const void* segmentPtr, const SharedMemoryPolicyLayout& layout, uint64_t sequence) {
+  return getSlot<T>(const_cast<void*>(segmentPtr), layout, sequence);
+}
+
+template <typename T>
+T* getArray(void* slotPtr, size_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(slotPtr) + offset);
+}
+
+template <typename T>
+const T* getArray(const void* slotPtr, size_t offset) {
+  return reinterpret_cast<const T*>(static_cast<const char*>(slotPtr) + offset);
+}
+
+std::string errnoString(const std::string& what) {
+  return what + ": " + std::strerror(errno);
+}
+
+/** Writes an array of vectors of size dim. */
+void writeVectorArray(const vector_array_t& vectorArray, size_t dim, scalar_t* dst) {
+  for (const auto& v : vectorArray) {
+    Eigen::Map<vector_t>(dst, dim) = v;
+    dst += dim;
+  }
+}
+
+/** Reads n vectors of size dim. */
+void readVectorArray(const scalar_t* src, size_t n, size_t dim, vector_array_t& vectorArray) {
+  vectorArray.resize(n);
+  for (auto& v : vectorArray) {
+    v = Eigen::Map<const vector_t>(src, dim);
+    src += dim;
+  }
+}
+
+template <typename T>
+void readArray(const T* src, size_t n, std::vector<T>& array) {
+  array.assign(src, src + n);
+}
+
+bool hasDimension(const vector_array_t& vectorArray, Eigen::Index dim) {
+  for (const auto& v : vectorArray) {
+    if (v.size() != dim) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** Checks whether the policy fits into a slot of the layout. */
+void checkPolicySize(const SharedMemoryPolicyLayout& layout, const CommandData& command, const PrimalSolution& primalSolution) {
+  auto check = [](bool condition, const std::string& what) {
+    if (!condition) {
+      throw std::runtime_error("[SharedMemoryPolicyWriter] The policy does not fit into the layout: " + what);
+    }
+  };
+  const auto nx = static_cast<Eigen::Index>(layout.stateDim);
+  const auto nu = static_cast<Eigen::Index>(layout.inputDim);
+
+  const size_t N = primalSolution.timeTrajectory_.size();
+  check(N <= layout.maxNumNodes, "too many nodes.");
+  check(primalSolution.stateTrajectory_.size() == N && hasDimension(primalSolution.stateTrajectory_, nx), "state trajectory.");
+  check(primalSolution.inputTrajectory_.size() == N && hasDimension(primalSolution.inputTrajectory_, nu), "input trajectory.");
+  check(primalSolution.postEventIndices_.size() <= layout.maxNumEvents, "too many post-event indices.");
+  check(primalSolution.modeSchedule_.eventTimes.size() <= layout.maxNumEvents, "too many events.");
+  check(primalSolution.modeSchedule_.modeSequence.size() == primalSolution.modeSchedule_.eventTimes.size() + 1, "mode schedule.");
+
+  check(primalSolution.controllerPtr_ != nullptr, "no controller.");
+  switch (primalSolution.controllerPtr_->getType()) {
+    case ControllerType::LINEAR: {
+      const auto& controller = static_cast<const LinearController&>(*primalSolution.controllerPtr_);
+      check(controller.timeStamp_.size() <= layout.maxNumNodes, "too many controller nodes.");
+      check(controller.biasArray_.size() == controller.timeStamp_.size() && hasDimension(controller.biasArray_, nu), "controller bias.");
+      check(controller.gainArray_.size() == controller.timeStamp_.size(), "controller gain.");
+      for (const auto& K : controller.gainArray_) {
+        check(K.rows() == nu && K.cols() == nx, "controller gain.");
+      }
+      break;
+    }
+    case ControllerType::FEEDFORWARD: {
+      const auto& controller = static_cast<const FeedforwardController&>(*primalSolution.controllerPtr_);
+      check(controller.timeStamp_.size() <= layout.maxNumNodes, "too many controller nodes.");
+      check(controller.uffArray_.size() == controller.timeStamp_.size() && hasDimension(controller.uffArray_, nu), "controller input.");
+      break;
+    }
+    default:
+      check(false, "only the linear and the feedforward controllers are supported.");
+  }
+
+  const auto& observation = command.mpcInitObservation_;
+  check(observation.state.size() == nx, "observation state.");
+  check(observation.input.size() == 0 || observation.input.size() == nu, "observation input.");
+
+  const auto& target = command.mpcTargetTrajectories_;
+  check(target.timeTrajectory.size() <= layout.maxNumTargetNodes, "too many target nodes.");
+  check(target.stateTrajectory.size() == target.timeTrajectory.size() && hasDimension(target.stateTrajectory, nx), "target state.");
+  check(target.inputTrajectory.empty() ||
+            (target.inputTrajectory.size() == target.timeTrajectory.size() && hasDimension(target.inputTrajectory, nu)),
+        "target input.");
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemoryPolicyWriter::SharedMemoryPolicyWriter(std::string name, const SharedMemoryPolicyLayout& layout)
+    : name_(std::move(name)), layout_(layout), segmentSize_(getSegmentSize(layout)) {
+  if (layout_.numSlots < 2) {
+    throw std::runtime_error("[SharedMemoryPolicyWriter] The channel needs at least two slots.");
+  }
+
+  // remove a stale segment of a previous writer
+  ::shm_unlink(name_.c_str());
+  const int fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    throw std::runtime_error(errnoString("[SharedMemoryPolicyWriter] Cannot create " + name_));
+  }
+  if (::ftruncate(fd, static_cast<off_t>(segmentSize_)) != 0) {
+    ::close(fd);
+    ::shm_unlink(name_.c_str());
+    throw std::runtime_error(errnoString("[SharedMemoryPolicyWriter] Cannot resize " + name_));
+  }
+  segmentPtr_ = ::mmap(nullptr, segmentSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (segmentPtr_ == MAP_FAILED) {
+    ::shm_unlink(name_.c_str());
+    throw std::runtime_error(errnoString("[SharedMemoryPolicyWriter] Cannot map " + name_));
+  }
+
+  auto* header = new (segmentPtr_) SegmentHeader;
+  header->version = VERSION;
+  header->stateDim = layout_.stateDim;
+  header->inputDim = layout_.inputDim;
+  header->maxNumNodes = layout_.maxNumNodes;
+  header->maxNumEvents = layout_.maxNumEvents;
+  header->maxNumTargetNodes = layout_.maxNumTargetNodes;
+  header->numSlots = layout_.numSlots;
+  header->publishedSequence.store(0, std::memory_order_relaxed);
+  for (uint64_t s = 1; s <= layout_.numSlots; s++) {
+    auto* slot = new (getSlot<SlotHeader>(segmentPtr_, layout_, s)) SlotHeader;
+    slot->sequence.store(0, std::memory_order_relaxed);
+  }
+  header->magic.store(MAGIC, std::memory_order_release);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemoryPolicyWriter::~SharedMemoryPolicyWriter() {
+  ::munmap(segmentPtr_, segmentSize_);
+  ::shm_unlink(name_.c_str());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SharedMemoryPolicyWriter::write(const CommandData& command, const PrimalSolution& primalSolution,
+                                     const PerformanceIndex& performanceIndices) {
+  checkPolicySize(layout_, command, primalSolution);
+
+  const size_t nx = layout_.stateDim;
+  const size_t nu = layout_.inputDim;
+  const SlotOffsets offsets(layout_);
+  const uint64_t sequence = sequence_ + 1;
+  auto* slot = getSlot<SlotHeader>(segmentPtr_, layout_, sequence);
+
+  // mark the slot as being written
+  slot->sequence.store(2 * sequence - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  // primal solution
+  const size_t N = primalSolution.timeTrajectory_.size();
+  slot->numNodes = N;
+  std::copy(primalSolution.timeTrajectory_.begin(), primalSolution.timeTrajectory_.end(), getArray<scalar_t>(slot, offsets.time));
+  writeVectorArray(primalSolution.stateTrajectory_, nx, getArray<scalar_t>(slot, offsets.state));
+  writeVectorArray(primalSolution.inputTrajectory_, nu, getArray<scalar_t>(slot, offsets.input));
+  slot->numPostEventIndices = primalSolution.postEventIndices_.size();
+  std::copy(primalSolution.postEventIndices_.begin(), primalSolution.postEventIndices_.end(),
+            getArray<uint64_t>(slot, offsets.postEventIndices));
+  const auto& modeSchedule = primalSolution.modeSchedule_;
+  slot->numEventTimes = modeSchedule.eventTimes.size();
+  std::copy(modeSchedule.eventTimes.begin(), modeSchedule.eventTimes.end(), getArray<scalar_t>(slot, offsets.eventTimes));
+  std::copy(modeSchedule.modeSequence.begin(), modeSchedule.modeSequence.end(), getArray<uint64_t>(slot, offsets.modeSequence));
+
+  // controller
+  if (primalSolution.controllerPtr_->getType() == ControllerType::LINEAR) {
+    const auto& controller = static_cast<const LinearController&>(*primalSolution.controllerPtr_);
+    slot->controllerType = static_cast<uint64_t>(ControllerType::LINEAR);
+    slot->numControllerNodes = controller.timeStamp_.size();
+    std::copy(controller.timeStamp_.begin(), controller.timeStamp_.end(), getArray<scalar_t>(slot, offsets.controllerTime));
+    writeVectorArray(controller.biasArray_, nu, getArray<scalar_t>(slot, offsets.bias));
+    scalar_t* gainPtr = getArray<scalar_t>(slot, offsets.gain);
+    for (const auto& K : controller.gainArray_) {
+      Eigen::Map<matrix_t>(gainPtr, nu, nx) = K;
+      gainPtr += nu * nx;
+    }
+  } else {
+    const auto& controller = static_cast<const FeedforwardController&>(*primalSolution.controllerPtr_);
+    slot->controllerType = static_cast<uint64_t>(ControllerType::FEEDFORWARD);
+    slot->numControllerNodes = controller.timeStamp_.size();
+    std::copy(controller.timeStamp_.begin(), controller.timeStamp_.end(), getArray<scalar_t>(slot, offsets.controllerTime));
+    writeVectorArray(controller.uffArray_, nu, getArray<scalar_t>(slot, offsets.bias));
+  }
+
+  // command
+  const auto& observation = command.mpcInitObservation_;
+  slot->observationMode = observation.mode;
+  slot->observationTime = observation.time;
+  slot->observationInputDim = observation.input.size();
+  Eigen::Map<vector_t>(getArray<scalar_t>(slot, offsets.observationState), nx) = observation.state;
+  Eigen::Map<vector_t>(getArray<scalar_t>(slot, offsets.observationInput), observation.input.size()) = observation.input;
+  const auto& target = command.mpcTargetTrajectories_;
+  slot->numTargetNodes = target.timeTrajectory.size();
+  slot->targetInputDim = target.inputTrajectory.empty() ? 0 : nu;
+  std::copy(target.timeTrajectory.begin(), target.timeTrajectory.end(), getArray<scalar_t>(slot, offsets.targetTime));
+  writeVectorArray(target.stateTrajectory, nx, getArray<scalar_t>(slot, offsets.targetState));
+  writeVectorArray(target.inputTrajectory, nu, getArray<scalar_t>(slot, offsets.targetInput));
+
+  slot->performanceIndices = performanceIndices;
+
+  // publish
+  slot->sequence.store(2 * sequence, std::memory_order_release);
+  static_cast<SegmentHeader*>(segmentPtr_)->publishedSequence.store(sequence, std::memory_order_release);
+  sequence_ = sequence;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemoryPolicyReader::SharedMemoryPolicyReader(const std::string& name) {
+  const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    throw std::runtime_error(errnoString("[SharedMemoryPolicyReader] Cannot open " + name));
+  }
+  struct stat fileStatus;
+  if (::fstat(fd, &fileStatus) != 0 || static_cast<size_t>(fileStatus.st_size) < sizeof(SegmentHeader)) {
+    ::close(fd);
+    throw std::runtime_error("[SharedMemoryPolicyReader] " + name + " is not initialized.");
+  }
+  segmentSize_ = static_cast<size_t>(fileStatus.st_size);
+  segmentPtr_ = ::mmap(nullptr, segmentSize_, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (segmentPtr_ == MAP_FAILED) {
+    throw std::runtime_error(errnoString("[SharedMemoryPolicyReader] Cannot map " + name));
+  }
+
+  const auto* header = static_cast<const SegmentHeader*>(segmentPtr_);
+  auto fail = [&](const std::string& what) {
+    ::munmap(const_cast<void*>(segmentPtr_), segmentSize_);
+    throw std::runtime_error("[SharedMemoryPolicyReader] " + name + " " + what);
+  };
+  if (header->magic.load(std::memory_order_acquire) != MAGIC) {
+    fail("is not initialized.");
+  }
+  if (header->version != VERSION) {
+    fail("has version " + std::to_string(header->version) + " instead of " + std::to_string(VERSION) + ".");
+  }
+  layout_.stateDim = header->stateDim;
+  layout_.inputDim = header->inputDim;
+  layout_.maxNumNodes = header->maxNumNodes;
+  layout_.maxNumEvents = header->maxNumEvents;
+  layout_.maxNumTargetNodes = header->maxNumTargetNodes;
+  layout_.numSlots = header->numSlots;
+  if (layout_.numSlots < 2 || segmentSize_ < getSegmentSize(layout_)) {
+    fail("has an invalid layout.");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemoryPolicyReader::~SharedMemoryPolicyReader() {
+  ::munmap(const_cast<void*>(segmentPtr_), segmentSize_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SharedMemoryPolicyReader::hasNewPolicy() const {
+  return static_cast<const SegmentHeader*>(segmentPtr_)->publishedSequence.load(std::memory_order_acquire) != sequence_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SharedMemoryPolicyReader::read(CommandData& command, PrimalSolution& primalSolution, PerformanceIndex& performanceIndices) {
+  const size_t nx = layout_.stateDim;
+  const size_t nu = layout_.inputDim;
+  const SlotOffsets offsets(layout_);
+  const auto* header = static_cast<const SegmentHeader*>(segmentPtr_);
+
+  while (true) {
+    const uint64_t sequence = header->publishedSequence.load(std::memory_order_acquire);
+    if (sequence == sequence_) {
+      return false;
+    }
+
+    const auto* slot = getSlot<SlotHeader>(segmentPtr_, layout_, sequence);
+    const uint64_t slotSequence = slot->sequence.load(std::memory_order_acquire);
+    if (slotSequence != 2 * sequence) {
+      continue;  // the slot is already being overwritten by a newer policy
+    }
+
+    // The sizes are checked before they are used, since the slot may be overwritten while it is read.
+    const auto controllerType = static_cast<ControllerType>(slot->controllerType);
+    const size_t N = slot->numNodes;
+    const size_t numControllerNodes = slot->numControllerNodes;
+    const size_t numPostEventIndices = slot->numPostEventIndices;
+    const size_t numEventTimes = slot->numEventTimes;
+    const size_t numTargetNodes = slot->numTargetNodes;
+    const size_t targetInputDim = slot->targetInputDim;
+    const size_t observationInputDim = slot->observationInputDim;
+    if ((controllerType != ControllerType::LINEAR && controllerType != ControllerType::FEEDFORWARD) || N > layout_.maxNumNodes ||
+        numControllerNodes > layout_.maxNumNodes || numPostEventIndices > layout_.maxNumEvents || numEventTimes > layout_.maxNumEvents ||
+        numTargetNodes > layout_.maxNumTargetNodes || (targetInputDim != 0 && targetInputDim != nu) ||
+        (observationInputDim != 0 && observationInputDim != nu)) {
+      continue;
+    }
+
+    // primal solution
+    readArray(getArray<scalar_t>(slot, offsets.time), N, primalSolution.timeTrajectory_);
+    readVectorArray(getArray<scalar_t>(slot, offsets.state), N, nx, primalSolution.stateTrajectory_);
+    readVectorArray(getArray<scalar_t>(slot, offsets.input), N, nu, primalSolution.inputTrajectory_);
+    readArray(getArray<uint64_t>(slot, offsets.postEventIndices), numPostEventIndices, primalSolution.postEventIndices_);
+    readArray(getArray<scalar_t>(slot, offsets.eventTimes), numEventTimes, primalSolution.modeSchedule_.eventTimes);
+    readArray(getArray<uint64_t>(slot, offsets.modeSequence), numEventTimes + 1, primalSolution.modeSchedule_.modeSequence);
+
+    // controller, reused if it has the same type
+    auto& controllerPtr = primalSolution.controllerPtr_;
+    if (controllerType == ControllerType::LINEAR) {
+      if (controllerPtr == nullptr || controllerPtr->getType() != ControllerType::LINEAR) {
+        controllerPtr.reset(new LinearController);
+      }
+      auto& controller = static_cast<LinearController&>(*controllerPtr);
+      readArray(getArray<scalar_t>(slot, offsets.controllerTime), numControllerNodes, controller.timeStamp_);
+      readVectorArray(getArray<scalar_t>(slot, offsets.bias), numControllerNodes, nu, controller.biasArray_);
+      controller.deltaBiasArray_.clear();
+      controller.gainArray_.resize(numControllerNodes);
+      const scalar_t* gainPtr = getArray<scalar_t>(slot, offsets.gain);
+      for (auto& K : controller.gainArray_) {
+        K = Eigen::Map<const matrix_t>(gainPtr, nu, nx);
+        gainPtr += nu * nx;
+      }
+    } else {
+      if (controllerPtr == nullptr || controllerPtr->getType() != ControllerType::FEEDFORWARD) {
+        controllerPtr.reset(new FeedforwardController);
+      }
+      auto& controller = static_cast<FeedforwardController&>(*controllerPtr);
+      readArray(getArray<scalar_t>(slot, offsets.controllerTime), numControllerNodes, controller.timeStamp_);
+      readVectorArray(getArray<scalar_t>(slot, offsets.bias), numControllerNodes, nu, controller.uffArray_);
+    }
+
+    // command
+    auto& observation = command.mpcInitObservation_;
+    observation.mode = slot->observationMode;
+    observation.time = slot->observationTime;
+    observation.state = Eigen::Map<const vector_t>(getArray<scalar_t>(slot, offsets.observationState), nx);
+    observation.input = Eigen::Map<const vector_t>(getArray<scalar_t>(slot, offsets.observationInput), observationInputDim);
+    auto& target = command.mpcTargetTrajectories_;
+    readArray(getArray<scalar_t>(slot, offsets.targetTime), numTargetNodes, target.timeTrajectory);
+    readVectorArray(getArray<scalar_t>(slot, offsets.targetState), numTargetNodes, nx, target.stateTrajectory);
+    readVectorArray(getArray<scalar_t>(slot, offsets.targetInput), targetInputDim > 0 ? numTargetNodes : 0, nu, target.inputTrajectory);
+
+    performanceIndices = slot->performanceIndices;
+
+    // accept the copy if the slot has not been overwritten in the meantime
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->sequence.load(std::memory_order_relaxed) == slotSequence) {
+      sequence_ = sequence;
+      return true;
+    }
+  }
+}
+
+}  // namespace ocs2
@@ -0,0 +1,123 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cmath>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+namespace ocs2 {
+
+/** A random policy over [0, 1] with numNodes nodes and an event in the middle of the horizon */
+inline PrimalSolution getRandomPolicy(size_t stateDim, size_t inputDim, size_t numNodes, bool isLinear) {
+  const scalar_t eventTime = 0.5;
+
+  PrimalSolution primalSolution;
+  for (size_t i = 0; i < numNodes; i++) {
+    const scalar_t time = static_cast<scalar_t>(i) / (numNodes - 1);
+    if (!primalSolution.timeTrajectory_.empty() && primalSolution.timeTrajectory_.back() < eventTime && eventTime < time) {
+      primalSolution.timeTrajectory_.push_back(eventTime);
+      primalSolution.stateTrajectory_.push_back(vector_t::Random(stateDim));
+      primalSolution.timeTrajectory_.push_back(eventTime);
+      primalSolution.stateTrajectory_.push_back(vector_t::Random(stateDim));
+    }
+    primalSolution.timeTrajectory_.push_back(time);
+    primalSolution.stateTrajectory_.push_back(vector_t::Random(stateDim));
+  }
+
+  const auto N = primalSolution.timeTrajectory_.size();
+  vector_array_t biasArray(N);
+  matrix_array_t gainArray(N);
+  for (size_t i = 0; i < N; i++) {
+    biasArray[i] = vector_t::Random(inputDim);
+    gainArray[i] = matrix_t::Random(inputDim, stateDim);
+  }
+  if (isLinear) {
+    primalSolution.controllerPtr_.reset(new LinearController(primalSolution.timeTrajectory_, biasArray, gainArray));
+  } else {
+    primalSolution.controllerPtr_.reset(new FeedforwardController(primalSolution.timeTrajectory_, biasArray));
+  }
+
+  primalSolution.modeSchedule_ = ModeSchedule({eventTime}, {0, 1});
+  return primalSolution;
+}
+
+/**
+ * A policy over [startTime, startTime + 1] with an event in the middle of the horizon. Its values are smooth functions of time, so
+ * that the policies of consecutive MPC cycles only differ by the given perturbation.
+ */
+inline PrimalSolution getSmoothPolicy(size_t stateDim, size_t inputDim, size_t numNodes, scalar_t startTime, bool isLinear,
+                                      scalar_t perturbation = 0.0) {
+  const scalar_t eventTime = startTime + 0.5;
+  auto getVector = [&](scalar_t t, size_t n) {
+    vector_t v(n);
+    for (size_t i = 0; i < n; i++) {
+      v(i) = std::sin(t + i) + perturbation * std::cos(3.0 * t + i);
+    }
+    return v;
+  };
+
+  PrimalSolution primalSolution;
+  vector_array_t biasArray;
+  matrix_array_t gainArray;
+  for (size_t k = 0; k < numNodes; k++) {
+    const scalar_t time = startTime + static_cast<scalar_t>(k) / (numNodes - 1);
+    if (!primalSolution.timeTrajectory_.empty() && primalSolution.timeTrajectory_.back() < eventTime && eventTime < time) {
+      primalSolution.postEventIndices_.push_back(primalSolution.timeTrajectory_.size() + 1);
+      for (int i = 0; i < 2; i++) {
+        primalSolution.timeTrajectory_.push_back(eventTime);
+      }
+    } else {
+      primalSolution.timeTrajectory_.push_back(time);
+    }
+  }
+  for (const auto t : primalSolution.timeTrajectory_) {
+    primalSolution.stateTrajectory_.push_back(getVector(t, stateDim));
+    primalSolution.inputTrajectory_.push_back(getVector(t, inputDim));
+    biasArray.push_back(getVector(2.0 * t, inputDim));
+    matrix_t gain(inputDim, stateDim);
+    for (size_t j = 0; j < stateDim; j++) {
+      gain.col(j) = 10.0 * getVector(t + j, inputDim);
+    }
+    gainArray.push_back(gain);
+  }
+
+  if (isLinear) {
+    primalSolution.controllerPtr_.reset(new LinearController(primalSolution.timeTrajectory_, biasArray, gainArray));
+  } else {
+    primalSolution.controllerPtr_.reset(new FeedforwardController(primalSolution.timeTrajectory_, biasArray));
+  }
+  primalSolution.modeSchedule_ = ModeSchedule({eventTime}, {0, 1});
+  return primalSolution;
+}
+
+}  // namespace ocs2
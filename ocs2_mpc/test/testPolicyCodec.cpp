@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_mpc/PolicyCodec.h>
+
+#include "ocs2_mpc/test/testPolicies.h"
+
+namespace {
+
+constexpr size_t STATE_DIM = 12;
+constexpr size_t INPUT_DIM = 12;
+constexpr size_t NUM_NODES = 100;
+
+using ocs2::policy_codec::Precision;
+
+/** A smooth policy of the test dimensions over [startTime, startTime + 1] */
+ocs2::PrimalSolution getPolicy(ocs2::scalar_t startTime, bool isLinear, ocs2::scalar_t perturbation = 0.0) {
+  return ocs2::getSmoothPolicy(STATE_DIM, INPUT_DIM, NUM_NODES, startTime, isLinear, perturbation);
+}
+
+/** The largest absolute error of an array. */
+template <typename Array>
+ocs2::scalar_t maxError(const Array& expected, const Array& actual) {
+  EXPECT_EQ(expected.size(), actual.size());
+  ocs2::scalar_t error = 0.0;
+  for (size_t k = 0; k < std::min(expected.size(), actual.size()); k++) {
+    error = std::max(error, (expected[k] - actual[k]).cwiseAbs().maxCoeff());
+  }
+  return error;
+}
+
+/** Compares the decoded policy and returns the largest absolute error of the trajectories, the feedforward, and the gains. */
+std::pair<ocs2::scalar_t, ocs2::scalar_t> compare(const ocs2::PrimalSolution& expected, const ocs2::PrimalSolution& actual) {
+  EXPECT_EQ(expected.timeTrajectory_, actual.timeTrajectory_);
+  EXPECT_EQ(expected.postEventIndices_, actual.postEventIndices_);
+  EXPECT_EQ(expected.modeSchedule_.eventTimes, actual.modeSchedule_.eventTimes);
+  EXPECT_EQ(expected.modeSchedule_.modeSequence, actual.modeSchedule_.modeSequence);
+  EXPECT_EQ(expected.controllerPtr_->getType(), actual.controllerPtr_->getType());
+
+  ocs2::scalar_t trajectoryError = std::max(maxError(expected.stateTrajectory_, actual.stateTrajectory_),
+                                            maxError(expected.inputTrajectory_, actual.inputTrajectory_));
+  ocs2::scalar_t gainError = 0.0;
+  if (expected.controllerPtr_->getType() == ocs2::ControllerType::LINEAR) {
+    const auto& expectedController = static_cast<const ocs2::LinearController&>(*expected.controllerPtr_);
+    const auto& actualController = static_cast<const ocs2::LinearController&>(*actual.controllerPtr_);
+    EXPECT_EQ(expectedController.timeStamp_, actualController.timeStamp_);
+    trajectoryError = std::max(trajectoryError, maxError(expectedController.biasArray_, actualController.biasArray_));
+    gainError = maxError(expectedController.gainArray_, actualController.gainArray_);
+  } else {
+    const auto& expectedController = static_cast<const ocs2::FeedforwardController&>(*expected.controllerPtr_);
+    const auto& actualController = static_cast<const ocs2::FeedforwardController&>(*actual.controllerPtr_);
+    EXPECT_EQ(expectedController.timeStamp_, actualController.timeStamp_);
+    trajectoryError = std::max(trajectoryError, maxError(expectedController.uffArray_, actualController.uffArray_));
+  }
+  return {trajectoryError, gainError};
+}
+
+}  // unnamed namespace
+
+TEST(testPolicyCodec, precision) {
+  struct Case {
+    Precision trajectoryPrecision;
+    Precision gainPrecision;
+    ocs2::scalar_t trajectoryTolerance;
+    ocs2::scalar_t gainTolerance;
+  };
+  // the trajectories are bounded by 1 and the gains by 10
+  const std::vector<Case> cases{{Precision::FLOAT64, Precision::FLOAT64, 0.0, 0.0},
+                                {Precision::FLOAT32, Precision::FLOAT32, 1e-7, 1e-6},
+                                {Precision::FLOAT32, Precision::FLOAT16, 1e-7, 1e-2},
+                                {Precision::FLOAT16, Precision::INT8, 1e-3, 10.0 / 127}};
+
+  for (const bool isLinear : {true, false}) {
+    const auto primalSolution = getPolicy(0.0, isLinear);
+    for (const auto& c : cases) {
+      ocs2::policy_codec::Settings settings;
+      settings.trajectoryPrecision = c.trajectoryPrecision;
+      settings.gainPrecision = c.gainPrecision;
+      ocs2::PolicyEncoder encoder(settings);
+      ocs2::PolicyDecoder decoder;
+
+      std::vector<uint8_t> message;
+      encoder.encode(primalSolution, message);
+      ocs2::PrimalSolution decoded;
+      ASSERT_TRUE(decoder.decode(message, decoded));
+
+      const auto errors = compare(primalSolution, decoded);
+      EXPECT_LE(errors.first, c.trajectoryTolerance);
+      EXPECT_LE(errors.second, c.gainTolerance);
+    }
+  }
+}
+
+TEST(testPolicyCodec, float16) {
+  // values with a known half precision representation
+  const std::vector<std::pair<ocs2::scalar_t, ocs2::scalar_t>> values{
+      {0.0, 0.0},           {1.0, 1.0},        {-2.5, -2.5},           {1.0 / 3.0, 0.333251953125},
+      {65504.0, 65504.0},   {1e6, 65504.0},    {-1e6, -65504.0},       {std::ldexp(1.0, -24), std::ldexp(1.0, -24)},
+      {1e-9, 0.0},          {1.0 + 1e-4, 1.0}, {2049.0, 2048.0},       {2051.0, 2052.0}};
+
+  ocs2::PrimalSolution primalSolution;
+  primalSolution.timeTrajectory_ = {0.0};
+  primalSolution.stateTrajectory_ = {ocs2::vector_t::Zero(0)};
+  ocs2::vector_t input(values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    input(i) = values[i].first;
+  }
+  primalSolution.inputTrajectory_ = {input};
+  primalSolution.controllerPtr_.reset(new ocs2::FeedforwardController(primalSolution.timeTrajectory_, {input}));
+  primalSolution.modeSchedule_ = ocs2::ModeSchedule({}, {0});
+
+  ocs2::policy_codec::Settings settings;
+  settings.trajectoryPrecision = Precision::FLOAT16;
+  ocs2::PolicyEncoder encoder(settings);
+  std::vector<uint8_t> message;
+  encoder.encode(primalSolution, message);
+  ocs2::PolicyDecoder decoder;
+  ocs2::PrimalSolution decoded;
+  ASSERT_TRUE(decoder.decode(message, decoded));
+
+  for (size_t i = 0; i < values.size(); i++) {
+    EXPECT_EQ(decoded.inputTrajectory_.front()(i), values[i].second) << "value: " << values[i].first;
+  }
+}
+
+TEST(testPolicyCodec, timeWindow) {
+  const auto primalSolution = getPolicy(0.0, true);
+
+  ocs2::policy_codec::Settings settings;
+  settings.timeWindow = 0.25;
+  ocs2::PolicyEncoder encoder(settings);
+  std::vector<uint8_t> message;
+  encoder.encode(primalSolution, message);
+  ocs2::PolicyDecoder decoder;
+  ocs2::PrimalSolution decoded;
+  ASSERT_TRUE(decoder.decode(message, decoded));
+
+  // one node beyond the time window
+  ASSERT_GE(decoded.timeTrajectory_.size(), 2);
+  EXPECT_LT(decoded.timeTrajectory_.size(), primalSolution.timeTrajectory_.size());
+  EXPECT_LE(decoded.timeTrajectory_[decoded.timeTrajectory_.size() - 2], settings.timeWindow);
+  EXPECT_GT(decoded.timeTrajectory_.back(), settings.timeWindow);
+  EXPECT_TRUE(decoded.postEventIndices_.empty());
+  EXPECT_EQ(decoded.modeSchedule_.modeSequence, primalSolution.modeSchedule_.modeSequence);
+  EXPECT_EQ(static_cast<const ocs2::LinearController&>(*decoded.controllerPtr_).timeStamp_, decoded.timeTrajectory_);
+}
+
+TEST(testPolicyCodec, deltaEncoding) {
+  constexpr size_t numPolicies = 25;
+  constexpr ocs2::scalar_t mpcPeriod = 0.01;
+
+  ocs2::policy_codec::Settings settings;
+  settings.trajectoryPrecision = Precision::FLOAT32;
+  settings.gainPrecision = Precision::FLOAT16;
+  settings.deltaEncoding = true;
+  settings.deltaTolerance = 1e-3;
+  settings.keyframeInterval = 10;
+  ocs2::PolicyEncoder encoder(settings);
+  ocs2::PolicyDecoder decoder;
+  ocs2::PolicyDecoder lossyDecoder;  // misses the second message
+
+  std::vector<uint8_t> message;
+  ocs2::PrimalSolution decoded;
+  size_t keyframeSize = 0;
+  for (size_t i = 0; i < numPolicies; i++) {
+    const auto primalSolution = getPolicy(i * mpcPeriod, true, 1e-4 * i);
+    encoder.encode(primalSolution, message);
+    const bool isKeyframe = i % settings.keyframeInterval == 0;
+    if (isKeyframe) {
+      keyframeSize = message.size();
+    } else {
+      EXPECT_LT(message.size(), keyframeSize);
+    }
+
+    // the quantization errors and the skipped changes do not accumulate over the deltas
+    ASSERT_TRUE(decoder.decode(message, decoded));
+    const auto errors = compare(primalSolution, decoded);
+    EXPECT_LE(errors.first, settings.deltaTolerance + 1e-6) << "policy: " << i;
+    EXPECT_LE(errors.second, settings.deltaTolerance + 1e-2) << "policy: " << i;
+
+    // after a lost message the deltas are rejected until the next keyframe
+    if (i != 1) {
+      EXPECT_EQ(lossyDecoder.decode(message, decoded), i == 0 || i >= settings.keyframeInterval);
+    }
+  }
+}
+
+TEST(testPolicyCodec, malformedMessage) {
+  ocs2::PolicyEncoder encoder(ocs2::policy_codec::Settings{});
+  std::vector<uint8_t> message;
+  encoder.encode(getPolicy(0.0, true), message);
+
+  ocs2::PolicyDecoder decoder;
+  ocs2::PrimalSolution decoded;
+  auto truncated = message;
+  truncated.resize(message.size() / 2);
+  EXPECT_THROW(decoder.decode(truncated, decoded), std::runtime_error);
+  auto wrongVersion = message;
+  wrongVersion[4] = 0xff;
+  EXPECT_THROW(decoder.decode(wrongVersion, decoded), std::runtime_error);
+
+  // header fields, at their byte offsets
+  constexpr size_t flagsOffset = 5;
+  constexpr size_t nxOffset = 17;
+  constexpr size_t NOffset = 25;
+  constexpr size_t controllerNOffset = 29;
+  auto setField = [&](size_t offset, uint32_t value) {
+    auto corrupted = message;
+    std::memcpy(corrupted.data() + offset, &value, sizeof(value));
+    return corrupted;
+  };
+  ASSERT_NE(message[flagsOffset] & 0x2, 0);  // the controller shares the time trajectory
+  uint32_t N;
+  std::memcpy(&N, message.data() + NOffset, sizeof(N));
+  EXPECT_THROW(decoder.decode(setField(controllerNOffset, N - 1), decoded), std::runtime_error);
+  EXPECT_THROW(decoder.decode(setField(controllerNOffset, N + 1), decoded), std::runtime_error);
+  EXPECT_THROW(decoder.decode(setField(nxOffset, 0xffffffff), decoded), std::runtime_error);
+  EXPECT_THROW(decoder.decode(setField(nxOffset, 1000), decoded), std::runtime_error);
+
+  // the decoder still works after rejecting messages
+  EXPECT_TRUE(decoder.decode(message, decoded));
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_mpc/PolicyEvaluator.h>
+
+#include "ocs2_mpc/test/testPolicies.h"
+
+namespace {
+
+constexpr size_t STATE_DIM = 12;
+constexpr size_t INPUT_DIM = 6;
+
+void compareWithController(bool isLinear) {
+  const auto primalSolution = ocs2::getRandomPolicy(STATE_DIM, INPUT_DIM, 50, isLinear);
+  ocs2::PolicyEvaluator policyEvaluator;
+  policyEvaluator.setPolicy(primalSolution);
+
+  // forward in time, beyond the horizon, and then back in time
+  ocs2::scalar_array_t queryTimes;
+  for (ocs2::scalar_t t = -0.1; t < 1.1; t += 0.0037) {
+    queryTimes.push_back(t);
+  }
+  queryTimes.push_back(0.5);
+  queryTimes.push_back(0.2);
+
+  ocs2::vector_t input, nominalState;
+  size_t mode;
+  for (const auto t : queryTimes) {
+    const ocs2::vector_t state = ocs2::vector_t::Random(STATE_DIM);
+    policyEvaluator.evaluate(t, state, input, nominalState, mode);
+    EXPECT_TRUE(input.isApprox(primalSolution.controllerPtr_->computeInput(t, state))) << "time: " << t;
+    EXPECT_TRUE(nominalState.isApprox(
+        ocs2::LinearInterpolation::interpolate(t, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_)))
+        << "time: " << t;
+    EXPECT_EQ(mode, primalSolution.modeSchedule_.modeAtTime(t)) << "time: " << t;
+  }
+}
+
+}  // unnamed namespace
+
+TEST(testPolicyEvaluator, linearController) {
+  compareWithController(true);
+}
+
+TEST(testPolicyEvaluator, feedforwardController) {
+  compareWithController(false);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+
+#include <ocs2_mpc/PolicyEvaluator.h>
+
+#include "ocs2_mpc/test/testPolicies.h"
+
+#if defined(__GLIBC__)
+/*
+ * Counts the heap allocations by interposing malloc. Both operator new and the Eigen allocations end up in malloc. The interposition
+ * affects the whole executable, which is why this test has a target of its own.
+ */
+extern "C" void* __libc_malloc(size_t size);
+
+namespace {
+bool countAllocations = false;
+size_t numAllocations = 0;
+}  // unnamed namespace
+
+extern "C" void* malloc(size_t size) noexcept {
+  if (countAllocations) {
+    ++numAllocations;
+  }
+  return __libc_malloc(size);
+}
+#endif
+
+TEST(testPolicyEvaluator, noAllocations) {
+  constexpr size_t STATE_DIM = 12;
+  constexpr size_t INPUT_DIM = 6;
+  constexpr ocs2::scalar_t controlRate = 1000.0;
+
+  for (const size_t numNodes : {100, 1000, 10000}) {
+    const auto primalSolution = ocs2::getRandomPolicy(STATE_DIM, INPUT_DIM, numNodes, true);
+    const auto numQueries = static_cast<size_t>(controlRate * primalSolution.timeTrajectory_.back());
+    const ocs2::vector_t state = ocs2::vector_t::Random(STATE_DIM);
+
+    // The first call sizes the outputs
+    ocs2::vector_t input, nominalState;
+    size_t mode;
+    ocs2::PolicyEvaluator policyEvaluator;
+    policyEvaluator.setPolicy(primalSolution);
+    policyEvaluator.evaluate(0.0, state, input, nominalState, mode);
+#if defined(__GLIBC__)
+    numAllocations = 0;
+    countAllocations = true;
+#endif
+    for (size_t i = 0; i < numQueries; i++) {
+      policyEvaluator.evaluate(i / controlRate, state, input, nominalState, mode);
+    }
+#if defined(__GLIBC__)
+    countAllocations = false;
+    EXPECT_EQ(numAllocations, 0) << "number of nodes: " << numNodes;
+#endif
+  }
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_mpc/SharedMemoryPolicyChannel.h>
+
+namespace {
+
+constexpr size_t STATE_DIM = 12;
+constexpr size_t INPUT_DIM = 12;
+constexpr size_t NUM_NODES = 100;
+
+ocs2::SharedMemoryPolicyLayout getLayout() {
+  ocs2::SharedMemoryPolicyLayout layout;
+  layout.stateDim = STATE_DIM;
+  layout.inputDim = INPUT_DIM;
+  layout.maxNumNodes = NUM_NODES + 2;
+  layout.maxNumEvents = 4;
+  layout.maxNumTargetNodes = 2;
+  return layout;
+}
+
+std::string getSegmentName() {
+  return "/ocs2_test_policy_" + std::to_string(::getpid());
+}
+
+/** A policy with an event in the middle of the horizon. All its values are equal to the given value. */
+void getPolicy(ocs2::scalar_t value, bool isLinear, ocs2::CommandData& command, ocs2::PrimalSolution& primalSolution,
+               ocs2::PerformanceIndex& performanceIndices) {
+  const ocs2::vector_t x = ocs2::vector_t::Constant(STATE_DIM, value);
+  const ocs2::vector_t u = ocs2::vector_t::Constant(INPUT_DIM, value);
+  const ocs2::matrix_t K = ocs2::matrix_t::Constant(INPUT_DIM, STATE_DIM, value);
+
+  primalSolution.clear();
+  for (size_t i = 0; i < NUM_NODES; i++) {
+    primalSolution.timeTrajectory_.push_back(value + static_cast<ocs2::scalar_t>(i) / (NUM_NODES - 1));
+  }
+  primalSolution.stateTrajectory_.assign(NUM_NODES, x);
+  primalSolution.inputTrajectory_.assign(NUM_NODES, u);
+  primalSolution.postEventIndices_ = {NUM_NODES / 2};
+  primalSolution.modeSchedule_ = ocs2::ModeSchedule({primalSolution.timeTrajectory_[NUM_NODES / 2]}, {0, 1});
+  if (isLinear) {
+    primalSolution.controllerPtr_.reset(new ocs2::LinearController(primalSolution.timeTrajectory_, primalSolution.inputTrajectory_,
+                                                                   ocs2::matrix_array_t(NUM_NODES, K)));
+  } else {
+    primalSolution.controllerPtr_.reset(new ocs2::FeedforwardController(primalSolution.timeTrajectory_, primalSolution.inputTrajectory_));
+  }
+
+  command.mpcInitObservation_.mode = 1;
+  command.mpcInitObservation_.time = value;
+  command.mpcInitObservation_.state = x;
+  command.mpcInitObservation_.input = u;
+  command.mpcTargetTrajectories_ = ocs2::TargetTrajectories({value, value + 1.0}, {x, x}, {u, u});
+
+  performanceIndices = ocs2::PerformanceIndex();
+  performanceIndices.merit = value;
+}
+
+void expectEqual(const ocs2::PrimalSolution& expected, const ocs2::PrimalSolution& actual) {
+  EXPECT_EQ(expected.timeTrajectory_, actual.timeTrajectory_);
+  EXPECT_EQ(expected.stateTrajectory_, actual.stateTrajectory_);
+  EXPECT_EQ(expected.inputTrajectory_, actual.inputTrajectory_);
+  EXPECT_EQ(expected.postEventIndices_, actual.postEventIndices_);
+  EXPECT_EQ(expected.modeSchedule_.eventTimes, actual.modeSchedule_.eventTimes);
+  EXPECT_EQ(expected.modeSchedule_.modeSequence, actual.modeSchedule_.modeSequence);
+  ASSERT_EQ(expected.controllerPtr_->getType(), actual.controllerPtr_->getType());
+  if (expected.controllerPtr_->getType() == ocs2::ControllerType::LINEAR) {
+    const auto& expectedController = static_cast<const ocs2::LinearController&>(*expected.controllerPtr_);
+    const auto& actualController = static_cast<const ocs2::LinearController&>(*actual.controllerPtr_);
+    EXPECT_EQ(expectedController.timeStamp_, actualController.timeStamp_);
+    EXPECT_EQ(expectedController.biasArray_, actualController.biasArray_);
+    EXPECT_EQ(expectedController.gainArray_, actualController.gainArray_);
+  } else {
+    const auto& expectedController = static_cast<const ocs2::FeedforwardController&>(*expected.controllerPtr_);
+    const auto& actualController = static_cast<const ocs2::FeedforwardController&>(*actual.controllerPtr_);
+    EXPECT_EQ(expectedController.timeStamp_, actualController.timeStamp_);
+    EXPECT_EQ(expectedController.uffArray_, actualController.uffArray_);
+  }
+}
+
+/** Whether all values of a policy are equal to its observation time, i.e. the policy is not torn. */
+bool isConsistent(const ocs2::CommandData& command, const ocs2::PrimalSolution& primalSolution,
+                  const ocs2::PerformanceIndex& performanceIndices) {
+  const ocs2::scalar_t value = command.mpcInitObservation_.time;
+  bool isConsistent = performanceIndices.merit == value && primalSolution.timeTrajectory_.front() == value &&
+                      command.mpcTargetTrajectories_.timeTrajectory.front() == value;
+  for (const auto& x : primalSolution.stateTrajectory_) {
+    isConsistent = isConsistent && (x.array() == value).all();
+  }
+  const auto& controller = static_cast<const ocs2::LinearController&>(*primalSolution.controllerPtr_);
+  for (const auto& K : controller.gainArray_) {
+    isConsistent = isConsistent && (K.array() == value).all();
+  }
+  return isConsistent;
+}
+
+}  // unnamed namespace
+
+TEST(testSharedMemoryPolicyChannel, roundTrip) {
+  ocs2::SharedMemoryPolicyWriter writer(getSegmentName(), getLayout());
+  ocs2::SharedMemoryPolicyReader reader(getSegmentName());
+  EXPECT_EQ(reader.getLayout().maxNumNodes, getLayout().maxNumNodes);
+  EXPECT_FALSE(reader.hasNewPolicy());
+
+  ocs2::CommandData command, commandRead;
+  ocs2::PrimalSolution primalSolution, primalSolutionRead;
+  ocs2::PerformanceIndex performanceIndices, performanceIndicesRead;
+  for (const bool isLinear : {true, false, true}) {
+    getPolicy(0.1, isLinear, command, primalSolution, performanceIndices);
+    writer.write(command, primalSolution, performanceIndices);
+    EXPECT_TRUE(reader.hasNewPolicy());
+    ASSERT_TRUE(reader.read(commandRead, primalSolutionRead, performanceIndicesRead));
+    EXPECT_EQ(reader.getSequence(), writer.getSequence());
+
+    expectEqual(primalSolution, primalSolutionRead);
+    EXPECT_EQ(command.mpcInitObservation_.mode, commandRead.mpcInitObservation_.mode);
+    EXPECT_EQ(command.mpcInitObservation_.time, commandRead.mpcInitObservation_.time);
+    EXPECT_EQ(command.mpcInitObservation_.state, commandRead.mpcInitObservation_.state);
+    EXPECT_EQ(command.mpcInitObservation_.input, commandRead.mpcInitObservation_.input);
+    EXPECT_TRUE(commandRead.mpcTargetTrajectories_ == command.mpcTargetTrajectories_);
+    EXPECT_EQ(performanceIndices.merit, performanceIndicesRead.merit);
+
+    // the policy is read only once
+    EXPECT_FALSE(reader.hasNewPolicy());
+    EXPECT_FALSE(reader.read(commandRead, primalSolutionRead, performanceIndicesRead));
+  }
+}
+
+TEST(testSharedMemoryPolicyChannel, invalidPolicy) {
+  ocs2::SharedMemoryPolicyWriter writer(getSegmentName(), getLayout());
+
+  ocs2::CommandData command;
+  ocs2::PrimalSolution primalSolution;
+  ocs2::PerformanceIndex performanceIndices;
+  getPolicy(0.0, true, command, primalSolution, performanceIndices);
+  primalSolution.stateTrajectory_.front().resize(STATE_DIM + 1);
+  EXPECT_THROW(writer.write(command, primalSolution, performanceIndices), std::runtime_error);
+  EXPECT_EQ(writer.getSequence(), 0);
+}
+
+TEST(testSharedMemoryPolicyChannel, missingSegment) {
+  EXPECT_THROW(ocs2::SharedMemoryPolicyReader reader(getSegmentName()), std::runtime_error);
+}
+
+TEST(testSharedMemoryPolicyChannel, twoProcesses) {
+  constexpr size_t numPolicies = 2000;
+  ocs2::SharedMemoryPolicyWriter writer(getSegmentName(), getLayout());
+
+  const pid_t pid = ::fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    // MPC process: publishes the policies
+    ocs2::CommandData command;
+    ocs2::PrimalSolution primalSolution;
+    ocs2::PerformanceIndex performanceIndices;
+    for (size_t i = 0; i < numPolicies; i++) {
+      getPolicy(static_cast<ocs2::scalar_t>(i), true, command, primalSolution, performanceIndices);
+      writer.write(command, primalSolution, performanceIndices);
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    ::_exit(0);  // skip the destructor which would remove the segment
+  }
+
+  // MRT process: reads the policies as they arrive
+  ocs2::SharedMemoryPolicyReader reader(getSegmentName());
+  ocs2::CommandData command;
+  ocs2::PrimalSolution primalSolution;
+  ocs2::PerformanceIndex performanceIndices;
+  size_t numReads = 0;
+  size_t numInconsistentReads = 0;
+  const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (reader.getSequence() < numPolicies && std::chrono::steady_clock::now() < timeout) {
+    if (reader.read(command, primalSolution, performanceIndices)) {
+      ++numReads;
+      if (!isConsistent(command, primalSolution, performanceIndices)) {
+        ++numInconsistentReads;
+      }
+    }
+  }
+
+  int status;
+  ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+  EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  EXPECT_EQ(reader.getSequence(), numPolicies);
+  EXPECT_GT(numReads, 0);
+  EXPECT_EQ(numInconsistentReads, 0);
+}
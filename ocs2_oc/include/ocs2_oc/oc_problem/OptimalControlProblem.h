@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/Types.h>
 //  #include <ocs2_core/augmented_lagrangian/StateAugmentedLagrangianCollection.h>
 //  #include <ocs2_core/augmented_lagrangian/StateInputAugmentedLagrangianCollection.h>
+#include <ocs2_core/constraint/BoxConstraint.h>
 #include <ocs2_core/constraint/StateConstraintCollection.h>
 #include <ocs2_core/constraint/StateInputConstraintCollection.h>
 #include <ocs2_core/cost/StateCostCollection.h>
@@ -76,6 +77,16 @@ struct OptimalControlProblem {
   /** Final equality constraints */
   std::unique_ptr<StateConstraintCollection> finalEqualityConstraintPtr;
 
+  /* Inequality constraints, only supported by the solvers that handle inequalities natively (e.g. the multiple shooting solver) */
+  /** Intermediate inequality constraints, h(x, u, t) >= 0 */
+  std::unique_ptr<StateInputConstraintCollection> inequalityConstraintPtr;
+  /** Final inequality constraints, h(x, t) >= 0 */
+  std::unique_ptr<StateConstraintCollection> finalInequalityConstraintPtr;
+  /** Bounds on the state, applied at all nodes except the initial one */
+  BoxConstraint stateBoxConstraint;
+  /** Bounds on the input */
+  BoxConstraint inputBoxConstraint;
+
   /* Lagrangians */
   /** Lagrangian for intermediate equality constraints */
   std::unique_ptr<StateInputCostCollection> equalityLagrangianPtr;
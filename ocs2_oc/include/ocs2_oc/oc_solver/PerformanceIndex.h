@@ -56,6 +56,12 @@ struct PerformanceIndex {
    */
   scalar_t equalityConstraintsSSE = 0.0;
 
+  /** Sum of Squared Error (SSE) of inequality constraints, violation is the negative part of h >= 0:
+   * - Final: squared norm of violation in state inequality constraints
+   * - Intermediates: Integral of squared norm violation in state-input inequality constraints and bounds
+   */
+  scalar_t inequalityConstraintsSSE = 0.0;
+
   /** Sum of equality Lagrangians:
    * - Final: penalty for violation in state equality constraints
    * - PreJumps: penalty for violation in state equality constraints
@@ -76,6 +82,7 @@ struct PerformanceIndex {
     this->cost += rhs.cost;
     this->dynamicsViolationSSE += rhs.dynamicsViolationSSE;
     this->equalityConstraintsSSE += rhs.equalityConstraintsSSE;
+    this->inequalityConstraintsSSE += rhs.inequalityConstraintsSSE;
     this->equalityLagrangian += rhs.equalityLagrangian;
     this->inequalityLagrangian += rhs.inequalityLagrangian;
     return *this;
@@ -93,6 +100,7 @@ inline void swap(PerformanceIndex& lhs, PerformanceIndex& rhs) {
   std::swap(lhs.cost, rhs.cost);
   std::swap(lhs.dynamicsViolationSSE, rhs.dynamicsViolationSSE);
   std::swap(lhs.equalityConstraintsSSE, rhs.equalityConstraintsSSE);
+  std::swap(lhs.inequalityConstraintsSSE, rhs.inequalityConstraintsSSE);
   std::swap(lhs.equalityLagrangian, rhs.equalityLagrangian);
   std::swap(lhs.inequalityLagrangian, rhs.inequalityLagrangian);
 }
@@ -110,6 +118,9 @@ inline std::ostream& operator<<(std::ostream& stream, const PerformanceIndex& pe
   stream << "Dynamics violation SSE:     " << std::setw(tabSpace) << performanceIndex.dynamicsViolationSSE;
   stream << "Equality constraints SSE:   " << std::setw(tabSpace) << performanceIndex.equalityConstraintsSSE << '\n';
 
+  stream << std::setw(indentation) << "";
+  stream << "Inequality constraints SSE: " << std::setw(tabSpace) << performanceIndex.inequalityConstraintsSSE << '\n';
+
   stream << std::setw(indentation) << "";
   stream << "Equality Lagrangian:        " << std::setw(tabSpace) << performanceIndex.equalityLagrangian;
   stream << "Inequality Lagrangian:      " << std::setw(tabSpace) << performanceIndex.inequalityLagrangian;
@@ -39,6 +39,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 #include <ocs2_oc/oc_solver/PerformanceIndex.h>
+#include <ocs2_oc/oc_solver/TimeBudget.h>
 #include <ocs2_oc/synchronized_module/ReferenceManagerInterface.h>
 #include <ocs2_oc/synchronized_module/SolverSynchronizedModule.h>
 
@@ -88,6 +89,20 @@ class SolverBase {
    */
   void run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const ControllerBase* externalControllerPtr);
 
+  /**
+   * Sets the wall-clock budget of the next calls to run(). When the budget does not suffice for another iteration, the solver
+   * stops early and keeps the best iterate found so far.
+   *
+   * @param [in] budget: The time budget in seconds. A non-positive value removes the limit.
+   */
+  void setTimeBudget(scalar_t budget) { timeBudgetValue_ = budget; }
+
+  /**
+   * Gets the time budget of the latest run, including the time spent in each phase of the solver.
+   */
+  TimeBudget& getTimeBudget() { return timeBudget_; }
+  const TimeBudget& getTimeBudget() const { return timeBudget_; }
+
   /**
    * Sets the ReferenceManager which manages both ModeSchedule and TargetTrajectories. This module updates before SynchronizedModules.
    */
@@ -218,6 +233,8 @@ class SolverBase {
   mutable std::mutex outputDisplayGuardMutex_;
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;  // this pointer cannot be nullptr
   std::vector<std::shared_ptr<SolverSynchronizedModule>> synchronizedModules_;
+  scalar_t timeBudgetValue_ = -1.0;
+  TimeBudget timeBudget_;
 };
 
 }  // namespace ocs2
@@ -0,0 +1,94 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * Wall-clock budget of a single solver run. The solver queries it before starting an iteration or a line-search candidate and
+ * stops early, keeping its best feasible iterate, when the remaining time does not suffice. It also records how much of the
+ * budget each phase of the solver consumed. All times are in seconds.
+ */
+class TimeBudget {
+ public:
+  /**
+   * Starts the clock.
+   *
+   * @param [in] budget: The available time. A non-positive value means the run is not time limited.
+   */
+  void start(scalar_t budget) {
+    budget_ = budget;
+    startTime_ = std::chrono::steady_clock::now();
+    phaseDurations_.clear();
+  }
+
+  /** Whether the run is time limited. */
+  bool isLimited() const { return budget_ > 0.0; }
+
+  /** The time elapsed since start(). */
+  scalar_t getElapsedTime() const { return std::chrono::duration<scalar_t>(std::chrono::steady_clock::now() - startTime_).count(); }
+
+  /** The remaining time. It is infinite if the run is not time limited. */
+  scalar_t getRemainingTime() const {
+    return isLimited() ? budget_ - getElapsedTime() : std::numeric_limits<scalar_t>::infinity();
+  }
+
+  /** Whether a task with the expected duration can still be finished within the budget. */
+  bool hasTimeFor(scalar_t expectedDuration) const { return expectedDuration < getRemainingTime(); }
+
+  /** Whether the budget is used up. */
+  bool isExhausted() const { return !hasTimeFor(0.0); }
+
+  /**
+   * Records the time spent in a phase of the run.
+   *
+   * @param [in] phase: The name of the phase.
+   * @param [in] duration: The time spent in the phase.
+   */
+  void addPhaseDuration(const std::string& phase, scalar_t duration) { phaseDurations_.emplace_back(phase, duration); }
+
+  /** The time spent in each phase of the latest run, in the order of recording. */
+  const std::vector<std::pair<std::string, scalar_t>>& getPhaseDurations() const { return phaseDurations_; }
+
+ private:
+  scalar_t budget_ = -1.0;
+  std::chrono::steady_clock::time_point startTime_ = std::chrono::steady_clock::now();
+  std::vector<std::pair<std::string, scalar_t>> phaseDurations_;
+};
+
+}  // namespace ocs2
@@ -47,6 +47,16 @@ OptimalControlProblem create(const OptimalControlProblem& problem, std::shared_p
       LoopshapingConstraint::create(*problem.preJumpEqualityConstraintPtr, loopshapingDefinition);
   augmentedProblem.finalEqualityConstraintPtr = LoopshapingConstraint::create(*problem.finalEqualityConstraintPtr, loopshapingDefinition);
 
+  // Inequality constraints
+  augmentedProblem.inequalityConstraintPtr = LoopshapingConstraint::create(*problem.inequalityConstraintPtr, loopshapingDefinition);
+  augmentedProblem.finalInequalityConstraintPtr =
+      LoopshapingConstraint::create(*problem.finalInequalityConstraintPtr, loopshapingDefinition);
+  // The system state is the leading part of the augmented state, such that the state bounds carry over.
+  augmentedProblem.stateBoxConstraint = problem.stateBoxConstraint;
+  if (!problem.inputBoxConstraint.empty()) {
+    throw std::runtime_error("[LoopshapingOptimalControlProblem] Input box constraints are not supported with loopshaping.");
+  }
+
   // Lagrangians
   augmentedProblem.equalityLagrangianPtr = LoopshapingSoftConstraint::create(*problem.equalityLagrangianPtr, loopshapingDefinition);
   augmentedProblem.stateEqualityLagrangianPtr =
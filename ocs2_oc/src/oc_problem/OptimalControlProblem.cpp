@@ -50,6 +50,9 @@ OptimalControlProblem::OptimalControlProblem()
       stateEqualityConstraintPtr(new StateConstraintCollection),
       preJumpEqualityConstraintPtr(new StateConstraintCollection),
       finalEqualityConstraintPtr(new StateConstraintCollection),
+      /* Inequality constraints */
+      inequalityConstraintPtr(new StateInputConstraintCollection),
+      finalInequalityConstraintPtr(new StateConstraintCollection),
       /* Lagrangians */
       equalityLagrangianPtr(new StateInputCostCollection),
       stateEqualityLagrangianPtr(new StateCostCollection),
@@ -82,6 +85,11 @@ OptimalControlProblem::OptimalControlProblem(const OptimalControlProblem& other)
       stateEqualityConstraintPtr(other.stateEqualityConstraintPtr->clone()),
       preJumpEqualityConstraintPtr(other.preJumpEqualityConstraintPtr->clone()),
       finalEqualityConstraintPtr(other.finalEqualityConstraintPtr->clone()),
+      /* Inequality constraints */
+      inequalityConstraintPtr(other.inequalityConstraintPtr->clone()),
+      finalInequalityConstraintPtr(other.finalInequalityConstraintPtr->clone()),
+      stateBoxConstraint(other.stateBoxConstraint),
+      inputBoxConstraint(other.inputBoxConstraint),
       /* Lagrangians */
       equalityLagrangianPtr(other.equalityLagrangianPtr->clone()),
       stateEqualityLagrangianPtr(other.stateEqualityLagrangianPtr->clone()),
@@ -130,6 +138,12 @@ void OptimalControlProblem::swap(OptimalControlProblem& other) noexcept {
   preJumpEqualityConstraintPtr.swap(other.preJumpEqualityConstraintPtr);
   finalEqualityConstraintPtr.swap(other.finalEqualityConstraintPtr);
 
+  /* Inequality constraints */
+  inequalityConstraintPtr.swap(other.inequalityConstraintPtr);
+  finalInequalityConstraintPtr.swap(other.finalInequalityConstraintPtr);
+  std::swap(stateBoxConstraint, other.stateBoxConstraint);
+  std::swap(inputBoxConstraint, other.inputBoxConstraint);
+
   /* Lagrangians */
   equalityLagrangianPtr.swap(other.equalityLagrangianPtr);
   stateEqualityLagrangianPtr.swap(other.stateEqualityLagrangianPtr);
@@ -47,6 +47,7 @@ SolverBase::SolverBase() : referenceManagerPtr_(new ReferenceManager) {}
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::run(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  timeBudget_.start(timeBudgetValue_);
   preRun(initTime, initState, finalTime);
   runImpl(initTime, initState, finalTime);
   postRun();
@@ -56,6 +57,7 @@ void SolverBase::run(scalar_t initTime, const vector_t& initState, scalar_t fina
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const ControllerBase* externalControllerPtr) {
+  timeBudget_.start(timeBudgetValue_);
   preRun(initTime, initState, finalTime);
   runImpl(initTime, initState, finalTime, externalControllerPtr);
   postRun();
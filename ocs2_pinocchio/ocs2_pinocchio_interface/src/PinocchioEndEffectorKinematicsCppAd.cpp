@@ -99,15 +99,11 @@ PinocchioEndEffectorKinematicsCppAd::PinocchioEndEffectorKinematicsCppAd(
   orientationErrorCppAdInterfacePtr_.reset(
       new CppAdInterface(orientationFunc, stateDim, 4 * endEffectorFrameIds_.size(), modelName + "_orientation", modelFolder));
 
-  if (recompileLibraries) {
-    positionCppAdInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    velocityCppAdInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    orientationErrorCppAdInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-  } else {
-    positionCppAdInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    velocityCppAdInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    orientationErrorCppAdInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-  }
+  // Compile the libraries concurrently
+  CppAdInterface::loadOrCreateModels({{positionCppAdInterfacePtr_.get(), CppAdInterface::ApproximationOrder::First},
+                                      {velocityCppAdInterfacePtr_.get(), CppAdInterface::ApproximationOrder::First},
+                                      {orientationErrorCppAdInterfacePtr_.get(), CppAdInterface::ApproximationOrder::First}},
+                                     recompileLibraries, verbose);
 }
 
 /******************************************************************************************************/
@@ -29,7 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <limits>
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
 
@@ -40,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /* Forward declaration of pinocchio geometry types */
 namespace pinocchio {
 struct GeometryModel;
+struct GeometryData;
 }  // namespace pinocchio
 
 namespace ocs2 {
@@ -67,8 +71,17 @@ class PinocchioGeometryInterface final {
                              const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs,
                              const std::vector<std::pair<size_t, size_t>>& collisionObjectPairs = std::vector<std::pair<size_t, size_t>>());
 
+  /** Copy constructor. The geometry model is shared, the copy gets its own geometry data and distance buffers. */
+  PinocchioGeometryInterface(const PinocchioGeometryInterface& rhs);
+  PinocchioGeometryInterface(PinocchioGeometryInterface&& rhs) noexcept;
+  PinocchioGeometryInterface& operator=(const PinocchioGeometryInterface&) = delete;
+  PinocchioGeometryInterface& operator=(PinocchioGeometryInterface&&) = delete;
+  ~PinocchioGeometryInterface();
+
   /**
    * Compute collision pair distances
+   * Unlike the overload with an activation distance, this function does not use the buffers of this instance, so it can be called
+   * concurrently.
    *
    * @note Requires pinocchioInterface with updated joint placements by calling forwardKinematics().
    *
@@ -77,6 +90,22 @@ class PinocchioGeometryInterface final {
    */
   std::vector<hpp::fcl::DistanceResult> computeDistances(const PinocchioInterface& pinocchioInterface) const;
 
+  /**
+   * Compute collision pair distances into the buffers of this instance.
+   * A broadphase check compares the bounding spheres of each pair first. If they are further apart than the activation distance, the
+   * narrowphase is skipped and the pair reports the activation distance, which is a lower bound of its distance, with the nearest
+   * points on the bounding spheres. The distances of the other pairs are exact.
+   *
+   * @note Requires pinocchioInterface with updated joint placements by calling forwardKinematics().
+   * @note Not thread-safe, use one copy per thread.
+   *
+   * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @param [in] activationDistance: distance above which pairs are only checked by their bounding spheres.
+   * @return An array of distances between pairs of collision bodies defined in the constructor. Valid until the next call.
+   */
+  const std::vector<hpp::fcl::DistanceResult>& computeDistances(const PinocchioInterface& pinocchioInterface,
+                                                                scalar_t activationDistance) const;
+
   /** Get the number of collision pairs */
   size_t getNumCollisionPairs() const;
 
@@ -91,8 +120,19 @@ class PinocchioGeometryInterface final {
                                const std::vector<std::pair<size_t, size_t>>& collisionObjectPairs);
   void addCollisionLinkPairs(const PinocchioInterface& pinocchioInterface,
                              const std::vector<std::pair<std::string, std::string>>& collisionLinkPairs);
+  void computeBoundingSpheres();
+  void initializeBuffers();
 
   std::shared_ptr<pinocchio::GeometryModel> geometryModelPtr_;
+
+  // Bounding spheres of the geometry objects, expressed in the object frames
+  std::vector<Eigen::Matrix<scalar_t, 3, 1>> boundingSphereCenters_;
+  std::vector<scalar_t> boundingSphereRadii_;
+
+  // Per instance buffers
+  std::unique_ptr<pinocchio::GeometryData> geometryDataPtr_;
+  const hpp::fcl::DistanceRequest distanceRequest_{true};
+  mutable std::vector<hpp::fcl::DistanceResult> distanceResults_;
 };
 
 }  // namespace ocs2
@@ -43,8 +43,13 @@ class SelfCollision {
    *
    * @param [in] pinocchioGeometryInterface: pinocchio geometry interface of the robot model
    * @parma [in] minimumDistance: minimum allowed distance between each collision pair
+   * @param [in] activationDistance: distance above which a pair is inactive. Between the minimum and the activation distance, the
+   *                                 distance is smoothly saturated such that its value and its derivative are continuous, and it is
+   *                                 constant above. The exact distance of a pair is not computed if its bounding spheres are further
+   *                                 apart. Must be larger than the minimum distance.
    */
-  SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance);
+  SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance,
+                scalar_t activationDistance = std::numeric_limits<scalar_t>::infinity());
 
   /** Get the number of collision pairs */
   size_t getNumCollisionPairs() const { return pinocchioGeometryInterface_.getNumCollisionPairs(); }
@@ -74,8 +79,22 @@ class SelfCollision {
   std::pair<vector_t, matrix_t> getLinearApproximation(const PinocchioInterface& pinocchioInterface) const;
 
  private:
+  /**
+   * Saturates the distance between the minimum and the activation distance with a quadratic blend:
+   *   d                                  for d <= minimumDistance
+   *   d - (d - minimumDistance)^2 / 2w   for minimumDistance < d < activationDistance, with w = activationDistance - minimumDistance
+   *   minimumDistance + w / 2            for d >= activationDistance
+   *
+   * @return The saturated distance and its derivative w.r.t. the distance.
+   */
+  std::pair<scalar_t, scalar_t> getCutoffDistance(scalar_t distance) const;
+
   PinocchioGeometryInterface pinocchioGeometryInterface_;
   scalar_t minimumDistance_;
+  scalar_t activationDistance_;
+
+  mutable matrix_t joint1Jacobian_;
+  mutable matrix_t joint2Jacobian_;
 };
 
 }  // namespace ocs2
@@ -38,6 +38,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <pinocchio/multibody/model.hpp>
 #include <pinocchio/parsers/urdf.hpp>
 
+#include <hpp/fcl/distance.h>
+
 #include <urdf_parser/urdf_parser.h>
 
 namespace ocs2 {
@@ -51,6 +53,9 @@ PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface&
   buildGeomFromPinocchioInterface(pinocchioInterface, *geometryModelPtr_);
 
   addCollisionObjectPairs(pinocchioInterface, collisionObjectPairs);
+
+  computeBoundingSpheres();
+  initializeBuffers();
 }
 
 PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface& pinocchioInterface,
@@ -61,12 +66,30 @@ PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioInterface&
 
   addCollisionObjectPairs(pinocchioInterface, collisionObjectPairs);
   addCollisionLinkPairs(pinocchioInterface, collisionLinkPairs);
+
+  computeBoundingSpheres();
+  initializeBuffers();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PinocchioGeometryInterface::PinocchioGeometryInterface(const PinocchioGeometryInterface& rhs)
+    : geometryModelPtr_(rhs.geometryModelPtr_),
+      boundingSphereCenters_(rhs.boundingSphereCenters_),
+      boundingSphereRadii_(rhs.boundingSphereRadii_) {
+  initializeBuffers();
+}
+
+PinocchioGeometryInterface::PinocchioGeometryInterface(PinocchioGeometryInterface&& rhs) noexcept = default;
+
+PinocchioGeometryInterface::~PinocchioGeometryInterface() = default;
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 std::vector<hpp::fcl::DistanceResult> PinocchioGeometryInterface::computeDistances(const PinocchioInterface& pinocchioInterface) const {
+  // Uses its own geometry data, such that it does not share the buffers of this instance.
   pinocchio::GeometryData geometryData(*geometryModelPtr_);
 
   pinocchio::updateGeometryPlacements(pinocchioInterface.getModel(), pinocchioInterface.getData(), *geometryModelPtr_, geometryData);
@@ -75,6 +98,49 @@ std::vector<hpp::fcl::DistanceResult> PinocchioGeometryInterface::computeDistanc
   return std::move(geometryData.distanceResults);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const std::vector<hpp::fcl::DistanceResult>& PinocchioGeometryInterface::computeDistances(const PinocchioInterface& pinocchioInterface,
+                                                                                          scalar_t activationDistance) const {
+  using vector3_t = Eigen::Matrix<scalar_t, 3, 1>;
+
+  const auto& geometryModel = *geometryModelPtr_;
+  auto& geometryData = *geometryDataPtr_;
+  pinocchio::updateGeometryPlacements(pinocchioInterface.getModel(), pinocchioInterface.getData(), geometryModel, geometryData);
+
+  for (size_t i = 0; i < geometryModel.collisionPairs.size(); ++i) {
+    const auto& collisionPair = geometryModel.collisionPairs[i];
+    const auto& placement1 = geometryData.oMg[collisionPair.first];
+    const auto& placement2 = geometryData.oMg[collisionPair.second];
+    auto& result = distanceResults_[i];
+
+    // Broadphase
+    const vector3_t center1 = placement1.act(boundingSphereCenters_[collisionPair.first]);
+    const vector3_t center2 = placement2.act(boundingSphereCenters_[collisionPair.second]);
+    const scalar_t centerDistance = (center2 - center1).norm();
+    const scalar_t radius1 = boundingSphereRadii_[collisionPair.first];
+    const scalar_t radius2 = boundingSphereRadii_[collisionPair.second];
+    if (centerDistance - radius1 - radius2 > activationDistance && centerDistance > 0.0) {
+      // the gap between the bounding spheres is a lower bound of the distance
+      const vector3_t direction = (center2 - center1) / centerDistance;
+      result.min_distance = activationDistance;
+      result.nearest_points[0] = center1 + radius1 * direction;
+      result.nearest_points[1] = center2 - radius2 * direction;
+      continue;
+    }
+
+    // Narrowphase
+    result.clear();
+    const hpp::fcl::Transform3f transform1(placement1.rotation(), placement1.translation());
+    const hpp::fcl::Transform3f transform2(placement2.rotation(), placement2.translation());
+    hpp::fcl::distance(geometryModel.geometryObjects[collisionPair.first].geometry.get(), transform1,
+                       geometryModel.geometryObjects[collisionPair.second].geometry.get(), transform2, distanceRequest_, result);
+  }
+
+  return distanceResults_;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -139,4 +205,29 @@ void PinocchioGeometryInterface::addCollisionLinkPairs(const PinocchioInterface&
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioGeometryInterface::computeBoundingSpheres() {
+  const auto& geometryObjects = geometryModelPtr_->geometryObjects;
+  boundingSphereCenters_.clear();
+  boundingSphereCenters_.reserve(geometryObjects.size());
+  boundingSphereRadii_.clear();
+  boundingSphereRadii_.reserve(geometryObjects.size());
+  for (const auto& object : geometryObjects) {
+    object.geometry->computeLocalAABB();
+    boundingSphereCenters_.push_back(object.geometry->aabb_center);
+    boundingSphereRadii_.push_back(object.geometry->aabb_radius);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioGeometryInterface::initializeBuffers() {
+  geometryDataPtr_.reset(new pinocchio::GeometryData(*geometryModelPtr_));
+
+  distanceResults_.assign(geometryModelPtr_->collisionPairs.size(), hpp::fcl::DistanceResult());
+}
+
 }  // namespace ocs2
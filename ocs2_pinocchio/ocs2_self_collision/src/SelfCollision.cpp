@@ -29,12 +29,12 @@
 
 #include <pinocchio/fwd.hpp>
 
+#include <cmath>
+#include <stdexcept>
+
 #include <pinocchio/algorithm/jacobian.hpp>
 #include <pinocchio/multibody/geometry.hpp>
 
-#include <ocs2_robotic_tools/common/RotationTransforms.h>
-#include <ocs2_robotic_tools/common/SkewSymmetricMatrix.h>
-
 #include <ocs2_self_collision/SelfCollision.h>
 
 namespace ocs2 {
@@ -42,18 +42,24 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-SelfCollision::SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance)
-    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)), minimumDistance_(minimumDistance) {}
+SelfCollision::SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance, scalar_t activationDistance)
+    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)),
+      minimumDistance_(minimumDistance),
+      activationDistance_(activationDistance) {
+  if (activationDistance_ <= minimumDistance_) {
+    throw std::runtime_error("[SelfCollision] activationDistance must be larger than minimumDistance!");
+  }
+}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t SelfCollision::getValue(const PinocchioInterface& pinocchioInterface) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+  const auto& distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface, activationDistance_);
 
   vector_t violations = vector_t::Zero(distanceArray.size());
   for (size_t i = 0; i < distanceArray.size(); ++i) {
-    violations[i] = distanceArray[i].min_distance - minimumDistance_;
+    violations[i] = getCutoffDistance(distanceArray[i].min_distance).first - minimumDistance_;
   }
 
   return violations;
@@ -63,52 +69,77 @@ vector_t SelfCollision::getValue(const PinocchioInterface& pinocchioInterface) c
 /******************************************************************************************************/
 /******************************************************************************************************/
 std::pair<vector_t, matrix_t> SelfCollision::getLinearApproximation(const PinocchioInterface& pinocchioInterface) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+  const auto& distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface, activationDistance_);
 
   const auto& model = pinocchioInterface.getModel();
   const auto& data = pinocchioInterface.getData();
 
   const auto& geometryModel = pinocchioGeometryInterface_.getGeometryModel();
 
+  joint1Jacobian_.resize(6, model.nv);
+  joint2Jacobian_.resize(6, model.nv);
+
   vector_t f(distanceArray.size());
   matrix_t dfdq(distanceArray.size(), model.nq);
   for (size_t i = 0; i < distanceArray.size(); ++i) {
     // Distance violation
-    f[i] = distanceArray[i].min_distance - minimumDistance_;
+    const auto cutoffDistance = getCutoffDistance(distanceArray[i].min_distance);
+    f[i] = cutoffDistance.first - minimumDistance_;
+
+    // An inactive pair has a constant distance
+    if (cutoffDistance.second == 0.0) {
+      dfdq.row(i).setZero();
+      continue;
+    }
 
     // Jacobian calculation
     const auto& collisionPair = geometryModel.collisionPairs[i];
     const auto& joint1 = geometryModel.geometryObjects[collisionPair.first].parentJoint;
     const auto& joint2 = geometryModel.geometryObjects[collisionPair.second].parentJoint;
 
-    // We need to get the jacobian of the point on the first object; use the joint jacobian translated to the point
-    const vector3_t joint1Position = data.oMi[joint1].translation();
-    const vector3_t pt1Offset = distanceArray[i].nearest_points[0] - joint1Position;
-    matrix_t joint1Jacobian = matrix_t::Zero(6, model.nv);
-    pinocchio::getJointJacobian(model, data, joint1, pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, joint1Jacobian);
     // Jacobians from pinocchio are given as
     // [ position jacobian ]
     // [ rotation jacobian ]
-    const matrix_t pt1Jacobian = joint1Jacobian.topRows(3) - skewSymmetricMatrix(pt1Offset) * joint1Jacobian.bottomRows(3);
-
-    // We need to get the jacobian of the point on the second object; use the joint jacobian translated to the point
-    const vector3_t joint2Position = data.oMi[joint2].translation();
-    const vector3_t pt2Offset = distanceArray[i].nearest_points[1] - joint2Position;
-    matrix_t joint2Jacobian = matrix_t::Zero(6, model.nv);
-    pinocchio::getJointJacobian(model, data, joint2, pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, joint2Jacobian);
-    const matrix_t pt2Jacobian = joint2Jacobian.topRows(3) - skewSymmetricMatrix(pt2Offset) * joint2Jacobian.bottomRows(3);
-
-    // To get the (approximate) jacobian of the distance, get the difference between the two nearest point jacobians, then multiply by the
-    // vector from point to point
-    const matrix_t differenceJacobian = pt2Jacobian - pt1Jacobian;
+    joint1Jacobian_.setZero();
+    pinocchio::getJointJacobian(model, data, joint1, pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, joint1Jacobian_);
+    joint2Jacobian_.setZero();
+    pinocchio::getJointJacobian(model, data, joint2, pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, joint2Jacobian_);
+
     // TODO(perry): is there a way to calculate a correct jacobian for the case of distanceVector = 0?
     const vector3_t distanceVector = distanceArray[i].min_distance > 0
                                          ? (distanceArray[i].nearest_points[1] - distanceArray[i].nearest_points[0]).normalized()
                                          : (distanceArray[i].nearest_points[0] - distanceArray[i].nearest_points[1]).normalized();
-    dfdq.row(i).noalias() = distanceVector.transpose() * differenceJacobian;
+
+    // The jacobian of a nearest point is the joint jacobian translated to the point: J_pt = J_pos - [offset]x * J_rot.
+    // The (approximate) jacobian of the distance is the difference between the two nearest point jacobians projected on the vector from
+    // point to point: n^T * (J_pt2 - J_pt1), where n^T * [offset]x = (n x offset)^T.
+    const vector3_t pt1Offset = distanceArray[i].nearest_points[0] - data.oMi[joint1].translation();
+    const vector3_t pt2Offset = distanceArray[i].nearest_points[1] - data.oMi[joint2].translation();
+    const vector3_t pt1Moment = distanceVector.cross(pt1Offset);
+    const vector3_t pt2Moment = distanceVector.cross(pt2Offset);
+    dfdq.row(i).noalias() = distanceVector.transpose() * joint2Jacobian_.topRows<3>();
+    dfdq.row(i).noalias() -= pt2Moment.transpose() * joint2Jacobian_.bottomRows<3>();
+    dfdq.row(i).noalias() -= distanceVector.transpose() * joint1Jacobian_.topRows<3>();
+    dfdq.row(i).noalias() += pt1Moment.transpose() * joint1Jacobian_.bottomRows<3>();
+    dfdq.row(i) *= cutoffDistance.second;
   }  // end of i loop
 
   return {f, dfdq};
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<scalar_t, scalar_t> SelfCollision::getCutoffDistance(scalar_t distance) const {
+  if (distance <= minimumDistance_ || std::isinf(activationDistance_)) {
+    return {distance, 1.0};
+  } else if (distance >= activationDistance_) {
+    return {minimumDistance_ + 0.5 * (activationDistance_ - minimumDistance_), 0.0};
+  } else {
+    const scalar_t width = activationDistance_ - minimumDistance_;
+    const scalar_t offset = distance - minimumDistance_;
+    return {distance - 0.5 * offset * offset / width, 1.0 - offset / width};
+  }
+}
+
 }  // namespace ocs2
@@ -48,13 +48,10 @@ SelfCollisionCppAd::SelfCollisionCppAd(const PinocchioInterface& pinocchioInterf
     : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)), minimumDistance_(minimumDistance) {
   PinocchioInterfaceCppAd pinocchioInterfaceAd = pinocchioInterface.toCppAd();
   setADInterfaces(pinocchioInterfaceAd, modelName, modelFolder);
-  if (recompileLibraries) {
-    cppAdInterfaceDistanceCalculation_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    cppAdInterfaceLinkPoints_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-  } else {
-    cppAdInterfaceDistanceCalculation_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    cppAdInterfaceLinkPoints_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-  }
+  // Compile the libraries concurrently
+  CppAdInterface::loadOrCreateModels({{cppAdInterfaceDistanceCalculation_.get(), CppAdInterface::ApproximationOrder::First},
+                                      {cppAdInterfaceLinkPoints_.get(), CppAdInterface::ApproximationOrder::First}},
+                                     recompileLibraries, verbose);
 }
 
 /******************************************************************************************************/
@@ -70,7 +67,8 @@ SelfCollisionCppAd::SelfCollisionCppAd(const SelfCollisionCppAd& rhs)
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t SelfCollisionCppAd::getValue(const PinocchioInterface& pinocchioInterface) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+  const auto& distanceArray =
+      pinocchioGeometryInterface_.computeDistances(pinocchioInterface, std::numeric_limits<scalar_t>::infinity());
 
   vector_t violations = vector_t::Zero(distanceArray.size());
   for (size_t i = 0; i < distanceArray.size(); ++i) {
@@ -85,7 +83,8 @@ vector_t SelfCollisionCppAd::getValue(const PinocchioInterface& pinocchioInterfa
 /******************************************************************************************************/
 std::pair<vector_t, matrix_t> SelfCollisionCppAd::getLinearApproximation(const PinocchioInterface& pinocchioInterface,
                                                                          const vector_t& q) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+  const auto& distanceArray =
+      pinocchioGeometryInterface_.computeDistances(pinocchioInterface, std::numeric_limits<scalar_t>::infinity());
 
   vector_t pointsInWorldFrame(distanceArray.size() * numberOfParamsPerResult_);
   for (size_t i = 0; i < distanceArray.size(); ++i) {
@@ -156,3 +156,35 @@ TEST_F(TestSelfCollision, testRandomJointPositions) {
     ASSERT_TRUE(Jd1.isApprox(Jd2));
   }
 }
+
+TEST_F(TestSelfCollision, activationDistance) {
+  const scalar_t activationDistance = 0.2;
+  const scalar_t width = activationDistance - minDistance;
+  SelfCollision selfCollision(geometryInterface, minDistance);
+  SelfCollision selfCollisionCulled(geometryInterface, minDistance, activationDistance);
+  ASSERT_THROW(SelfCollision(geometryInterface, minDistance, minDistance), std::runtime_error);
+
+  for (int i = 0; i < 10; i++) {
+    vector_t q = vector_t::Random(9);
+    computeLinearApproximation(pinocchioInterface, q);
+
+    vector_t d1, d2;
+    matrix_t Jd1, Jd2;
+    std::tie(d1, Jd1) = selfCollision.getLinearApproximation(pinocchioInterface);
+    std::tie(d2, Jd2) = selfCollisionCulled.getLinearApproximation(pinocchioInterface);
+    ASSERT_TRUE(d2.isApprox(selfCollisionCulled.getValue(pinocchioInterface)));
+    for (int j = 0; j < d1.size(); j++) {
+      // exact up to the minimum distance, quadratic blend up to the activation distance, and constant above
+      if (d1[j] <= 0.0) {
+        ASSERT_NEAR(d2[j], d1[j], 1e-9);
+        ASSERT_TRUE(Jd2.row(j).isApprox(Jd1.row(j)));
+      } else if (d1[j] < width) {
+        ASSERT_NEAR(d2[j], d1[j] - 0.5 * d1[j] * d1[j] / width, 1e-9);
+        ASSERT_TRUE(Jd2.row(j).isApprox((1.0 - d1[j] / width) * Jd1.row(j)));
+      } else {
+        ASSERT_NEAR(d2[j], 0.5 * width, 1e-9);
+        ASSERT_TRUE(Jd2.row(j).isZero());
+      }
+    }
+  }
+}
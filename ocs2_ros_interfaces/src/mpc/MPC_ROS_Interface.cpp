@@ -287,6 +287,9 @@ void MPC_ROS_Interface::mpcObservationCallback(const ocs2_msgs::mpc_observation:
       createMpcPolicyMsg(*bufferPrimalSolutionPtr_, *bufferCommandPtr_, *bufferPerformanceIndicesPtr_);
   mpcPolicyPublisher_.publish(mpcPolicyMsg);
 #endif
+
+  // use the time until the next observation to prepare the next run
+  mpc_.prepareNextRun();
 }
 
 /******************************************************************************************************/
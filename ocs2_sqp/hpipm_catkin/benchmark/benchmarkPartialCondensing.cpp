@@ -0,0 +1,97 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "hpipm_catkin/HpipmInterface.h"
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+int main() {
+  const int N = 100;
+  const std::vector<int> blockSizes{1, 2, 4, 5, 10, 20};
+  const int numRepetitions = 10;
+
+  // State and input dimensions of the ballbot, the mobile manipulator and the legged robot
+  const std::vector<std::pair<int, int>> problemDimensions{{10, 3}, {9, 9}, {24, 24}};
+
+  for (const auto& dimensions : problemDimensions) {
+    const int nx = dimensions.first;
+    const int nu = dimensions.second;
+    const int nh = 2;
+
+    // Problem setup, x = 0 and u = 0 is strictly feasible for the inequalities and bounds.
+    ocs2::vector_t x0 = ocs2::vector_t::Zero(nx);
+    std::vector<ocs2::VectorFunctionLinearApproximation> system;
+    std::vector<ocs2::VectorFunctionLinearApproximation> ineqConstraints;
+    std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+    std::vector<ocs2::BoxConstraint> inputBoxes;
+    for (int k = 0; k < N; k++) {
+      system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+      system.back().f.setZero();
+      system.back().dfdx *= 0.5;  // stable dynamics over the long horizon
+      cost.emplace_back(ocs2::getRandomCost(nx, nu));
+      ineqConstraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nh));
+      ineqConstraints.back().f.setConstant(1.0);
+      inputBoxes.emplace_back(std::vector<int>{0}, ocs2::vector_t::Constant(1, -0.1), ocs2::vector_t::Constant(1, 0.1));
+    }
+    cost.emplace_back(ocs2::getRandomCost(nx, 0));
+    ineqConstraints.emplace_back(ocs2::getRandomConstraints(nx, 0, nh));
+    ineqConstraints.back().f.setConstant(1.0);
+
+    const auto ocpSize = ocs2::hpipm_interface::extractSizesFromProblem(system, cost, nullptr, &ineqConstraints, nullptr, &inputBoxes);
+
+    for (const auto blockSize : blockSizes) {
+      ocs2::hpipm_interface::Settings settings;
+      settings.partialCondensingBlockSize = blockSize;
+      ocs2::HpipmInterface hpipmInterface(ocpSize, settings);
+
+      std::vector<ocs2::vector_t> xSol;
+      std::vector<ocs2::vector_t> uSol;
+      ocs2::benchmark::RepeatedTimer timer;
+      for (int i = 0; i < numRepetitions; i++) {
+        timer.startTimer();
+        const auto status = hpipmInterface.solve(x0, system, cost, nullptr, &ineqConstraints, nullptr, &inputBoxes, xSol, uSol);
+        timer.endTimer();
+        if (status != hpipm_status::SUCCESS) {
+          std::cerr << "[HpipmInterface] solver failed with status " << status << "\n";
+          return 1;
+        }
+      }
+      std::cout << "[HpipmInterface] nx: " << nx << ", nu: " << nu << ", N: " << N << ", block size: " << blockSize
+                << ", iterations: " << hpipmInterface.getNumIterations() << ", solve time: " << timer.getAverageInMilliseconds()
+                << " [ms]\n";
+    }
+  }
+
+  return 0;
+}
@@ -36,6 +36,7 @@ extern "C" {
 }
 
 #include <ocs2_core/Types.h>
+#include <ocs2_core/constraint/BoxConstraint.h>
 
 #include "hpipm_catkin/HpipmInterfaceSettings.h"
 #include "hpipm_catkin/OcpSize.h"
@@ -51,6 +52,20 @@ class HpipmInterface {
   using OcpSize = hpipm_interface::OcpSize;
   using Settings = hpipm_interface::Settings;
 
+  /**
+   * Primal-dual iterate of HPIPM at a node, in the layout of HPIPM:
+   *  ux = [u; x], where the initial state is not part of node 0,
+   *  pi = multipliers of the dynamics to the next node,
+   *  lam, t = multipliers and slacks of the inequalities [lb; lg; ub; ug; ls; us] of the node.
+   */
+  struct NodeIterate {
+    vector_t ux;
+    vector_t pi;
+    vector_t lam;
+    vector_t t;
+  };
+  using Iterate = std::vector<NodeIterate>;
+
   /**
    * Construct the Hpipm interface with given size and settings.
    * Can directly call solve() for a problem with consistent size.
@@ -63,6 +78,21 @@ class HpipmInterface {
   /** Resize the problem */
   void resize(OcpSize ocpSize);
 
+  /**
+   * Sets the primal-dual iterate from which the next solve starts (HPIPM warm_start = 2). Later solves are started as configured in the
+   * settings again. Has to be called after resize(). Nodes of which the sizes do not match the current OcpSize keep the iterate of the
+   * last solve; at node 0 it is sufficient that ux starts with the inputs. Has no effect with partial condensing.
+   *
+   * @param iterate : Iterate for the N+1 nodes.
+   */
+  void setIterate(const Iterate& iterate);
+
+  /** Gets the primal-dual iterate of the last solve. */
+  void getIterate(Iterate& iterate) const;
+
+  /** Gets the number of interior point iterations of the last solve. */
+  int getNumIterations() const;
+
   /**
    * Solves a discrete linear quadratic optimal control problem. The interface needs to be resized to a consistent OcpSize before calling
    * this function
@@ -87,9 +117,34 @@ class HpipmInterface {
                      std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
                      vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose = false);
 
+  /**
+   * Solves a discrete linear quadratic optimal control problem with inequality and box constraints. The interface needs to be resized to
+   * a consistent OcpSize before calling this function, see extractSizesFromProblem().
+   *
+   * The problem should be consistently defined in absolute or delta decision variables in x and u.
+   *
+   * @param x0 : Initial state (deviation).
+   * @param dynamics : Linearized approximation of the discrete dynamics.
+   * @param cost : Quadratic approximation of the cost.
+   * @param constraints : Linearized approximation of equality constraints, mapped to general inequalities with lg == ug in HPIPM.
+   * @param ineqConstraints : Linearized approximation of inequality constraints (h >= 0), mapped to general inequalities without upper
+   *                          bound in HPIPM.
+   * @param stateBoxConstraints : Bounds on the state (deviation) of the nodes 0 to N. The bounds on the initial state are ignored.
+   * @param inputBoxConstraints : Bounds on the input (deviation) of the nodes 0 to N-1.
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory.
+   * @param verbose : Prints the HPIPM iteration statistics if true.
+   * @return HPIPM returned with flag hpipm_status, see above.
+   */
+  hpipm_status solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
+                     std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
+                     std::vector<VectorFunctionLinearApproximation>* ineqConstraints, std::vector<BoxConstraint>* stateBoxConstraints,
+                     std::vector<BoxConstraint>* inputBoxConstraints, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory,
+                     bool verbose = false);
+
   /**
    * Return the Riccati cost-to-go for the previously solved problem.
-   * Extra information about the initial stage is needed to complete calculation.
+   * Extra information about the initial stage is needed to complete calculation. Not available with partial condensing.
    *
    * Cost-to-go at a node is: V_k(x) = 0.5 * x' * dfdxx * x + x' * dfdx + f
    * For the moment, the value for f is set to 0.0 because it is expensive to compute and often not needed.
@@ -103,7 +158,7 @@ class HpipmInterface {
 
   /**
    * Return the sequence of N feedback matrices for the previously solved problem.
-   * Extra information about the initial stage is needed to complete calculation.
+   * Extra information about the initial stage is needed to complete calculation. Not available with partial condensing.
    *
    * @param dynamics0 : dynamics at k = 0
    * @param cost0 : cost at k = 0
@@ -113,7 +168,7 @@ class HpipmInterface {
 
   /**
    * Return the sequence of N feedforward input vectors for the previously solved problem.
-   * Extra information about the initial stage is needed to complete calculation.
+   * Extra information about the initial stage is needed to complete calculation. Not available with partial condensing.
    *
    * @param dynamics0 : dynamics at k = 0
    * @param cost0 : cost at k = 0
@@ -54,6 +54,7 @@ struct Settings {
   int warm_start = 0;
   int pred_corr = 1;
   int ric_alg = 0;  // square root ricatti recursion
+  int partialCondensingBlockSize = 1;  // number of stages condensed into one before solving, 1 solves the full-length OCP
 };
 
 std::ostream& operator<<(std::ostream& stream, const Settings& settings);
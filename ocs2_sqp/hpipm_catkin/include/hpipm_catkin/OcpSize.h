@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 
 #include <ocs2_core/Types.h>
+#include <ocs2_core/constraint/BoxConstraint.h>
 
 namespace ocs2 {
 namespace hpipm_interface {
@@ -88,5 +89,23 @@ OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximat
                                 const std::vector<ScalarFunctionQuadraticApproximation>& cost,
                                 const std::vector<VectorFunctionLinearApproximation>* constraints);
 
+/**
+ * Extract sizes based on the problem data, including inequality and box constraints.
+ *
+ * @param dynamics : Linearized approximation of the discrete dynamics.
+ * @param cost : Quadratic approximation of the cost.
+ * @param constraints : Linearized approximation of equality constraints.
+ * @param ineqConstraints : Linearized approximation of inequality constraints (h >= 0).
+ * @param stateBoxConstraints : Bounds on the state (deviation) for nodes 0 to N.
+ * @param inputBoxConstraints : Bounds on the input (deviation) for nodes 0 to N-1.
+ * @return Derived sizes, the equality and inequality constraints of a node are both counted as general inequality constraints.
+ */
+OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                                const std::vector<VectorFunctionLinearApproximation>* constraints,
+                                const std::vector<VectorFunctionLinearApproximation>* ineqConstraints,
+                                const std::vector<BoxConstraint>* stateBoxConstraints,
+                                const std::vector<BoxConstraint>* inputBoxConstraints);
+
 }  // namespace hpipm_interface
 }  // namespace ocs2
\ No newline at end of file
@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "hpipm_catkin/HpipmInterface.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include <ocs2_core/misc/LinearAlgebra.h>
 
 extern "C" {
@@ -36,6 +39,7 @@ extern "C" {
 #include <hpipm_d_ocp_qp_dim.h>
 #include <hpipm_d_ocp_qp_ipm.h>
 #include <hpipm_d_ocp_qp_sol.h>
+#include <hpipm_d_part_cond.h>
 #include <hpipm_timing.h>
 }
 
@@ -81,6 +85,38 @@ class MemoryBlock {
   void* ptr_;
   size_t size_;
 };
+
+/**
+ * Copy of the bounds of a box constraint, where the infinite bounds are set to zero and masked out.
+ */
+struct MaskedBox {
+  MaskedBox() = default;
+
+  explicit MaskedBox(const ocs2::BoxConstraint& box)
+      : lowerBound(box.lowerBound),
+        upperBound(box.upperBound),
+        lowerMask(ocs2::vector_t::Ones(box.size())),
+        upperMask(ocs2::vector_t::Ones(box.size())) {
+    for (int i = 0; i < box.size(); i++) {
+      if (!std::isfinite(lowerBound[i])) {
+        lowerBound[i] = 0.0;
+        lowerMask[i] = 0.0;
+        hasInfiniteBounds = true;
+      }
+      if (!std::isfinite(upperBound[i])) {
+        upperBound[i] = 0.0;
+        upperMask[i] = 0.0;
+        hasInfiniteBounds = true;
+      }
+    }
+  }
+
+  ocs2::vector_t lowerBound;
+  ocs2::vector_t upperBound;
+  ocs2::vector_t lowerMask;
+  ocs2::vector_t upperMask;
+  bool hasInfiniteBounds = false;
+};
 }  // namespace
 
 namespace ocs2 {
@@ -93,6 +129,8 @@ class HpipmInterface::Impl {
     // We will remove the initial state from the decision variables before passing the data to HPIPM.
     // This removes the need for adding constraints to enforce x[0] = x_init
     ocpSize.numStates[0] = 0;
+    ocpSize.numStateBoxConstraints[0] = 0;
+    ocpSize.numStateBoxSlack[0] = 0;
 
     // Skip memory initialization if problem size didn't change.
     if (!forceInitialization && ocpSize_ == ocpSize) {
@@ -100,6 +138,7 @@ class HpipmInterface::Impl {
     }
 
     ocpSize_ = std::move(ocpSize);
+    isIterateSet_ = false;
 
     const int dim_size = d_ocp_qp_dim_memsize(ocpSize_.numStages);
     dimMem_.reserve(dim_size);
@@ -116,16 +155,60 @@ class HpipmInterface::Impl {
     qpSolMem_.reserve(qp_sol_size);
     d_ocp_qp_sol_create(&dim_, &qpSol_, qpSolMem_.get());
 
-    const int ipm_arg_size = d_ocp_qp_ipm_arg_memsize(&dim_);
+    // The IPM either solves the full-length OCP or the partially condensed one
+    d_ocp_qp_dim* ipmDim = &dim_;
+    initializePartialCondensingMemory();
+    if (isPartiallyCondensed_) {
+      ipmDim = &condDim_;
+    }
+
+    const int ipm_arg_size = d_ocp_qp_ipm_arg_memsize(ipmDim);
     ipmArgMem_.reserve(ipm_arg_size);
-    d_ocp_qp_ipm_arg_create(&dim_, &arg_, ipmArgMem_.get());
+    d_ocp_qp_ipm_arg_create(ipmDim, &arg_, ipmArgMem_.get());
 
     applySettings(settings_);
 
     // Setup workspace after applying the settings
-    const int ipm_size = d_ocp_qp_ipm_ws_memsize(&dim_, &arg_);
+    const int ipm_size = d_ocp_qp_ipm_ws_memsize(ipmDim, &arg_);
     ipmMem_.reserve(ipm_size);
-    d_ocp_qp_ipm_ws_create(&dim_, &arg_, &workspace_, ipmMem_.get());
+    d_ocp_qp_ipm_ws_create(ipmDim, &arg_, &workspace_, ipmMem_.get());
+  }
+
+  /** Sets up the partially condensed OCP with numStages / partialCondensingBlockSize stages (rounded up) if that reduces the stages. */
+  void initializePartialCondensingMemory() {
+    const int N = ocpSize_.numStages;
+    const int blockSize = std::max(settings_.partialCondensingBlockSize, 1);
+    const int N2 = (N + blockSize - 1) / blockSize;
+    isPartiallyCondensed_ = N2 < N;
+    if (!isPartiallyCondensed_) {
+      return;
+    }
+
+    blockSize_.resize(N2 + 1);
+    d_part_cond_qp_compute_block_size(N, N2, blockSize_.data());
+
+    const int cond_dim_size = d_ocp_qp_dim_memsize(N2);
+    condDimMem_.reserve(cond_dim_size);
+    d_ocp_qp_dim_create(N2, &condDim_, condDimMem_.get());
+    d_part_cond_qp_compute_dim(&dim_, blockSize_.data(), &condDim_);
+
+    const int cond_qp_size = d_ocp_qp_memsize(&condDim_);
+    condQpMem_.reserve(cond_qp_size);
+    d_ocp_qp_create(&condDim_, &condQp_, condQpMem_.get());
+
+    const int cond_qp_sol_size = d_ocp_qp_sol_memsize(&condDim_);
+    condQpSolMem_.reserve(cond_qp_sol_size);
+    d_ocp_qp_sol_create(&condDim_, &condQpSol_, condQpSolMem_.get());
+
+    const int part_cond_arg_size = d_part_cond_qp_arg_memsize(N2);
+    partCondArgMem_.reserve(part_cond_arg_size);
+    d_part_cond_qp_arg_create(N2, &partCondArg_, partCondArgMem_.get());
+    d_part_cond_qp_arg_set_default(&partCondArg_);
+    d_part_cond_qp_arg_set_ric_alg(settings_.ric_alg, &partCondArg_);
+
+    const int part_cond_size = d_part_cond_qp_ws_memsize(&dim_, blockSize_.data(), &condDim_, &partCondArg_);
+    partCondMem_.reserve(part_cond_size);
+    d_part_cond_qp_ws_create(&dim_, blockSize_.data(), &condDim_, &partCondArg_, &partCondWorkspace_, partCondMem_.get());
   }
 
   void applySettings(Settings& settings) {
@@ -144,8 +227,9 @@ class HpipmInterface::Impl {
   }
 
   void verifySizes(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
-                   std::vector<ScalarFunctionQuadraticApproximation>& cost,
-                   std::vector<VectorFunctionLinearApproximation>* constraints) const {
+                   std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
+                   std::vector<VectorFunctionLinearApproximation>* ineqConstraints, std::vector<BoxConstraint>* stateBoxConstraints,
+                   std::vector<BoxConstraint>* inputBoxConstraints) const {
     if (dynamics.size() != ocpSize_.numStages) {
       throw std::runtime_error("[HpipmInterface] Inconsistent size of dynamics: " + std::to_string(dynamics.size()) + " with " +
                                std::to_string(ocpSize_.numStages) + " number of stages.");
@@ -160,14 +244,35 @@ class HpipmInterface::Impl {
                                  std::to_string(ocpSize_.numStages + 1) + " nodes.");
       }
     }
+    if (ineqConstraints != nullptr) {
+      if (ineqConstraints->size() != ocpSize_.numStages + 1) {
+        throw std::runtime_error("[HpipmInterface] Inconsistent size of inequality constraints: " +
+                                 std::to_string(ineqConstraints->size()) + " with " + std::to_string(ocpSize_.numStages + 1) + " nodes.");
+      }
+    }
+    if (stateBoxConstraints != nullptr) {
+      if (stateBoxConstraints->size() != ocpSize_.numStages + 1) {
+        throw std::runtime_error("[HpipmInterface] Inconsistent size of state box constraints: " +
+                                 std::to_string(stateBoxConstraints->size()) + " with " + std::to_string(ocpSize_.numStages + 1) +
+                                 " nodes.");
+      }
+    }
+    if (inputBoxConstraints != nullptr) {
+      if (inputBoxConstraints->size() != ocpSize_.numStages) {
+        throw std::runtime_error("[HpipmInterface] Inconsistent size of input box constraints: " +
+                                 std::to_string(inputBoxConstraints->size()) + " with " + std::to_string(ocpSize_.numStages) + " stages.");
+      }
+    }
     // TODO: expand with state-input size checks
   }
 
   hpipm_status solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
                      std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
-                     vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose) {
+                     std::vector<VectorFunctionLinearApproximation>* ineqConstraints, std::vector<BoxConstraint>* stateBoxConstraints,
+                     std::vector<BoxConstraint>* inputBoxConstraints, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory,
+                     bool verbose) {
     const int N = ocpSize_.numStages;
-    verifySizes(x0, dynamics, cost, constraints);
+    verifySizes(x0, dynamics, cost, constraints, ineqConstraints, stateBoxConstraints, inputBoxConstraints);
 
     // === Dynamics ===
     std::vector<scalar_t*> AA(N, nullptr);
@@ -221,55 +326,82 @@ class HpipmInterface::Impl {
     qq[N] = cost[N].dfdx.data();
 
     // === Constraints ===
-    // for ocs2 --> C*dx + D*du + e = 0
+    // for ocs2 --> C*dx + D*du + e = 0 (equalities)
+    //              C*dx + D*du + e >= 0 (inequalities)
     // for hpipm --> ug >= C*dx + D*du >= lg
+    // The equalities are stacked on top of the inequalities. The upper bound of the inequalities is masked out after setting the QP.
     std::vector<scalar_t*> CC(N + 1, nullptr);
     std::vector<scalar_t*> DD(N + 1, nullptr);
     std::vector<scalar_t*> llg(N + 1, nullptr);
     std::vector<scalar_t*> uug(N + 1, nullptr);
     std::vector<ocs2::vector_t> boundData;  // Declare at this scope to keep the data alive while HPIPM has the pointers
 
-    if (constraints != nullptr) {
-      auto& constr = *constraints;
+    if (constraints != nullptr || ineqConstraints != nullptr) {
       boundData.resize(N + 1);
+      stackedConstraints_.resize(N + 1);
+
+      for (int k = 0; k <= N; k++) {
+        VectorFunctionLinearApproximation* constr = getGeneralConstraints(k, constraints, ineqConstraints);
+        if (constr == nullptr || constr->f.size() == 0) {
+          continue;
+        }
 
-      // k = 0, eliminate initial state
-      // numState[0] = 0 --> No need to specify C[0] here
-      if (constr[0].f.size() > 0) {
-        boundData[0] = -constr[0].f;
-        boundData[0].noalias() -= constr[0].dfdx * x0;
-        llg[0] = boundData[0].data();
-        uug[0] = boundData[0].data();
-        DD[0] = constr[0].dfdu.data();
+        boundData[k] = -constr->f;
+        if (k == 0) {
+          // k = 0, eliminate initial state
+          // numState[0] = 0 --> No need to specify C[0] here
+          boundData[0].noalias() -= constr->dfdx * x0;
+        } else {
+          CC[k] = constr->dfdx.data();
+        }
+        if (k < N) {  // k = N, no inputs
+          DD[k] = constr->dfdu.data();
+        }
+        llg[k] = boundData[k].data();
+        uug[k] = boundData[k].data();
       }
+    }
 
-      // k = 1 -> (N-1)
-      for (int k = 1; k < N; k++) {
-        if (constr[k].f.size() > 0) {
-          CC[k] = constr[k].dfdx.data();
-          DD[k] = constr[k].dfdu.data();
-          boundData[k] = -constr[k].f;
-          llg[k] = boundData[k].data();
-          uug[k] = boundData[k].data();
+    // === Box constraints ===
+    // for hpipm --> ubx >= x[idxbx] >= lbx, ubu >= u[idxbu] >= lbu
+    // Infinite bounds are masked out after setting the QP.
+    std::vector<int*> idxbx(N + 1, nullptr);
+    std::vector<scalar_t*> lbx(N + 1, nullptr);
+    std::vector<scalar_t*> ubx(N + 1, nullptr);
+    std::vector<int*> idxbu(N + 1, nullptr);
+    std::vector<scalar_t*> lbu(N + 1, nullptr);
+    std::vector<scalar_t*> ubu(N + 1, nullptr);
+    std::vector<MaskedBox> stateBoxData;  // Declare at this scope to keep the data alive while HPIPM has the pointers
+    std::vector<MaskedBox> inputBoxData;
+
+    if (stateBoxConstraints != nullptr) {
+      stateBoxData.resize(N + 1);
+      // k = 0, the initial state is not a decision variable.
+      for (int k = 1; k <= N; k++) {
+        auto& box = (*stateBoxConstraints)[k];
+        if (!box.empty()) {
+          stateBoxData[k] = MaskedBox(box);
+          idxbx[k] = box.indices.data();
+          lbx[k] = stateBoxData[k].lowerBound.data();
+          ubx[k] = stateBoxData[k].upperBound.data();
         }
       }
+    }
 
-      // k = N, no inputs
-      if (constr[N].f.size() > 0) {
-        CC[N] = constr[N].dfdx.data();
-        boundData[N] = -constr[N].f;
-        llg[N] = boundData[N].data();
-        uug[N] = boundData[N].data();
+    if (inputBoxConstraints != nullptr) {
+      inputBoxData.resize(N);
+      for (int k = 0; k < N; k++) {
+        auto& box = (*inputBoxConstraints)[k];
+        if (!box.empty()) {
+          inputBoxData[k] = MaskedBox(box);
+          idxbu[k] = box.indices.data();
+          lbu[k] = inputBoxData[k].lowerBound.data();
+          ubu[k] = inputBoxData[k].upperBound.data();
+        }
       }
     }
 
     // === Unused ===
-    int** hidxbx = nullptr;
-    scalar_t** hlbx = nullptr;
-    scalar_t** hubx = nullptr;
-    int** hidxbu = nullptr;
-    scalar_t** hlbu = nullptr;
-    scalar_t** hubu = nullptr;
     scalar_t** hZl = nullptr;
     scalar_t** hZu = nullptr;
     scalar_t** hzl = nullptr;
@@ -279,9 +411,53 @@ class HpipmInterface::Impl {
     scalar_t** hlus = nullptr;
 
     // === Set and solve ===
-    d_ocp_qp_set_all(AA.data(), BB.data(), bb.data(), QQ.data(), SS.data(), RR.data(), qq.data(), rr.data(), hidxbx, hlbx, hubx, hidxbu,
-                     hlbu, hubu, CC.data(), DD.data(), llg.data(), uug.data(), hZl, hZu, hzl, hzu, hidxs, hlls, hlus, &qp_);
-    d_ocp_qp_ipm_solve(&qp_, &qpSol_, &arg_, &workspace_);
+    d_ocp_qp_set_all(AA.data(), BB.data(), bb.data(), QQ.data(), SS.data(), RR.data(), qq.data(), rr.data(), idxbx.data(), lbx.data(),
+                     ubx.data(), idxbu.data(), lbu.data(), ubu.data(), CC.data(), DD.data(), llg.data(), uug.data(), hZl, hZu, hzl, hzu,
+                     hidxs, hlls, hlus, &qp_);
+
+    // The masks are reset by d_ocp_qp_set_all
+    if (ineqConstraints != nullptr) {
+      vector_t ugMask;
+      for (int k = 0; k <= N; k++) {
+        const int numIneq = (*ineqConstraints)[k].f.size();
+        if (numIneq > 0) {
+          ugMask.setOnes(ocpSize_.numIneqConstraints[k]);
+          ugMask.tail(numIneq).setZero();
+          d_ocp_qp_set_ug_mask(k, ugMask.data(), &qp_);
+        }
+      }
+    }
+    for (int k = 1; k < stateBoxData.size(); k++) {
+      if (stateBoxData[k].hasInfiniteBounds) {
+        d_ocp_qp_set_lbx_mask(k, stateBoxData[k].lowerMask.data(), &qp_);
+        d_ocp_qp_set_ubx_mask(k, stateBoxData[k].upperMask.data(), &qp_);
+      }
+    }
+    for (int k = 0; k < inputBoxData.size(); k++) {
+      if (inputBoxData[k].hasInfiniteBounds) {
+        d_ocp_qp_set_lbu_mask(k, inputBoxData[k].lowerMask.data(), &qp_);
+        d_ocp_qp_set_ubu_mask(k, inputBoxData[k].upperMask.data(), &qp_);
+      }
+    }
+
+    if (isIterateSet_) {
+      int warmStart = 2;
+      d_ocp_qp_ipm_arg_set_warm_start(&warmStart, &arg_);
+    }
+
+    if (isPartiallyCondensed_) {
+      // Solve the condensed OCP and recover the solution of all stages
+      d_part_cond_qp_cond(&qp_, &condQp_, &partCondArg_, &partCondWorkspace_);
+      d_ocp_qp_ipm_solve(&condQp_, &condQpSol_, &arg_, &workspace_);
+      d_part_cond_qp_expand_sol(&qp_, &condQp_, &condQpSol_, &qpSol_, &partCondArg_, &partCondWorkspace_);
+    } else {
+      d_ocp_qp_ipm_solve(&qp_, &qpSol_, &arg_, &workspace_);
+    }
+
+    if (isIterateSet_) {
+      d_ocp_qp_ipm_arg_set_warm_start(&settings_.warm_start, &arg_);
+      isIterateSet_ = false;
+    }
 
     if (verbose) {
       printStatus();
@@ -300,6 +476,88 @@ class HpipmInterface::Impl {
     return hpipm_status(hpipmStatus);
   }
 
+  /** Number of multipliers and slacks of node k: lower and upper bounds of the box, general and soft constraints. */
+  int getNumInequalities(int k) const {
+    const int numBoxes = ocpSize_.numInputBoxConstraints[k] + ocpSize_.numStateBoxConstraints[k];
+    const int numSlacks = ocpSize_.numInputBoxSlack[k] + ocpSize_.numStateBoxSlack[k] + ocpSize_.numIneqSlack[k];
+    return 2 * (numBoxes + ocpSize_.numIneqConstraints[k] + numSlacks);
+  }
+
+  // The solution vectors of HPIPM are accessed directly, as there are no setters for the multipliers and slacks.
+  void setIterate(const Iterate& iterate) {
+    if (isPartiallyCondensed_) {
+      return;  // The IPM iterates on the condensed OCP, for which the given iterate is not in the right layout.
+    }
+
+    const int N = ocpSize_.numStages;
+    for (int k = 0; k <= N && k < iterate.size(); k++) {
+      const auto& node = iterate[k];
+      const int numUx = ocpSize_.numInputs[k] + ocpSize_.numStates[k];
+      if (node.ux.size() == numUx || (k == 0 && node.ux.size() >= numUx)) {
+        Eigen::Map<vector_t>(qpSol_.ux[k].pa, numUx) = node.ux.head(numUx);
+      }
+      if (k < N && node.pi.size() == ocpSize_.numStates[k + 1]) {
+        Eigen::Map<vector_t>(qpSol_.pi[k].pa, node.pi.size()) = node.pi;
+      }
+      const int numIneq = getNumInequalities(k);
+      if (node.lam.size() == numIneq && node.t.size() == numIneq) {
+        Eigen::Map<vector_t>(qpSol_.lam[k].pa, numIneq) = node.lam;
+        Eigen::Map<vector_t>(qpSol_.t[k].pa, numIneq) = node.t;
+      }
+    }
+    isIterateSet_ = true;
+  }
+
+  void getIterate(Iterate& iterate) const {
+    const int N = ocpSize_.numStages;
+    iterate.resize(N + 1);
+    for (int k = 0; k <= N; k++) {
+      auto& node = iterate[k];
+      node.ux = Eigen::Map<const vector_t>(qpSol_.ux[k].pa, ocpSize_.numInputs[k] + ocpSize_.numStates[k]);
+      if (k < N) {
+        node.pi = Eigen::Map<const vector_t>(qpSol_.pi[k].pa, ocpSize_.numStates[k + 1]);
+      } else {
+        node.pi.resize(0);
+      }
+      const int numIneq = getNumInequalities(k);
+      node.lam = Eigen::Map<const vector_t>(qpSol_.lam[k].pa, numIneq);
+      node.t = Eigen::Map<const vector_t>(qpSol_.t[k].pa, numIneq);
+    }
+  }
+
+  int getNumIterations() {
+    int iter = 0;
+    d_ocp_qp_ipm_get_iter(&workspace_, &iter);
+    return iter;
+  }
+
+  /**
+   * Returns the general constraints of node k: the equality constraints stacked on top of the inequality constraints. Without
+   * inequalities the equality constraints are returned as is, otherwise the stacked constraints are written to stackedConstraints_.
+   */
+  VectorFunctionLinearApproximation* getGeneralConstraints(int k, std::vector<VectorFunctionLinearApproximation>* constraints,
+                                                           std::vector<VectorFunctionLinearApproximation>* ineqConstraints) {
+    const int numEq = (constraints != nullptr) ? (*constraints)[k].f.size() : 0;
+    const int numIneq = (ineqConstraints != nullptr) ? (*ineqConstraints)[k].f.size() : 0;
+    if (numIneq == 0) {
+      return (constraints != nullptr) ? &(*constraints)[k] : nullptr;
+    } else if (numEq == 0) {
+      return &(*ineqConstraints)[k];
+    }
+
+    const auto& eq = (*constraints)[k];
+    const auto& ineq = (*ineqConstraints)[k];
+    auto& stacked = stackedConstraints_[k];
+    stacked.resize(numEq + numIneq, eq.dfdx.cols(), eq.dfdu.cols());
+    stacked.f.head(numEq) = eq.f;
+    stacked.f.tail(numIneq) = ineq.f;
+    stacked.dfdx.topRows(numEq) = eq.dfdx;
+    stacked.dfdx.bottomRows(numIneq) = ineq.dfdx;
+    stacked.dfdu.topRows(numEq) = eq.dfdu;
+    stacked.dfdu.bottomRows(numIneq) = ineq.dfdu;
+    return &stacked;
+  }
+
   bool getStateSolution(const vector_t& x0, vector_array_t& stateTrajectory) {
     stateTrajectory.resize(ocpSize_.numStages + 1);
     stateTrajectory.front() = x0;
@@ -327,7 +585,15 @@ class HpipmInterface::Impl {
     return true;
   }
 
+  /** The Riccati factorization in the workspace belongs to the condensed OCP with partial condensing. */
+  void checkRiccatiFactorization() const {
+    if (isPartiallyCondensed_) {
+      throw std::runtime_error("[HpipmInterface] The Riccati factorization is not available with partial condensing.");
+    }
+  }
+
   matrix_array_t getRiccatiFeedback(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0) {
+    checkRiccatiFactorization();
     const int N = ocpSize_.numStages;
     matrix_array_t RiccatiFeedback(N);
 
@@ -367,6 +633,7 @@ class HpipmInterface::Impl {
 
   vector_array_t getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0,
                                        const ScalarFunctionQuadraticApproximation& cost0) {
+    checkRiccatiFactorization();
     const int N = ocpSize_.numStages;
     vector_array_t RiccatiFeedforward(N);
 
@@ -402,6 +669,7 @@ class HpipmInterface::Impl {
     /*
      * Note on notation: HPIPM uses P, p for the cost-to-go, where we use Sm, sv
      */
+    checkRiccatiFactorization();
     const int N = ocpSize_.numStages;
     std::vector<ScalarFunctionQuadraticApproximation> RiccatiCostToGo(N + 1);
 
@@ -506,6 +774,8 @@ class HpipmInterface::Impl {
   Settings settings_;
   OcpSize ocpSize_;
 
+  std::vector<VectorFunctionLinearApproximation> stackedConstraints_;  // equality and inequality constraints of the nodes with both
+
   MemoryBlock dimMem_;
   d_ocp_qp_dim dim_;
 
@@ -514,6 +784,26 @@ class HpipmInterface::Impl {
 
   MemoryBlock qpSolMem_;
   d_ocp_qp_sol qpSol_;
+  bool isIterateSet_ = false;  // true if the next solve starts from the iterate in qpSol_
+
+  // Partially condensed OCP, used instead of the full-length OCP if isPartiallyCondensed_
+  bool isPartiallyCondensed_ = false;
+  std::vector<int> blockSize_;  // number of stages per condensed stage
+
+  MemoryBlock condDimMem_;
+  d_ocp_qp_dim condDim_;
+
+  MemoryBlock condQpMem_;
+  d_ocp_qp condQp_;
+
+  MemoryBlock condQpSolMem_;
+  d_ocp_qp_sol condQpSol_;
+
+  MemoryBlock partCondArgMem_;
+  d_part_cond_qp_arg partCondArg_;
+
+  MemoryBlock partCondMem_;
+  d_part_cond_qp_ws partCondWorkspace_;
 
   MemoryBlock ipmArgMem_;
   d_ocp_qp_ipm_arg arg_;
@@ -531,11 +821,33 @@ void HpipmInterface::resize(OcpSize ocpSize) {
   pImpl_->initializeMemory(std::move(ocpSize));
 }
 
+void HpipmInterface::setIterate(const Iterate& iterate) {
+  pImpl_->setIterate(iterate);
+}
+
+void HpipmInterface::getIterate(Iterate& iterate) const {
+  pImpl_->getIterate(iterate);
+}
+
+int HpipmInterface::getNumIterations() const {
+  return pImpl_->getNumIterations();
+}
+
 hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
                                    std::vector<ScalarFunctionQuadraticApproximation>& cost,
                                    std::vector<VectorFunctionLinearApproximation>* constraints, vector_array_t& stateTrajectory,
                                    vector_array_t& inputTrajectory, bool verbose) {
-  return pImpl_->solve(x0, dynamics, cost, constraints, stateTrajectory, inputTrajectory, verbose);
+  return pImpl_->solve(x0, dynamics, cost, constraints, nullptr, nullptr, nullptr, stateTrajectory, inputTrajectory, verbose);
+}
+
+hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                   std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                                   std::vector<VectorFunctionLinearApproximation>* constraints,
+                                   std::vector<VectorFunctionLinearApproximation>* ineqConstraints,
+                                   std::vector<BoxConstraint>* stateBoxConstraints, std::vector<BoxConstraint>* inputBoxConstraints,
+                                   vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose) {
+  return pImpl_->solve(x0, dynamics, cost, constraints, ineqConstraints, stateBoxConstraints, inputBoxConstraints, stateTrajectory,
+                       inputTrajectory, verbose);
 }
 
 std::vector<ScalarFunctionQuadraticApproximation> HpipmInterface::getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0,
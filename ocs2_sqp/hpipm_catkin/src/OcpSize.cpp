@@ -71,5 +71,37 @@ OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximat
   return problemSize;
 }
 
+OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                                const std::vector<VectorFunctionLinearApproximation>* constraints,
+                                const std::vector<VectorFunctionLinearApproximation>* ineqConstraints,
+                                const std::vector<BoxConstraint>* stateBoxConstraints,
+                                const std::vector<BoxConstraint>* inputBoxConstraints) {
+  const int numStages = dynamics.size();
+
+  OcpSize problemSize = extractSizesFromProblem(dynamics, cost, constraints);
+
+  // Inequality constraints are stacked below the equality constraints
+  if (ineqConstraints != nullptr) {
+    for (int k = 0; k < numStages + 1; k++) {
+      problemSize.numIneqConstraints[k] += (*ineqConstraints)[k].f.size();
+    }
+  }
+
+  // Box constraints
+  if (stateBoxConstraints != nullptr) {
+    for (int k = 0; k < numStages + 1; k++) {
+      problemSize.numStateBoxConstraints[k] = (*stateBoxConstraints)[k].size();
+    }
+  }
+  if (inputBoxConstraints != nullptr) {
+    for (int k = 0; k < numStages; k++) {
+      problemSize.numInputBoxConstraints[k] = (*inputBoxConstraints)[k].size();
+    }
+  }
+
+  return problemSize;
+}
+
 }  // namespace hpipm_interface
 }  // namespace ocs2
\ No newline at end of file
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <limits>
+
 #include "hpipm_catkin/HpipmInterface.h"
 
 #include <ocs2_core/test/testTools.h>
@@ -205,6 +207,173 @@ TEST(test_hpiphm_interface, with_constraints) {
   }
 }
 
+TEST(test_hpiphm_interface, with_inequalities_and_boxes) {
+  // Initialize without size
+  ocs2::HpipmInterface hpipmInterface;
+
+  int nx = 3;
+  int nu = 2;
+  int nc = 1;
+  int nh = 2;
+  int N = 5;
+  const ocs2::scalar_t infinity = std::numeric_limits<ocs2::scalar_t>::infinity();
+  const ocs2::scalar_t tol = 1e-6;
+
+  // Problem setup, x = 0 and u = 0 is strictly feasible for the inequalities and bounds.
+  ocs2::vector_t x0 = ocs2::vector_t::Zero(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+  std::vector<ocs2::VectorFunctionLinearApproximation> ineqConstraints;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  std::vector<ocs2::BoxConstraint> stateBoxes;
+  std::vector<ocs2::BoxConstraint> inputBoxes;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    system.back().f.setZero();
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    constraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nc));
+    constraints.back().f.setZero();
+    ineqConstraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nh));
+    ineqConstraints.back().f.setConstant(1.0);
+    stateBoxes.emplace_back(std::vector<int>{0, 2}, (ocs2::vector_t(2) << -0.1, -infinity).finished(),
+                            (ocs2::vector_t(2) << 0.1, 0.1).finished());
+    inputBoxes.emplace_back(std::vector<int>{1}, ocs2::vector_t::Constant(1, -0.1), ocs2::vector_t::Constant(1, 0.1));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  constraints.emplace_back(ocs2::getRandomConstraints(nx, 0, nc));
+  constraints.back().f.setZero();
+  ineqConstraints.emplace_back(ocs2::getRandomConstraints(nx, 0, nh));
+  ineqConstraints.back().f.setConstant(1.0);
+  stateBoxes.push_back(stateBoxes.back());
+
+  // Only inequalities at some nodes
+  constraints[1] = ocs2::VectorFunctionLinearApproximation();
+  ineqConstraints[2].setZero(0, nx, nu);
+  inputBoxes[3] = ocs2::BoxConstraint();
+
+  const auto ocpSize =
+      ocs2::hpipm_interface::extractSizesFromProblem(system, cost, &constraints, &ineqConstraints, &stateBoxes, &inputBoxes);
+  hpipmInterface.resize(ocpSize);
+
+  // Solve!
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  const auto status =
+      hpipmInterface.solve(x0, system, cost, &constraints, &ineqConstraints, &stateBoxes, &inputBoxes, xSol, uSol, true);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+
+  // Initial condition
+  ASSERT_TRUE(xSol[0].isApprox(x0));
+
+  // Check dynamic feasibility
+  for (int k = 0; k < N; k++) {
+    ASSERT_TRUE(xSol[k + 1].isApprox(system[k].dfdx * xSol[k] + system[k].dfdu * uSol[k] + system[k].f, 1e-9));
+  }
+
+  // Check constraints
+  for (int k = 0; k < N; k++) {
+    if (constraints[k].f.size() > 0) {
+      ASSERT_TRUE(constraints[k].f.isApprox(-constraints[k].dfdx * xSol[k] - constraints[k].dfdu * uSol[k], 1e-9));
+    }
+    const ocs2::vector_t h = ineqConstraints[k].f + ineqConstraints[k].dfdx * xSol[k] + ineqConstraints[k].dfdu * uSol[k];
+    ASSERT_GE(h.minCoeff(), -tol);
+    for (int i = 0; i < inputBoxes[k].size(); i++) {
+      ASSERT_GE(uSol[k][inputBoxes[k].indices[i]], inputBoxes[k].lowerBound[i] - tol);
+      ASSERT_LE(uSol[k][inputBoxes[k].indices[i]], inputBoxes[k].upperBound[i] + tol);
+    }
+  }
+  for (int k = 1; k <= N; k++) {
+    for (int i = 0; i < stateBoxes[k].size(); i++) {
+      ASSERT_GE(xSol[k][stateBoxes[k].indices[i]], stateBoxes[k].lowerBound[i] - tol);
+      ASSERT_LE(xSol[k][stateBoxes[k].indices[i]], stateBoxes[k].upperBound[i] + tol);
+    }
+  }
+}
+
+TEST(test_hpiphm_interface, warmStart) {
+  int nx = 3;
+  int nu = 2;
+  int nh = 2;
+  int N = 20;
+
+  // Problem setup, x = 0 and u = 0 is strictly feasible for the inequalities and bounds.
+  ocs2::vector_t x0 = ocs2::vector_t::Zero(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::VectorFunctionLinearApproximation> ineqConstraints;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  std::vector<ocs2::BoxConstraint> stateBoxes;
+  std::vector<ocs2::BoxConstraint> inputBoxes;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    system.back().f.setZero();
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    ineqConstraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nh));
+    ineqConstraints.back().f.setConstant(1.0);
+    stateBoxes.emplace_back(std::vector<int>{0}, ocs2::vector_t::Constant(1, -0.1), ocs2::vector_t::Constant(1, 0.1));
+    inputBoxes.emplace_back(std::vector<int>{1}, ocs2::vector_t::Constant(1, -0.1), ocs2::vector_t::Constant(1, 0.1));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  ineqConstraints.emplace_back(ocs2::getRandomConstraints(nx, 0, nh));
+  ineqConstraints.back().f.setConstant(1.0);
+  stateBoxes.push_back(stateBoxes.back());
+
+  const auto ocpSize = ocs2::hpipm_interface::extractSizesFromProblem(system, cost, nullptr, &ineqConstraints, &stateBoxes, &inputBoxes);
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+
+  // Cold start
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  auto status = hpipmInterface.solve(x0, system, cost, nullptr, &ineqConstraints, &stateBoxes, &inputBoxes, xSol, uSol);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+  const int numColdStartIterations = hpipmInterface.getNumIterations();
+
+  ocs2::HpipmInterface::Iterate iterate;
+  hpipmInterface.getIterate(iterate);
+  ASSERT_EQ(iterate.size(), N + 1);
+  ASSERT_EQ(iterate[0].ux.size(), nu);
+  ASSERT_EQ(iterate[0].pi.size(), nx);
+  ASSERT_EQ(iterate[0].lam.size(), 2 * (nh + 2));
+  ASSERT_EQ(iterate[0].t.size(), 2 * (nh + 2));
+  ASSERT_EQ(iterate[N].ux.size(), nx);
+  ASSERT_EQ(iterate[N].pi.size(), 0);
+
+  // Warm start from the solution, with the primal part reset as done for a shifted solution
+  for (auto& node : iterate) {
+    node.ux.setZero();
+  }
+  hpipmInterface.setIterate(iterate);
+
+  // The iterate is written to the solution vectors of HPIPM in the layout it is read from
+  ocs2::HpipmInterface::Iterate iterateSet;
+  hpipmInterface.getIterate(iterateSet);
+  ASSERT_EQ(iterateSet.size(), iterate.size());
+  for (int k = 0; k <= N; k++) {
+    ASSERT_TRUE(iterateSet[k].ux.isApprox(iterate[k].ux));
+    ASSERT_TRUE(iterateSet[k].pi.isApprox(iterate[k].pi));
+    ASSERT_TRUE(iterateSet[k].lam.isApprox(iterate[k].lam));
+    ASSERT_TRUE(iterateSet[k].t.isApprox(iterate[k].t));
+  }
+
+  std::vector<ocs2::vector_t> xSolWarm;
+  std::vector<ocs2::vector_t> uSolWarm;
+  status = hpipmInterface.solve(x0, system, cost, nullptr, &ineqConstraints, &stateBoxes, &inputBoxes, xSolWarm, uSolWarm);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+  const int numWarmStartIterations = hpipmInterface.getNumIterations();
+
+  ASSERT_LE(numWarmStartIterations, numColdStartIterations);
+  for (int k = 0; k < N; k++) {
+    ASSERT_LT((uSolWarm[k] - uSol[k]).norm(), 1e-4);
+  }
+  for (int k = 0; k <= N; k++) {
+    ASSERT_LT((xSolWarm[k] - xSol[k]).norm(), 1e-4);
+  }
+
+  // The next solve is cold started again
+  status = hpipmInterface.solve(x0, system, cost, nullptr, &ineqConstraints, &stateBoxes, &inputBoxes, xSol, uSol);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+  ASSERT_EQ(hpipmInterface.getNumIterations(), numColdStartIterations);
+}
+
 TEST(test_hpiphm_interface, noInputs) {
   // Initialize without size
   ocs2::HpipmInterface hpipmInterface;
@@ -338,3 +507,67 @@ TEST(test_hpiphm_interface, retrieveRiccati) {
     ASSERT_TRUE(uSol[k].isApprox(KSol[k] * xSol[k] + kSol[k]));
   }
 }
+
+TEST(test_hpiphm_interface, partialCondensing) {
+  int N = 100;
+  const std::vector<int> blockSizes{1, 2, 4, 5, 10, 20};
+
+  // State and input dimensions of the ballbot, the mobile manipulator and the legged robot
+  const std::vector<std::pair<int, int>> problemDimensions{{10, 3}, {9, 9}, {24, 24}};
+
+  for (const auto& dimensions : problemDimensions) {
+    const int nx = dimensions.first;
+    const int nu = dimensions.second;
+    const int nh = 2;
+
+    // Problem setup, x = 0 and u = 0 is strictly feasible for the inequalities and bounds.
+    ocs2::vector_t x0 = ocs2::vector_t::Zero(nx);
+    std::vector<ocs2::VectorFunctionLinearApproximation> system;
+    std::vector<ocs2::VectorFunctionLinearApproximation> ineqConstraints;
+    std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+    std::vector<ocs2::BoxConstraint> inputBoxes;
+    for (int k = 0; k < N; k++) {
+      system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+      system.back().f.setZero();
+      system.back().dfdx *= 0.5;  // stable dynamics over the long horizon
+      cost.emplace_back(ocs2::getRandomCost(nx, nu));
+      ineqConstraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nh));
+      ineqConstraints.back().f.setConstant(1.0);
+      inputBoxes.emplace_back(std::vector<int>{0}, ocs2::vector_t::Constant(1, -0.1), ocs2::vector_t::Constant(1, 0.1));
+    }
+    cost.emplace_back(ocs2::getRandomCost(nx, 0));
+    ineqConstraints.emplace_back(ocs2::getRandomConstraints(nx, 0, nh));
+    ineqConstraints.back().f.setConstant(1.0);
+
+    const auto ocpSize = ocs2::hpipm_interface::extractSizesFromProblem(system, cost, nullptr, &ineqConstraints, nullptr, &inputBoxes);
+
+    std::vector<ocs2::vector_t> xSolFull;
+    std::vector<ocs2::vector_t> uSolFull;
+    for (const auto blockSize : blockSizes) {
+      ocs2::hpipm_interface::Settings settings;
+      settings.partialCondensingBlockSize = blockSize;
+      ocs2::HpipmInterface hpipmInterface(ocpSize, settings);
+
+      std::vector<ocs2::vector_t> xSol;
+      std::vector<ocs2::vector_t> uSol;
+      const auto status = hpipmInterface.solve(x0, system, cost, nullptr, &ineqConstraints, nullptr, &inputBoxes, xSol, uSol);
+      ASSERT_EQ(status, hpipm_status::SUCCESS);
+
+      // The expanded solution matches the solution of the full-length OCP
+      ASSERT_EQ(xSol.size(), N + 1);
+      ASSERT_EQ(uSol.size(), N);
+      if (blockSize == 1) {
+        xSolFull = xSol;
+        uSolFull = uSol;
+      } else {
+        for (int k = 0; k < N; k++) {
+          ASSERT_LT((uSol[k] - uSolFull[k]).norm(), 1e-4);
+        }
+        for (int k = 0; k <= N; k++) {
+          ASSERT_LT((xSol[k] - xSolFull[k]).norm(), 1e-4);
+        }
+        ASSERT_ANY_THROW(hpipmInterface.getRiccatiFeedback(system[0], cost[0]));
+      }
+    }
+  }
+}
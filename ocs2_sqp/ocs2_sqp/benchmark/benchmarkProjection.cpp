@@ -0,0 +1,65 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <array>
+#include <iostream>
+#include <vector>
+
+#include "ocs2_sqp/ConstraintProjection.h"
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+int main() {
+  constexpr int numRepetitions = 1000;
+  // {nx, nu, nc}
+  const std::vector<std::array<int, 3>> problemSizes{{12, 12, 6}, {24, 24, 12}, {30, 20, 10}, {48, 36, 24}};
+
+  for (const auto& size : problemSizes) {
+    const auto constraint = ocs2::getRandomConstraints(size[0], size[1], size[2]);
+
+    ocs2::benchmark::RepeatedTimer luTimer;
+    ocs2::benchmark::RepeatedTimer qrTimer;
+    ocs2::VectorFunctionLinearApproximation luProjection;
+    ocs2::VectorFunctionLinearApproximation qrProjection;
+    for (int i = 0; i < numRepetitions; i++) {
+      luTimer.startTimer();
+      luProjection = ocs2::luConstraintProjection(constraint);
+      luTimer.endTimer();
+
+      qrTimer.startTimer();
+      qrProjection = ocs2::qrConstraintProjection(constraint);
+      qrTimer.endTimer();
+    }
+    std::cout << "[ConstraintProjection] nx: " << size[0] << ", nu: " << size[1] << ", nc: " << size[2]
+              << ", LU: " << luTimer.getAverageInMilliseconds() << " [ms], QR: " << qrTimer.getAverageInMilliseconds() << " [ms]\n";
+  }
+
+  return 0;
+}
@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <cmath>
+#include <limits>
+
 #include <ocs2_mpc/MPC_BASE.h>
 
 #include <ocs2_sqp/MultipleShootingSolver.h>
@@ -47,7 +50,7 @@ class MultipleShootingMpc final : public MPC_BASE {
    */
   MultipleShootingMpc(mpc::Settings mpcSettings, multiple_shooting::Settings settings, const OptimalControlProblem& optimalControlProblem,
                       const Initializer& initializer)
-      : MPC_BASE(std::move(mpcSettings)) {
+      : MPC_BASE(std::move(mpcSettings)), realTimeIteration_(settings.realTimeIteration) {
     solverPtr_.reset(new MultipleShootingSolver(std::move(settings), optimalControlProblem, initializer));
   };
 
@@ -56,15 +59,39 @@ class MultipleShootingMpc final : public MPC_BASE {
   MultipleShootingSolver* getSolverPtr() override { return solverPtr_.get(); }
   const MultipleShootingSolver* getSolverPtr() const override { return solverPtr_.get(); }
 
+  void reset() override {
+    MPC_BASE::reset();
+    lastInitTime_ = std::numeric_limits<scalar_t>::quiet_NaN();
+    mpcPeriod_ = std::numeric_limits<scalar_t>::quiet_NaN();
+  }
+
+  /** In real-time iteration mode, linearizes the problem around the previous solution on the anticipated next horizon. */
+  void prepareNextRun() override {
+    if (realTimeIteration_ && !std::isnan(lastInitTime_)) {
+      // The next initial time is anticipated from the desired MPC frequency, or from the measured period between the last two runs.
+      const scalar_t period = (settings().mpcDesiredFrequency_ > 0.0) ? 1.0 / settings().mpcDesiredFrequency_ : mpcPeriod_;
+      const scalar_t nextInitTime = std::isnan(period) ? lastInitTime_ : lastInitTime_ + period;
+      solverPtr_->prepareRealTimeIteration(nextInitTime, nextInitTime + getTimeHorizon());
+    }
+  }
+
  protected:
   void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {
     if (settings().coldStart_) {
       solverPtr_->reset();
     }
     solverPtr_->run(initTime, initState, finalTime);
+
+    if (!std::isnan(lastInitTime_) && initTime > lastInitTime_) {
+      mpcPeriod_ = initTime - lastInitTime_;
+    }
+    lastInitTime_ = initTime;
   }
 
  private:
+  const bool realTimeIteration_;
+  scalar_t lastInitTime_ = std::numeric_limits<scalar_t>::quiet_NaN();
+  scalar_t mpcPeriod_ = std::numeric_limits<scalar_t>::quiet_NaN();
   std::unique_ptr<MultipleShootingSolver> solverPtr_;
 };
 }  // namespace ocs2
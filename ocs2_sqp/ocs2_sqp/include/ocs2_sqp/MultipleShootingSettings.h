@@ -34,6 +34,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <hpipm_catkin/HpipmInterfaceSettings.h>
 
+#include "ocs2_sqp/TimeDiscretization.h"
+
 namespace ocs2 {
 namespace multiple_shooting {
 
@@ -43,11 +45,23 @@ struct Settings {
   scalar_t deltaTol = 1e-6;  // Termination condition : RMS update of x(t) and u(t) are both below this value
   scalar_t costTol = 1e-4;   // Termination condition : (cost{i+1} - (cost{i}) < costTol AND constraints{i+1} < g_min
 
+  // Real-time iteration: one full SQP step per run, split into a preparation phase (linearization around the shifted previous solution)
+  // and a feedback phase (embedding of the initial state and QP solve). sqpIteration and the linesearch settings are not used.
+  bool realTimeIteration = false;
+
   // Linesearch - step size rules
-  scalar_t alpha_decay = 0.5;  // multiply the step size by this factor every time a linesearch step is rejected.
-  scalar_t alpha_min = 1e-4;   // terminate linesearch if the attempted step size is below this threshold
+  scalar_t alpha_decay = 0.5;       // multiply the step size by this factor every time a linesearch step is rejected.
+  scalar_t alpha_min = 1e-4;        // terminate linesearch if the attempted step size is below this threshold
+  bool parallelLinesearch = false;  // true to evaluate the step size candidates concurrently (one candidate per worker)
+  bool linearizeFullStep = false;   // true to evaluate the full step with the LQ approximation, which is the next QP if the step is
+                                    // accepted. Saves an evaluation of the horizon per iteration when full steps are taken.
+                                    // A net loss whenever the linesearch backtracks, since the LQ approximation of the rejected full
+                                    // step is discarded. Only used by the sequential linesearch.
 
   // Linesearch - step acceptance criteria with c = costs, g = the norm of constraint violation, and w = [x; u]
+  // g = sqrt(dynamics SSE + equality SSE + inequality SSE). The inequality SSE sums the squared violation of the state-input and
+  // state-only inequality constraints and of the state and input bounds, which the linesearch ignored before they were passed to
+  // HPIPM. Problems with inequality constraints can therefore see more rejected steps, and g_min now also bounds their violation.
   scalar_t g_max = 1e6;          // (1): IF g{i+1} > g_max REQUIRE g{i+1} < (1-gamma_c) * g{i}
   scalar_t g_min = 1e-6;         // (2): ELSE IF (g{i} < g_min AND g{i+1} < g_min AND dc/dw'{i} * delta_w < 0) REQUIRE armijo condition
   scalar_t armijoFactor = 1e-4;  // Armijo condition: c{i+1} < c{i} + armijoFactor * dc/dw'{i} * delta_w
@@ -58,9 +72,18 @@ struct Settings {
 
   // QP subproblem solver settings
   hpipm_interface::Settings hpipmSettings = hpipm_interface::Settings();
+  bool qpWarmStart = false;  // true to start HPIPM from the multipliers and slacks of the previous QP, shifted to the current time grid
+  bool partitionedRiccati = false;  // true to solve QPs without constraints (or with projected constraints) with a Riccati recursion
+                                    // that is partitioned over nThreads, instead of HPIPM. Pays off for long horizons.
 
   // Discretization method
-  scalar_t dt = 0.01;  // user-defined time discretization
+  scalar_t dt = 0.01;                             // user-defined time discretization, the first step for non-uniform grids
+  TimeGridType timeGrid = TimeGridType::UNIFORM;  // spacing of the nodes along the horizon, see TimeDiscretization.h
+  scalar_t dtGrowthFactor = 1.05;                 // GEOMETRIC: ratio of two consecutive steps
+  scalar_array_t dtSwitchTimes;                   // PIECEWISE_UNIFORM: times from the start of the horizon at which the step changes
+  scalar_array_t dtAfterSwitch;                   // PIECEWISE_UNIFORM: step after each switch time, dt is used before the first one
+  scalar_t dtMin = 0.001;                         // ADAPTIVE: smallest step
+  scalar_t dtMax = 0.1;                           // GEOMETRIC and ADAPTIVE: largest step
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
 
   // Inequality penalty relaxed barrier parameters
@@ -76,6 +99,8 @@ struct Settings {
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
+  size_t threadSpinTime = 0;  // [us] idle workers spin this long before they are parked, 0 uses the task queue thread pool
+  bool pinThreads = false;    // true to pin the worker threads to CPU cores
 };
 
 /**
@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/MultipleShootingSettings.h"
 #include "ocs2_sqp/MultipleShootingSolverStatus.h"
+#include "ocs2_sqp/PartitionedRiccatiSolver.h"
 #include "ocs2_sqp/TimeDiscretization.h"
 
 namespace ocs2 {
@@ -68,10 +69,16 @@ class MultipleShootingSolver : public SolverBase {
 
   size_t getNumIterations() const override { return totalNumIterations_; }
 
+  /** Gets the total number of interior point iterations of the QP solver since the last reset(). */
+  size_t getNumQpIterations() const { return totalNumQpIterations_; }
+
   const PerformanceIndex& getPerformanceIndeces() const override { return getIterationsLog().back(); };
 
   const std::vector<PerformanceIndex>& getIterationsLog() const override;
 
+  /** Gets the reason why the latest run() terminated. */
+  multiple_shooting::Convergence getConvergence() const { return convergence_; }
+
   ScalarFunctionQuadraticApproximation getValueFunction(scalar_t time, const vector_t& state) const override {
     throw std::runtime_error("[MultipleShootingSolver] getValueFunction() not available yet.");
   };
@@ -84,6 +91,16 @@ class MultipleShootingSolver : public SolverBase {
     throw std::runtime_error("[MultipleShootingSolver] getStateInputEqualityConstraintLagrangian() not available yet.");
   }
 
+  /**
+   * Preparation phase of the real-time iteration (see Settings::realTimeIteration). Linearizes the problem on the horizon
+   * [initTime, finalTime] around the previous solution, such that the feedback phase in the next run() only has to embed the initial
+   * state and solve the QP. Does nothing if there is no previous solution.
+   *
+   * @param [in] initTime: The expected initial time of the next run().
+   * @param [in] finalTime: The expected final time of the next run().
+   */
+  void prepareRealTimeIteration(scalar_t initTime, scalar_t finalTime);
+
  private:
   void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override;
 
@@ -95,31 +112,50 @@ class MultipleShootingSolver : public SolverBase {
     }
   }
 
+  /** Runs the feedback phase of the real-time iteration. Runs the preparation phase first if the horizon was not prepared. */
+  void runRealTimeIteration(scalar_t initTime, const vector_t& initState, scalar_t finalTime);
+
   /** Run a task in parallel with settings.nThreads */
   void runParallel(std::function<void(int)> taskFunction);
 
   /** Get profiling information as a string */
   std::string getBenchmarkingInformation() const;
 
+  /** Determines the time discretization of the horizon on the grid of the settings, taking into account the event times. */
+  std::vector<AnnotatedTime> getTimeDiscretization(scalar_t initTime, scalar_t finalTime) const;
+
   /** Initializes for the state-input trajectories */
   void initializeStateInputTrajectories(const vector_t& initState, const std::vector<AnnotatedTime>& timeDiscretization,
                                         vector_array_t& stateTrajectory, vector_array_t& inputTrajectory);
 
-  /** Creates QP around t, x(t), u(t). Returns performance metrics at the current {t, x(t), u(t)} */
+  /**
+   * Creates QP around t, x(t), u(t). Returns performance metrics at the current {t, x(t), u(t)}
+   * If initialNodePerformance is given, it is set to the contribution of the first node.
+   */
   PerformanceIndex setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                            const vector_array_t& u);
+                                            const vector_array_t& u, PerformanceIndex* initialNodePerformance = nullptr);
+
+  /** Creates the QP of node i < N on the given worker. Returns the performance metrics of the node. */
+  PerformanceIndex setupNode(int workerId, const std::vector<AnnotatedTime>& time, int i, const vector_array_t& x, const vector_array_t& u);
 
   /** Computes only the performance metrics at the current {t, x(t), u(t)} */
   PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                       const vector_array_t& u);
 
+  /** Computes only the performance metrics at the current {t, x(t), u(t)}, sweeping the horizon sequentially on the given worker */
+  PerformanceIndex computePerformanceOnWorker(int workerId, const std::vector<AnnotatedTime>& time, const vector_t& initState,
+                                              const vector_array_t& x, const vector_array_t& u);
+
   /** Returns solution of the QP subproblem in delta coordinates: */
   struct OcpSubproblemSolution {
     vector_array_t deltaXSol;      // delta_x(t)
     vector_array_t deltaUSol;      // delta_u(t)
     scalar_t armijoDescentMetric;  // inner product of the cost gradient and decision variable step
   };
-  OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0);
+  const OcpSubproblemSolution& getOCPSolution(const std::vector<AnnotatedTime>& time, const vector_t& delta_x0);
+
+  /** Sets the QP iterate of the previous solve, shifted to the given time discretization, as the initial iterate of HPIPM */
+  void setQpWarmStart(const std::vector<AnnotatedTime>& time);
 
   /** Set up the primal solution based on the optimized state and input trajectories */
   void setPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u);
@@ -127,13 +163,28 @@ class MultipleShootingSolver : public SolverBase {
   /** Compute 2-norm of the trajectory: sqrt(sum_i v[i]^2)  */
   static scalar_t trajectoryNorm(const vector_array_t& v);
 
-  /** Compute total constraint violation */
+  /** Compute total constraint violation: the norm of the dynamics, equality, inequality and box constraint violation */
   scalar_t totalConstraintViolation(const PerformanceIndex& performance) const;
 
-  /** Decides on the step to take and overrides given trajectories {x(t), u(t)} <- {x(t) + a*dx(t), u(t) + a*du(t)} */
+  /**
+   * Decides on the step to take and overrides given trajectories {x(t), u(t)} <- {x(t) + a*dx(t), u(t) + a*du(t)}
+   * If isLinearizationExpected is set, a full step is evaluated by its LQ approximation (see Settings::linearizeFullStep).
+   */
   multiple_shooting::StepInfo takeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
                                        const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
-                                       vector_array_t& u);
+                                       vector_array_t& u, bool isLinearizationExpected = false);
+
+  /** Swaps the LQ approximation with the one of the full step */
+  void swapFullStepApproximation();
+
+  /** Decides on the step to take by evaluating the step size candidates in parallel. Selects the same step as the sequential search. */
+  multiple_shooting::StepInfo takeStepInParallel(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
+                                                 const vector_t& initState, const OcpSubproblemSolution& subproblemSolution,
+                                                 vector_array_t& x, vector_array_t& u);
+
+  /** Checks the step acceptance criteria of the filter linesearch. Returns true if the step is accepted, and sets the step type */
+  bool isStepAccepted(const PerformanceIndex& baseline, const PerformanceIndex& performanceNew, scalar_t alpha,
+                      scalar_t armijoDescentMetric, multiple_shooting::StepInfo::StepType& stepType) const;
 
   /** Determine convergence after a step */
   multiple_shooting::Convergence checkConvergence(int iteration, const PerformanceIndex& baseline,
@@ -151,15 +202,49 @@ class MultipleShootingSolver : public SolverBase {
 
   // Solution
   PrimalSolution primalSolution_;
+  multiple_shooting::Convergence convergence_ = multiple_shooting::Convergence::FALSE;
 
   // Solver interface
   HpipmInterface hpipmInterface_;
+  PartitionedRiccatiSolver partitionedRiccatiSolver_;
+  bool isQpSolvedByPartitionedRiccati_{false};  // true if the last QP was solved by partitionedRiccatiSolver_
+  HpipmInterface::Iterate qpIterate_;            // primal-dual iterate of the last QP solved by HPIPM
+  std::vector<scalar_t> qpIterateTime_;          // time discretization of qpIterate_
+  HpipmInterface::Iterate shiftedQpIterate_;
 
   // LQ approximation
   std::vector<VectorFunctionLinearApproximation> dynamics_;
   std::vector<ScalarFunctionQuadraticApproximation> cost_;
   std::vector<VectorFunctionLinearApproximation> constraints_;
   std::vector<VectorFunctionLinearApproximation> constraintsProjection_;
+  std::vector<VectorFunctionLinearApproximation> ineqConstraints_;
+  std::vector<BoxConstraint> stateBoxes_;
+  std::vector<BoxConstraint> inputBoxes_;
+
+  // LQ approximation at the full step of the linesearch, the next QP if the full step is accepted
+  bool isFullStepApproximationAccepted_{false};
+  PerformanceIndex fullStepPerformance_;
+  std::vector<VectorFunctionLinearApproximation> fullStepDynamics_;
+  std::vector<ScalarFunctionQuadraticApproximation> fullStepCost_;
+  std::vector<VectorFunctionLinearApproximation> fullStepConstraints_;
+  std::vector<VectorFunctionLinearApproximation> fullStepConstraintsProjection_;
+  std::vector<VectorFunctionLinearApproximation> fullStepIneqConstraints_;
+  std::vector<BoxConstraint> fullStepStateBoxes_;
+  std::vector<BoxConstraint> fullStepInputBoxes_;
+
+  // Workspace, reused over SQP iterations and MPC cycles as long as the horizon layout does not change
+  OcpSubproblemSolution subproblemSolution_;
+  vector_array_t projectedDeltaUSol_;   // QP solution in the projected inputs \tilde{du}
+  std::vector<vector_array_t> xTrial_;  // linesearch trial states, one per worker + one for the best candidate
+  std::vector<vector_array_t> uTrial_;  // linesearch trial inputs, one per worker + one for the best candidate
+
+  // Real-time iteration: QP prepared around {t, x(t), u(t)} for the next feedback phase
+  bool isRealTimeIterationPrepared_{false};
+  std::vector<AnnotatedTime> rtiTimeDiscretization_;
+  vector_array_t rtiStateTrajectory_;
+  vector_array_t rtiInputTrajectory_;
+  PerformanceIndex rtiBaselinePerformance_;
+  PerformanceIndex rtiInitialNodePerformance_;  // contribution of the first node to rtiBaselinePerformance_
 
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
@@ -167,6 +252,7 @@ class MultipleShootingSolver : public SolverBase {
   // Benchmarking
   size_t numProblems_{0};
   size_t totalNumIterations_{0};
+  size_t totalNumQpIterations_{0};
   benchmark::RepeatedTimer initializationTimer_;
   benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
   benchmark::RepeatedTimer solveQpTimer_;
@@ -44,8 +44,11 @@ struct Transcription {
   PerformanceIndex performance;
   VectorFunctionLinearApproximation dynamics;
   ScalarFunctionQuadraticApproximation cost;
-  VectorFunctionLinearApproximation constraints;
-  VectorFunctionLinearApproximation constraintsProjection;
+  VectorFunctionLinearApproximation constraints;            // With projection, the linearization from which the projection is computed
+  VectorFunctionLinearApproximation constraintsProjection;  // Empty if the constraints are not projected
+  VectorFunctionLinearApproximation ineqConstraints;
+  BoxConstraint nextStateBox;
+  BoxConstraint inputBox;
 };
 
 /**
@@ -65,6 +68,32 @@ Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlP
                                     DynamicsSensitivityDiscretizer& sensitivityDiscretizer, bool projectStateInputEqualityConstraints,
                                     scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
 
+/**
+ * In-place version of setupIntermediateNode. The transcription is moved into the given LQ storage, such that the solver does not need
+ * an intermediate Transcription per node. The approximations of the problem definition are returned by value, so they are still
+ * allocated on every call.
+ *
+ * @param [out] dynamics : Linearized discrete dynamics.
+ * @param [out] cost : Quadratic approximation of the cost.
+ * @param [out] constraints : Linearized state-input equality constraints. When the constraints are projected, this is the linearization
+ *                            from which the projection is computed, it is not a constraint of the projected QP.
+ * @param [out] constraintsProjection : Constraint projection. Only set when the constraints are projected, i.e. with
+ *                                      projectStateInputEqualityConstraints and non-empty constraints. Left unchanged otherwise.
+ * @param [out] ineqConstraints : Linearized state-input inequality constraints (h >= 0). With projection, they are expressed in the
+ *                                projected input and also contain the input bounds.
+ * @param [out] nextStateBox : Bounds on the deviation of x_next.
+ * @param [out] inputBox : Bounds on the input deviation. Empty when the constraints are projected.
+ * @return performance index of this node.
+ */
+PerformanceIndex setupIntermediateNode(const OptimalControlProblem& optimalControlProblem,
+                                       DynamicsSensitivityDiscretizer& sensitivityDiscretizer, bool projectStateInputEqualityConstraints,
+                                       scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                                       VectorFunctionLinearApproximation& dynamics, ScalarFunctionQuadraticApproximation& cost,
+                                       VectorFunctionLinearApproximation& constraints,
+                                       VectorFunctionLinearApproximation& constraintsProjection,
+                                       VectorFunctionLinearApproximation& ineqConstraints, BoxConstraint& nextStateBox,
+                                       BoxConstraint& inputBox);
+
 /**
  * Compute only the performance index for a single intermediate node.
  * Corresponds to the performance index returned by "setupIntermediateNode"
@@ -79,6 +108,7 @@ struct TerminalTranscription {
   PerformanceIndex performance;
   ScalarFunctionQuadraticApproximation cost;
   VectorFunctionLinearApproximation constraints;
+  VectorFunctionLinearApproximation ineqConstraints;
 };
 
 /**
@@ -91,6 +121,14 @@ struct TerminalTranscription {
  */
 TerminalTranscription setupTerminalNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x);
 
+/**
+ * In-place version of setupTerminalNode. The transcription is written into the given LQ storage.
+ * @return performance index of the terminal node.
+ */
+PerformanceIndex setupTerminalNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
+                                   ScalarFunctionQuadraticApproximation& cost, VectorFunctionLinearApproximation& constraints,
+                                   VectorFunctionLinearApproximation& ineqConstraints);
+
 /**
  * Compute only the performance index for the terminal node.
  * Corresponds to the performance index returned by "setTerminalNode"
@@ -105,6 +143,7 @@ struct EventTranscription {
   VectorFunctionLinearApproximation dynamics;
   ScalarFunctionQuadraticApproximation cost;
   VectorFunctionLinearApproximation constraints;
+  BoxConstraint nextStateBox;
 };
 
 /**
@@ -119,6 +158,14 @@ struct EventTranscription {
 EventTranscription setupEventNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
                                   const vector_t& x_next);
 
+/**
+ * In-place version of setupEventNode. The transcription is written into the given LQ storage.
+ * @return performance index of the event node.
+ */
+PerformanceIndex setupEventNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next,
+                                VectorFunctionLinearApproximation& dynamics, ScalarFunctionQuadraticApproximation& cost,
+                                VectorFunctionLinearApproximation& constraints, BoxConstraint& nextStateBox);
+
 /**
  * Compute only the performance index for the event node.
  * Corresponds to the performance index returned by "setupEventNode"
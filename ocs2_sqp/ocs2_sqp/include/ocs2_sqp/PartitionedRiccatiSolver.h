@@ -0,0 +1,111 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_ddp/riccati_equations/DiscreteTimeRiccatiScan.h>
+
+namespace ocs2 {
+
+/**
+ * Solves the unconstrained LQ subproblem of the multiple shooting method with a Riccati recursion that is partitioned in time, such that
+ * the QP solve scales with the number of threads.
+ *
+ * The horizon is split into one segment per thread, and the solve runs in three phases:
+ * 1. In parallel, each segment is condensed into its conditional value function, i.e. the optimal cost between its initial and final
+ *    state. The last segment runs the Riccati recursion from the final cost instead.
+ * 2. Sequentially over the segments, the value functions at the segment boundaries are propagated backward and the optimal states at
+ *    the segment boundaries are propagated forward. This is the small coupled system that connects the segments.
+ * 3. In parallel, each segment runs the Riccati recursion from the value function at its end and the forward rollout from the state at
+ *    its start.
+ *
+ * The conditional value functions of the segments and their combination are the ones of riccati_scan::ConditionalValueFunction.
+ *
+ * Condensing a segment requires the Hessian of the stage cost w.r.t. the input, R_k, to be positive definite. If it is not, the solve falls
+ * back to the sequential Riccati recursion, which only requires R_k + B_k' S_{k+1} B_k to be positive definite. Stages without inputs
+ * (event nodes) are supported.
+ */
+class PartitionedRiccatiSolver {
+ public:
+  /**
+   * Solves the LQ problem
+   *  min  sum_k 0.5 dx_k' Q_k dx_k + du_k' P_k dx_k + 0.5 du_k' R_k du_k + q_k' dx_k + r_k' du_k  +  0.5 dx_N' Q_N dx_N + q_N' dx_N
+   *  s.t. dx_{k+1} = A_k dx_k + B_k du_k + b_k,  dx_0 = x0
+   *
+   * @param [in] x0 : Initial state deviation.
+   * @param [in] dynamics : Linear dynamics for k = 0, ..., N-1 (dfdx = A_k, dfdu = B_k, f = b_k).
+   * @param [in] cost : Quadratic cost for k = 0, ..., N (dfdxx = Q_k, dfdux = P_k, dfduu = R_k, dfdx = q_k, dfdu = r_k).
+   * @param [out] stateTrajectory : Optimal state deviations dx_0, ..., dx_N.
+   * @param [out] inputTrajectory : Optimal input deviations du_0, ..., du_{N-1}.
+   * @param [in] threadPool : Thread pool to run the segments on.
+   * @param [in] numThreads : Number of segments the horizon is split into. runParallel() of the pool is called with this number.
+   * @throw std::runtime_error if an input Hessian R_k + B_k' S_{k+1} B_k of the Riccati recursion is not positive definite.
+   */
+  void solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+             const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory,
+             ThreadPool& threadPool, size_t numThreads);
+
+  /** Gets the Riccati feedback gains K_k of the last solve, du_k = K_k dx_k + k_k. */
+  const matrix_array_t& getRiccatiFeedback() const { return feedbackGains_; }
+
+ private:
+  using ConditionalValueFunction = riccati_scan::ConditionalValueFunction;
+
+  /** Sets the conditional value function of a single stage. Returns false if the input Hessian is not positive definite. */
+  static bool setStageValueFunction(const VectorFunctionLinearApproximation& dynamics, const ScalarFunctionQuadraticApproximation& cost,
+                                    ConditionalValueFunction& valueFunction);
+
+  /** Condenses the stages [start, end) into a conditional value function. Returns false if an input Hessian is not positive definite. */
+  bool condenseSegment(int start, int end, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                       const std::vector<ScalarFunctionQuadraticApproximation>& cost, ConditionalValueFunction& segment) const;
+
+  /**
+   * Runs the Riccati recursion backward over the stages [start, end), given the value function 0.5 x' S x + s' x at stage end. Stores
+   * the feedback gains and feedforward inputs. Overwrites S and s with the value function at stage start. Returns false if an input
+   * Hessian of the Riccati recursion is not positive definite.
+   */
+  bool riccatiRecursion(int start, int end, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                        const std::vector<ScalarFunctionQuadraticApproximation>& cost, matrix_t& S, vector_t& s);
+
+  /** Rolls out the stages [start, end) with the Riccati policy, starting from the state at stage start. */
+  void rollout(int start, int end, const std::vector<VectorFunctionLinearApproximation>& dynamics, vector_array_t& stateTrajectory,
+               vector_array_t& inputTrajectory) const;
+
+  // Workspace
+  std::vector<int> segmentStarts_;  // first stage of each segment, followed by N
+  std::vector<ConditionalValueFunction> segmentValueFunctions_;
+  matrix_array_t boundaryValueHessians_;  // value function at each segment start
+  vector_array_t boundaryValueGradients_;
+  matrix_array_t feedbackGains_;
+  vector_array_t feedforwardInputs_;
+};
+
+}  // namespace ocs2
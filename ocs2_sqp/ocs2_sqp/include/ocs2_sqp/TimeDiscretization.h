@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <functional>
+#include <string>
+
 #include <ocs2_core/NumericTraits.h>
 #include <ocs2_core/Types.h>
 
@@ -76,4 +79,73 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
                                                         const scalar_array_t& eventTimes,
                                                         scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
 
+/** A function handle that returns the desired duration of the discretization interval that starts at time t. */
+using StepSizeFunction = std::function<scalar_t(scalar_t)>;
+
+/**
+ * Decides on a non-uniform time discretization along the horizon. Tries to make steps of stepSize(t) from each node at time t, but will
+ * also ensure that eventtimes are part of the discretization.
+ *
+ * @param initTime : start time.
+ * @param finalTime : final time.
+ * @param stepSize : desired discretization step as a function of the start of the step. Has to be positive.
+ * @param eventTimes : Event times where a time discretization must be made.
+ * @param dt_min : minimum discretization step. Smaller intervals will be merged. Needs to be bigger than limitEpsilon to avoid
+ * interpolation problems
+ * @return vector of discrete time points
+ */
+std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, const StepSizeFunction& stepSize,
+                                                        const scalar_array_t& eventTimes,
+                                                        scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
+
+/** Spacing of the nodes along the horizon */
+enum class TimeGridType { UNIFORM, GEOMETRIC, PIECEWISE_UNIFORM, ADAPTIVE };
+
+namespace time_grid {
+
+/** Get string name of the time grid type */
+std::string toString(TimeGridType timeGridType);
+
+/** Get the time grid type from its string name, useful for reading config file */
+TimeGridType fromString(const std::string& name);
+
+}  // namespace time_grid
+
+/**
+ * Steps that grow geometrically along the horizon: each step is growthFactor times the previous one, starting with dt at initTime.
+ * Between the nodes, this is the step size dt + (growthFactor - 1) * (t - initTime).
+ *
+ * @param initTime : start time of the horizon.
+ * @param dt : first step.
+ * @param growthFactor : ratio of two consecutive steps, at least 1.
+ * @param dtMax : largest step.
+ */
+StepSizeFunction geometricStepSize(scalar_t initTime, scalar_t dt, scalar_t growthFactor, scalar_t dtMax);
+
+/**
+ * Piecewise constant steps along the horizon: dt until the first switch, dtAfterSwitch[i] from the i-th switch on.
+ *
+ * @param initTime : start time of the horizon.
+ * @param dt : step before the first switch.
+ * @param switchTimes : increasing times relative to initTime at which the step changes.
+ * @param dtAfterSwitch : step after each switch, same size as switchTimes.
+ */
+StepSizeFunction piecewiseUniformStepSize(scalar_t initTime, scalar_t dt, const scalar_array_t& switchTimes,
+                                          const scalar_array_t& dtAfterSwitch);
+
+/**
+ * Steps that adapt to the curvature of a previous state trajectory. The error of a linear interpolation over a step h scales with
+ * h^2 * |x''|, the steps are therefore chosen proportional to 1 / sqrt(|x''|), such that a uniform step of dt has the same error at the
+ * average curvature. The curvature is estimated with finite differences, the steps are clamped to [dtMin, dtMax], and held constant
+ * beyond the given trajectory. A step is shortened to end where a finer step is required.
+ *
+ * @param timeTrajectory : time trajectory of the previous solution, with at least 3 points.
+ * @param stateTrajectory : state trajectory of the previous solution.
+ * @param dt : step at the average curvature.
+ * @param dtMin : smallest step.
+ * @param dtMax : largest step.
+ */
+StepSizeFunction adaptiveStepSize(const scalar_array_t& timeTrajectory, const vector_array_t& stateTrajectory, scalar_t dt, scalar_t dtMin,
+                                  scalar_t dtMax);
+
 }  // namespace ocs2
@@ -52,13 +52,26 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.deltaTol, fieldName + ".deltaTol", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_decay, fieldName + ".alpha_decay", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_min, fieldName + ".alpha_min", verbose);
+  loadData::loadPtreeValue(pt, settings.parallelLinesearch, fieldName + ".parallelLinesearch", verbose);
+  loadData::loadPtreeValue(pt, settings.linearizeFullStep, fieldName + ".linearizeFullStep", verbose);
   loadData::loadPtreeValue(pt, settings.gamma_c, fieldName + ".gamma_c", verbose);
   loadData::loadPtreeValue(pt, settings.g_max, fieldName + ".g_max", verbose);
   loadData::loadPtreeValue(pt, settings.g_min, fieldName + ".g_min", verbose);
   loadData::loadPtreeValue(pt, settings.armijoFactor, fieldName + ".armijoFactor", verbose);
   loadData::loadPtreeValue(pt, settings.costTol, fieldName + ".costTol", verbose);
+  loadData::loadPtreeValue(pt, settings.realTimeIteration, fieldName + ".realTimeIteration", verbose);
   loadData::loadPtreeValue(pt, settings.dt, fieldName + ".dt", verbose);
+  auto timeGridName = time_grid::toString(settings.timeGrid);
+  loadData::loadPtreeValue(pt, timeGridName, fieldName + ".timeGrid", verbose);
+  settings.timeGrid = time_grid::fromString(timeGridName);
+  loadData::loadPtreeValue(pt, settings.dtGrowthFactor, fieldName + ".dtGrowthFactor", verbose);
+  loadData::loadStdVector(filename, fieldName + ".dtSwitchTimes", settings.dtSwitchTimes, verbose);
+  loadData::loadStdVector(filename, fieldName + ".dtAfterSwitch", settings.dtAfterSwitch, verbose);
+  loadData::loadPtreeValue(pt, settings.dtMin, fieldName + ".dtMin", verbose);
+  loadData::loadPtreeValue(pt, settings.dtMax, fieldName + ".dtMax", verbose);
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy, fieldName + ".useFeedbackPolicy", verbose);
+  loadData::loadPtreeValue(pt, settings.qpWarmStart, fieldName + ".qpWarmStart", verbose);
+  loadData::loadPtreeValue(pt, settings.partitionedRiccati, fieldName + ".partitionedRiccati", verbose);
   auto integratorName = sensitivity_integrator::toString(settings.integratorType);
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".integratorType", verbose);
   settings.integratorType = sensitivity_integrator::fromString(integratorName);
@@ -70,6 +83,9 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.printLinesearch, fieldName + ".printLinesearch", verbose);
   loadData::loadPtreeValue(pt, settings.nThreads, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority, fieldName + ".threadPriority", verbose);
+  loadData::loadPtreeValue(pt, settings.threadSpinTime, fieldName + ".threadSpinTime", verbose);
+  loadData::loadPtreeValue(pt, settings.pinThreads, fieldName + ".pinThreads", verbose);
+  loadData::loadPtreeValue(pt, settings.hpipmSettings.partialCondensingBlockSize, fieldName + ".partialCondensingBlockSize", verbose);
 
   if (verbose) {
     std::cerr << settings.hpipmSettings;
@@ -29,7 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/MultipleShootingSolver.h"
 
+#include <array>
 #include <iostream>
+#include <mutex>
 #include <numeric>
 
 #include <ocs2_core/control/FeedforwardController.h>
@@ -41,12 +43,27 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+/** Replaces the contribution of a single node to the total performance */
+PerformanceIndex replaceNodePerformance(PerformanceIndex total, const PerformanceIndex& oldNode, const PerformanceIndex& newNode) {
+  total.cost += newNode.cost - oldNode.cost;
+  total.dynamicsViolationSSE += newNode.dynamicsViolationSSE - oldNode.dynamicsViolationSSE;
+  total.equalityConstraintsSSE += newNode.equalityConstraintsSSE - oldNode.equalityConstraintsSSE;
+  total.inequalityConstraintsSSE += newNode.inequalityConstraintsSSE - oldNode.inequalityConstraintsSSE;
+  total.equalityLagrangian += newNode.equalityLagrangian - oldNode.equalityLagrangian;
+  total.inequalityLagrangian += newNode.inequalityLagrangian - oldNode.inequalityLagrangian;
+  total.merit = total.cost + total.equalityLagrangian + total.inequalityLagrangian;
+  return total;
+}
+}  // namespace
+
 MultipleShootingSolver::MultipleShootingSolver(Settings settings, const OptimalControlProblem& optimalControlProblem,
                                                const Initializer& initializer)
     : SolverBase(),
       settings_(std::move(settings)),
       hpipmInterface_(hpipm_interface::OcpSize(), settings.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority) {
+      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority, std::chrono::microseconds(settings_.threadSpinTime),
+                  settings_.pinThreads) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
@@ -59,12 +76,21 @@ MultipleShootingSolver::MultipleShootingSolver(Settings settings, const OptimalC
     ocpDefinitions_.push_back(optimalControlProblem);
   }
 
+  // Linesearch workspace: one trial trajectory per worker and one for the best candidate
+  xTrial_.resize(settings_.nThreads + 1);
+  uTrial_.resize(settings_.nThreads + 1);
+
   // Operating points
   initializerPtr_.reset(initializer.clone());
 
   if (optimalControlProblem.equalityConstraintPtr->empty()) {
     settings_.projectStateInputEqualityConstraints = false;  // True does not make sense if there are no constraints.
   }
+
+  if (settings_.useFeedbackPolicy && settings_.hpipmSettings.partialCondensingBlockSize > 1) {
+    throw std::runtime_error("[MultipleShootingSolver] The feedback policy requires the Riccati factorization of the full-length QP. "
+                             "Set partialCondensingBlockSize to 1 or disable useFeedbackPolicy.");
+  }
 }
 
 MultipleShootingSolver::~MultipleShootingSolver() {
@@ -76,15 +102,24 @@ MultipleShootingSolver::~MultipleShootingSolver() {
 void MultipleShootingSolver::reset() {
   // Clear solution
   primalSolution_ = PrimalSolution();
+  convergence_ = multiple_shooting::Convergence::FALSE;
   performanceIndeces_.clear();
+  isFullStepApproximationAccepted_ = false;
 
   // reset timers
   numProblems_ = 0;
   totalNumIterations_ = 0;
+  totalNumQpIterations_ = 0;
   linearQuadraticApproximationTimer_.reset();
   solveQpTimer_.reset();
   linesearchTimer_.reset();
   computeControllerTimer_.reset();
+
+  // Invalidate prepared real-time iteration
+  isRealTimeIterationPrepared_ = false;
+
+  // Forget the QP iterate
+  qpIterateTime_.clear();
 }
 
 std::string MultipleShootingSolver::getBenchmarkingInformation() const {
@@ -99,7 +134,8 @@ std::string MultipleShootingSolver::getBenchmarkingInformation() const {
   if (benchmarkTotal > 0.0) {
     const scalar_t inPercent = 100.0;
     infoStream << "\n########################################################################\n";
-    infoStream << "The benchmarking is computed over " << totalNumIterations_ << " iterations. \n";
+    infoStream << "The benchmarking is computed over " << totalNumIterations_ << " iterations, with " << totalNumQpIterations_
+               << " QP solver iterations. \n";
     infoStream << "SQP Benchmarking\t   :\tAverage time [ms]   (% of total runtime)\n";
     infoStream << "\tLQ Approximation   :\t" << linearQuadraticApproximationTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << linearQuadraticApproximationTotal / benchmarkTotal * inPercent << "%)\n";
@@ -122,6 +158,29 @@ const std::vector<PerformanceIndex>& MultipleShootingSolver::getIterationsLog()
 }
 
 void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  // Record the time spent in each phase of this run
+  auto& timeBudget = getTimeBudget();
+  const std::array<std::pair<const char*, const benchmark::RepeatedTimer*>, 4> phaseTimers{
+      {{"LQ Approximation", &linearQuadraticApproximationTimer_},
+       {"Solve QP", &solveQpTimer_},
+       {"Linesearch", &linesearchTimer_},
+       {"Compute Controller", &computeControllerTimer_}}};
+  std::array<scalar_t, 4> phaseTotalsAtStart;
+  for (size_t i = 0; i < phaseTimers.size(); i++) {
+    phaseTotalsAtStart[i] = phaseTimers[i].second->getTotalInMilliseconds();
+  }
+  auto recordPhaseDurations = [&]() {
+    for (size_t i = 0; i < phaseTimers.size(); i++) {
+      timeBudget.addPhaseDuration(phaseTimers[i].first, 1e-3 * (phaseTimers[i].second->getTotalInMilliseconds() - phaseTotalsAtStart[i]));
+    }
+  };
+
+  if (settings_.realTimeIteration) {
+    runRealTimeIteration(initTime, initState, finalTime);
+    recordPhaseDurations();
+    return;
+  }
+
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ SQP solver is initialized ++++++++++++++";
@@ -129,8 +188,7 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
   }
 
   // Determine time discretization, taking into account event times.
-  const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+  const auto timeDiscretization = getTimeDiscretization(initTime, finalTime);
 
   // Initialize the state and input
   vector_array_t x, u;
@@ -144,6 +202,7 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
 
   // Bookkeeping
   performanceIndeces_.clear();
+  isFullStepApproximationAccepted_ = false;
 
   int iter = 0;
   multiple_shooting::Convergence convergence = multiple_shooting::Convergence::FALSE;
@@ -151,26 +210,45 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
     if (settings_.printSolverStatus || settings_.printLinesearch) {
       std::cerr << "\nSQP iteration: " << iter << "\n";
     }
-    // Make QP approximation
+    const scalar_t iterationStartTime = timeBudget.getElapsedTime();
+
+    // Make QP approximation, unless the linesearch did so already
     linearQuadraticApproximationTimer_.startTimer();
-    const auto baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u);
+    PerformanceIndex baselinePerformance;
+    if (isFullStepApproximationAccepted_) {
+      swapFullStepApproximation();
+      baselinePerformance = fullStepPerformance_;
+      isFullStepApproximationAccepted_ = false;
+    } else {
+      baselinePerformance = setupQuadraticSubproblem(timeDiscretization, initState, x, u);
+    }
     linearQuadraticApproximationTimer_.endTimer();
 
     // Solve QP
     solveQpTimer_.startTimer();
     const vector_t delta_x0 = initState - x[0];
-    const auto deltaSolution = getOCPSolution(delta_x0);
+    const auto& deltaSolution = getOCPSolution(timeDiscretization, delta_x0);
     solveQpTimer_.endTimer();
 
     // Apply step
     linesearchTimer_.startTimer();
-    const auto stepInfo = takeStep(baselinePerformance, timeDiscretization, initState, deltaSolution, x, u);
+    const bool isLinearizationExpected = (iter + 1) < settings_.sqpIteration;
+    const auto stepInfo = settings_.parallelLinesearch
+                              ? takeStepInParallel(baselinePerformance, timeDiscretization, initState, deltaSolution, x, u)
+                              : takeStep(baselinePerformance, timeDiscretization, initState, deltaSolution, x, u, isLinearizationExpected);
     performanceIndeces_.push_back(stepInfo.performanceAfterStep);
     linesearchTimer_.endTimer();
 
     // Check convergence
     convergence = checkConvergence(iter, baselinePerformance, stepInfo);
 
+    // Stop if the time budget does not suffice for another iteration. x and u hold the latest accepted iterate.
+    const scalar_t iterationDuration = timeBudget.getElapsedTime() - iterationStartTime;
+    if ((convergence == multiple_shooting::Convergence::FALSE && !timeBudget.hasTimeFor(iterationDuration)) ||
+        (convergence == multiple_shooting::Convergence::STEPSIZE && timeBudget.isExhausted())) {
+      convergence = multiple_shooting::Convergence::TIME;
+    }
+
     // Next iteration
     ++iter;
     ++totalNumIterations_;
@@ -180,7 +258,9 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
   setPrimalSolution(timeDiscretization, std::move(x), std::move(u));
   computeControllerTimer_.endTimer();
 
+  convergence_ = convergence;
   ++numProblems_;
+  recordPhaseDurations();
 
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\nConvergence : " << toString(convergence) << "\n";
@@ -190,10 +270,132 @@ void MultipleShootingSolver::runImpl(scalar_t initTime, const vector_t& initStat
   }
 }
 
+void MultipleShootingSolver::prepareRealTimeIteration(scalar_t initTime, scalar_t finalTime) {
+  if (primalSolution_.timeTrajectory_.empty()) {
+    return;  // Nothing to shift, the next run will prepare and solve at once.
+  }
+
+  linearQuadraticApproximationTimer_.startTimer();
+  rtiTimeDiscretization_ = getTimeDiscretization(initTime, finalTime);
+
+  // Linearize around the previous solution, shifted to the new horizon. The initial state is only predicted at this point.
+  const vector_t predictedInitState =
+      LinearInterpolation::interpolate(initTime, primalSolution_.timeTrajectory_, primalSolution_.stateTrajectory_);
+  initializeStateInputTrajectories(predictedInitState, rtiTimeDiscretization_, rtiStateTrajectory_, rtiInputTrajectory_);
+  rtiBaselinePerformance_ = setupQuadraticSubproblem(rtiTimeDiscretization_, rtiStateTrajectory_.front(), rtiStateTrajectory_,
+                                                     rtiInputTrajectory_, &rtiInitialNodePerformance_);
+  linearQuadraticApproximationTimer_.endTimer();
+
+  isRealTimeIterationPrepared_ = true;
+}
+
+void MultipleShootingSolver::runRealTimeIteration(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  const auto timeDiscretization = getTimeDiscretization(initTime, finalTime);
+
+  // Initialize references
+  for (auto& ocpDefinition : ocpDefinitions_) {
+    const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
+    ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
+  }
+
+  // Bookkeeping
+  performanceIndeces_.clear();
+
+  // The prepared QP can be used if it was set up on (nearly) the same grid, such that only the first node has to be moved to initTime.
+  // Otherwise, run the preparation phase now.
+  const auto isCompatibleGrid = [&]() {
+    if (rtiTimeDiscretization_.size() != timeDiscretization.size() || rtiTimeDiscretization_.size() < 2 ||
+        rtiTimeDiscretization_.front().event == AnnotatedTime::Event::PreEvent) {
+      return false;
+    }
+    const scalar_t firstIntervalDuration = rtiTimeDiscretization_[1].time - rtiTimeDiscretization_[0].time;
+    if (std::abs(rtiTimeDiscretization_.front().time - initTime) >= 0.5 * firstIntervalDuration) {
+      return false;
+    }
+    for (int i = 0; i < timeDiscretization.size(); i++) {
+      if (rtiTimeDiscretization_[i].event != timeDiscretization[i].event) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  auto& x = rtiStateTrajectory_;
+  auto& u = rtiInputTrajectory_;
+
+  linearQuadraticApproximationTimer_.startTimer();
+  if (isRealTimeIterationPrepared_ && isCompatibleGrid()) {
+    // The preparation started the horizon at the predicted initial time. Move the first node to the actual initial time, such that the
+    // policy starts at the observation, and re-linearize only the first interval.
+    rtiTimeDiscretization_.front().time = initTime;
+    const auto initialNodePerformance = setupNode(0, rtiTimeDiscretization_, 0, x, u);
+    rtiBaselinePerformance_ = replaceNodePerformance(rtiBaselinePerformance_, rtiInitialNodePerformance_, initialNodePerformance);
+  } else {
+    rtiTimeDiscretization_ = timeDiscretization;
+    initializeStateInputTrajectories(initState, rtiTimeDiscretization_, x, u);
+    rtiBaselinePerformance_ = setupQuadraticSubproblem(rtiTimeDiscretization_, initState, x, u);
+  }
+  linearQuadraticApproximationTimer_.endTimer();
+  isRealTimeIterationPrepared_ = false;
+
+  // Feedback phase: embed the measured initial state and solve the QP
+  solveQpTimer_.startTimer();
+  const vector_t delta_x0 = initState - x[0];
+  const auto& deltaSolution = getOCPSolution(rtiTimeDiscretization_, delta_x0);
+  solveQpTimer_.endTimer();
+
+  // Take the full step
+  for (int i = 0; i < u.size(); i++) {
+    if (deltaSolution.deltaUSol[i].size() > 0) {
+      u[i] += deltaSolution.deltaUSol[i];
+    }
+  }
+  for (int i = 0; i < x.size(); i++) {
+    x[i] += deltaSolution.deltaXSol[i];
+  }
+
+  // The logged performance is the one of the linearization point, with the actual initial state gap.
+  PerformanceIndex performance = rtiBaselinePerformance_;
+  performance.dynamicsViolationSSE += delta_x0.squaredNorm();
+  performanceIndeces_.push_back(performance);
+  ++totalNumIterations_;
+
+  computeControllerTimer_.startTimer();
+  setPrimalSolution(rtiTimeDiscretization_, std::move(x), std::move(u));
+  computeControllerTimer_.endTimer();
+
+  convergence_ = multiple_shooting::Convergence::ITERATIONS;  // a single iteration per run
+  ++numProblems_;
+}
+
 void MultipleShootingSolver::runParallel(std::function<void(int)> taskFunction) {
   threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
 }
 
+std::vector<AnnotatedTime> MultipleShootingSolver::getTimeDiscretization(scalar_t initTime, scalar_t finalTime) const {
+  const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
+  switch (settings_.timeGrid) {
+    case TimeGridType::GEOMETRIC: {
+      const auto stepSize = geometricStepSize(initTime, settings_.dt, settings_.dtGrowthFactor, settings_.dtMax);
+      return timeDiscretizationWithEvents(initTime, finalTime, stepSize, eventTimes);
+    }
+    case TimeGridType::PIECEWISE_UNIFORM: {
+      const auto stepSize = piecewiseUniformStepSize(initTime, settings_.dt, settings_.dtSwitchTimes, settings_.dtAfterSwitch);
+      return timeDiscretizationWithEvents(initTime, finalTime, stepSize, eventTimes);
+    }
+    case TimeGridType::ADAPTIVE: {
+      if (primalSolution_.timeTrajectory_.size() < 3) {
+        return timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);  // uniform until there is a previous solution
+      }
+      const auto stepSize = adaptiveStepSize(primalSolution_.timeTrajectory_, primalSolution_.stateTrajectory_, settings_.dt,
+                                             settings_.dtMin, settings_.dtMax);
+      return timeDiscretizationWithEvents(initTime, finalTime, stepSize, eventTimes);
+    }
+    default:
+      return timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+  }
+}
+
 void MultipleShootingSolver::initializeStateInputTrajectories(const vector_t& initState,
                                                               const std::vector<AnnotatedTime>& timeDiscretization,
                                                               vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
@@ -242,19 +444,60 @@ void MultipleShootingSolver::initializeStateInputTrajectories(const vector_t& in
   }
 }
 
-MultipleShootingSolver::OcpSubproblemSolution MultipleShootingSolver::getOCPSolution(const vector_t& delta_x0) {
-  // Solve the QP
-  OcpSubproblemSolution solution;
+const MultipleShootingSolver::OcpSubproblemSolution& MultipleShootingSolver::getOCPSolution(const std::vector<AnnotatedTime>& time,
+                                                                                           const vector_t& delta_x0) {
+  // Solve the QP. The solution is written into the workspace to reuse its memory.
+  OcpSubproblemSolution& solution = subproblemSolution_;
   auto& deltaXSol = solution.deltaXSol;
   auto& deltaUSol = solution.deltaUSol;
+
+  // With projection, the QP is solved for the projected input \tilde{du}, which is stored separately from du.
+  auto& qpInputSol = settings_.projectStateInputEqualityConstraints ? projectedDeltaUSol_ : deltaUSol;
+
   hpipm_status status;
-  const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
-  if (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) {
-    hpipmInterface_.resize(hpipm_interface::extractSizesFromProblem(dynamics_, cost_, &constraints_));
-    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, &constraints_, deltaXSol, deltaUSol, settings_.printSolverStatus);
-  } else {  // without constraints, or when using projection, we have an unconstrained QP.
-    hpipmInterface_.resize(hpipm_interface::extractSizesFromProblem(dynamics_, cost_, nullptr));
-    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+  isQpSolvedByPartitionedRiccati_ = false;
+  const auto& ocpDefinition = ocpDefinitions_.front();
+  const bool hasStateInputConstraints = !ocpDefinition.equalityConstraintPtr->empty();
+  const bool hasInequalityConstraints = !ocpDefinition.inequalityConstraintPtr->empty() ||
+                                        !ocpDefinition.finalInequalityConstraintPtr->empty() || !ocpDefinition.stateBoxConstraint.empty() ||
+                                        !ocpDefinition.inputBoxConstraint.empty();
+  const bool hasQpEqualityConstraints = hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints;
+  if (!hasInequalityConstraints && !hasQpEqualityConstraints && settings_.partitionedRiccati) {
+    // without constraints, or when using projection, we have an unconstrained QP, solved in parallel
+    partitionedRiccatiSolver_.solve(delta_x0, dynamics_, cost_, deltaXSol, qpInputSol, threadPool_, settings_.nThreads);
+    isQpSolvedByPartitionedRiccati_ = true;
+    status = hpipm_status::SUCCESS;
+  } else {
+    std::vector<VectorFunctionLinearApproximation>* constraintsPtr = nullptr;
+    std::vector<VectorFunctionLinearApproximation>* ineqConstraintsPtr = nullptr;
+    std::vector<BoxConstraint>* stateBoxesPtr = nullptr;
+    std::vector<BoxConstraint>* inputBoxesPtr = nullptr;
+    if (hasInequalityConstraints) {
+      constraintsPtr = settings_.projectStateInputEqualityConstraints ? nullptr : &constraints_;
+      ineqConstraintsPtr = &ineqConstraints_;
+      stateBoxesPtr = &stateBoxes_;
+      inputBoxesPtr = &inputBoxes_;
+    } else if (hasQpEqualityConstraints) {
+      constraintsPtr = &constraints_;
+    }
+    hpipmInterface_.resize(
+        hpipm_interface::extractSizesFromProblem(dynamics_, cost_, constraintsPtr, ineqConstraintsPtr, stateBoxesPtr, inputBoxesPtr));
+
+    if (settings_.qpWarmStart) {
+      setQpWarmStart(time);
+    }
+
+    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, constraintsPtr, ineqConstraintsPtr, stateBoxesPtr, inputBoxesPtr, deltaXSol,
+                                   qpInputSol, settings_.printSolverStatus);
+    totalNumQpIterations_ += hpipmInterface_.getNumIterations();
+
+    if (settings_.qpWarmStart) {
+      hpipmInterface_.getIterate(qpIterate_);
+      qpIterateTime_.resize(time.size());
+      for (int i = 0; i < time.size(); i++) {
+        qpIterateTime_[i] = time[i].time;
+      }
+    }
   }
 
   if (status != hpipm_status::SUCCESS) {
@@ -268,18 +511,20 @@ MultipleShootingSolver::OcpSubproblemSolution MultipleShootingSolver::getOCPSolu
       solution.armijoDescentMetric += cost_[i].dfdx.dot(deltaXSol[i]);
     }
     if (cost_[i].dfdu.size() > 0) {
-      solution.armijoDescentMetric += cost_[i].dfdu.dot(deltaUSol[i]);
+      solution.armijoDescentMetric += cost_[i].dfdu.dot(qpInputSol[i]);
     }
   }
 
   // remap the tilde delta u to real delta u
   if (settings_.projectStateInputEqualityConstraints) {
-    vector_t tmp;  // 1 temporary for re-use.
+    deltaUSol.resize(qpInputSol.size());
     for (int i = 0; i < deltaUSol.size(); i++) {
-      if (constraintsProjection_[i].f.size() > 0) {
-        tmp.noalias() = constraintsProjection_[i].dfdu * deltaUSol[i];
-        deltaUSol[i] = tmp + constraintsProjection_[i].f;
+      if (constraints_[i].f.size() > 0) {  // with projection, the nodes with constraints are projected
+        deltaUSol[i] = constraintsProjection_[i].f;
+        deltaUSol[i].noalias() += constraintsProjection_[i].dfdu * qpInputSol[i];
         deltaUSol[i].noalias() += constraintsProjection_[i].dfdx * deltaXSol[i];
+      } else {
+        deltaUSol[i] = qpInputSol[i];
       }
     }
   }
@@ -287,6 +532,29 @@ MultipleShootingSolver::OcpSubproblemSolution MultipleShootingSolver::getOCPSolu
   return solution;
 }
 
+void MultipleShootingSolver::setQpWarmStart(const std::vector<AnnotatedTime>& time) {
+  if (qpIterateTime_.empty()) {
+    return;  // No previous QP, cold start.
+  }
+
+  // Each node starts from the last node of the previous QP that is not later than the node itself. The QP variables are deviations from
+  // the linearization point, which already contains the step of the previous QP: the primal part restarts from zero.
+  shiftedQpIterate_.resize(time.size());
+  size_t previousNode = 0;
+  for (int i = 0; i < time.size(); i++) {
+    while (previousNode + 1 < qpIterateTime_.size() && qpIterateTime_[previousNode + 1] <= time[i].time) {
+      ++previousNode;
+    }
+    const auto& previousIterate = qpIterate_[previousNode];
+    auto& iterate = shiftedQpIterate_[i];
+    iterate.ux.setZero(previousIterate.ux.size());
+    iterate.pi = previousIterate.pi;
+    iterate.lam = previousIterate.lam;
+    iterate.t = previousIterate.t;
+  }
+  hpipmInterface_.setIterate(shiftedQpIterate_);
+}
+
 void MultipleShootingSolver::setPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
   // Clear old solution
   primalSolution_.clear();
@@ -305,7 +573,8 @@ void MultipleShootingSolver::setPrimalSolution(const std::vector<AnnotatedTime>&
     // see doc/LQR_full.pdf for detailed derivation for feedback terms
     uff = u;  // Copy and adapt in loop
     controllerGain.reserve(time.size());
-    matrix_array_t KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
+    matrix_array_t KMatrices = isQpSolvedByPartitionedRiccati_ ? partitionedRiccatiSolver_.getRiccatiFeedback()
+                                                               : hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
     for (int i = 0; (i + 1) < time.size(); i++) {
       if (time[i].event == AnnotatedTime::Event::PreEvent && i > 0) {
         uff[i] = uff[i - 1];
@@ -314,7 +583,7 @@ void MultipleShootingSolver::setPrimalSolution(const std::vector<AnnotatedTime>&
         // Linear controller has convention u = uff + K * x;
         // We computed u = u'(t) + K (x - x'(t));
         // >> uff = u'(t) - K x'(t)
-        if (constraintsProjection_[i].f.size() > 0) {
+        if (settings_.projectStateInputEqualityConstraints && constraints_[i].f.size() > 0) {
           controllerGain.push_back(std::move(constraintsProjection_[i].dfdx));  // Steal! Don't use after this.
           controllerGain.back().noalias() += constraintsProjection_[i].dfdu * KMatrices[i];
         } else {
@@ -350,7 +619,8 @@ void MultipleShootingSolver::setPrimalSolution(const std::vector<AnnotatedTime>&
 }
 
 PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState,
-                                                                  const vector_array_t& x, const vector_array_t& u) {
+                                                                  const vector_array_t& x, const vector_array_t& u,
+                                                                  PerformanceIndex* initialNodePerformance) {
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
 
@@ -359,46 +629,30 @@ PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vec
   cost_.resize(N + 1);
   constraints_.resize(N + 1);
   constraintsProjection_.resize(N);
+  ineqConstraints_.resize(N + 1);
+  stateBoxes_.resize(N + 1);
+  inputBoxes_.resize(N);
 
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
     PerformanceIndex workerPerformance;  // Accumulate performance in local variable
-    const bool projection = settings_.projectStateInputEqualityConstraints;
 
     int i = timeIndex++;
     while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
-        // Event node
-        auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        workerPerformance += result.performance;
-        dynamics_[i] = std::move(result.dynamics);
-        cost_[i] = std::move(result.cost);
-        constraints_[i] = std::move(result.constraints);
-        constraintsProjection_[i] = VectorFunctionLinearApproximation::Zero(0, x[i].size(), 0);
-      } else {
-        // Normal, intermediate node
-        const scalar_t ti = getIntervalStart(time[i]);
-        const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result =
-            multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, projection, ti, dt, x[i], x[i + 1], u[i]);
-        workerPerformance += result.performance;
-        dynamics_[i] = std::move(result.dynamics);
-        cost_[i] = std::move(result.cost);
-        constraints_[i] = std::move(result.constraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
+      const auto nodePerformance = setupNode(workerId, time, i, x, u);
+      if (i == 0 && initialNodePerformance != nullptr) {
+        *initialNodePerformance = nodePerformance;
       }
+      workerPerformance += nodePerformance;
 
       i = timeIndex++;
     }
 
     if (i == N) {  // Only one worker will execute this
       const scalar_t tN = getIntervalStart(time[N]);
-      auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
-      workerPerformance += result.performance;
-      cost_[i] = std::move(result.cost);
-      constraints_[i] = std::move(result.constraints);
+      workerPerformance += multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N], cost_[N], constraints_[N], ineqConstraints_[N]);
     }
 
     // Accumulate! Same worker might run multiple tasks
@@ -415,6 +669,35 @@ PerformanceIndex MultipleShootingSolver::setupQuadraticSubproblem(const std::vec
   return totalPerformance;
 }
 
+PerformanceIndex MultipleShootingSolver::setupNode(int workerId, const std::vector<AnnotatedTime>& time, int i, const vector_array_t& x,
+                                                   const vector_array_t& u) {
+  OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
+  if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    // Event node
+    ineqConstraints_[i].setZero(0, x[i].size(), 0);
+    inputBoxes_[i] = BoxConstraint();
+    return multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1], dynamics_[i], cost_[i], constraints_[i],
+                                             stateBoxes_[i + 1]);
+  } else {
+    // Normal, intermediate node
+    const scalar_t ti = getIntervalStart(time[i]);
+    const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+    return multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, settings_.projectStateInputEqualityConstraints,
+                                                    ti, dt, x[i], x[i + 1], u[i], dynamics_[i], cost_[i], constraints_[i],
+                                                    constraintsProjection_[i], ineqConstraints_[i], stateBoxes_[i + 1], inputBoxes_[i]);
+  }
+}
+
+void MultipleShootingSolver::swapFullStepApproximation() {
+  dynamics_.swap(fullStepDynamics_);
+  cost_.swap(fullStepCost_);
+  constraints_.swap(fullStepConstraints_);
+  constraintsProjection_.swap(fullStepConstraintsProjection_);
+  ineqConstraints_.swap(fullStepIneqConstraints_);
+  stateBoxes_.swap(fullStepStateBoxes_);
+  inputBoxes_.swap(fullStepInputBoxes_);
+}
+
 PerformanceIndex MultipleShootingSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState,
                                                             const vector_array_t& x, const vector_array_t& u) {
   // Problem horizon
@@ -461,6 +744,39 @@ PerformanceIndex MultipleShootingSolver::computePerformance(const std::vector<An
   return totalPerformance;
 }
 
+PerformanceIndex MultipleShootingSolver::computePerformanceOnWorker(int workerId, const std::vector<AnnotatedTime>& time,
+                                                                    const vector_t& initState, const vector_array_t& x,
+                                                                    const vector_array_t& u) {
+  // Problem horizon
+  const int N = static_cast<int>(time.size()) - 1;
+
+  // Get worker specific resources
+  OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
+
+  PerformanceIndex performance;
+  for (int i = 0; i < N; i++) {
+    if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      // Event node
+      performance += multiple_shooting::computeEventPerformance(ocpDefinition, time[i].time, x[i], x[i + 1]);
+    } else {
+      // Normal, intermediate node
+      const scalar_t ti = getIntervalStart(time[i]);
+      const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+      performance += multiple_shooting::computeIntermediatePerformance(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+    }
+  }
+
+  // Terminal node
+  const scalar_t tN = getIntervalStart(time[N]);
+  performance += multiple_shooting::computeTerminalPerformance(ocpDefinition, tN, x[N]);
+
+  // Account for init state in performance
+  performance.dynamicsViolationSSE += (initState - x.front()).squaredNorm();
+
+  performance.merit = performance.cost + performance.equalityLagrangian + performance.inequalityLagrangian;
+  return performance;
+}
+
 scalar_t MultipleShootingSolver::trajectoryNorm(const vector_array_t& v) {
   scalar_t norm = 0.0;
   for (const auto& vi : v) {
@@ -470,13 +786,13 @@ scalar_t MultipleShootingSolver::trajectoryNorm(const vector_array_t& v) {
 }
 
 scalar_t MultipleShootingSolver::totalConstraintViolation(const PerformanceIndex& performance) const {
-  return std::sqrt(performance.dynamicsViolationSSE + performance.equalityConstraintsSSE);
+  return std::sqrt(performance.dynamicsViolationSSE + performance.equalityConstraintsSSE + performance.inequalityConstraintsSSE);
 }
 
 multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIndex& baseline,
                                                              const std::vector<AnnotatedTime>& timeDiscretization,
                                                              const vector_t& initState, const OcpSubproblemSolution& subproblemSolution,
-                                                             vector_array_t& x, vector_array_t& u) {
+                                                             vector_array_t& x, vector_array_t& u, bool isLinearizationExpected) {
   using StepType = multiple_shooting::StepInfo::StepType;
 
   /*
@@ -499,13 +815,30 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
   const scalar_t deltaUnorm = trajectoryNorm(du);
   const scalar_t deltaXnorm = trajectoryNorm(dx);
 
+  // The full step is linearized right away if the next iteration needs its linearization once it is accepted, i.e. if the solver does not
+  // terminate on the number of iterations or on the step size.
+  const bool linearizeFullStep = settings_.linearizeFullStep && isLinearizationExpected &&
+                                 (deltaXnorm >= settings_.deltaTol || deltaUnorm >= settings_.deltaTol);
+
   // Prepare step info
   multiple_shooting::StepInfo stepInfo;
 
+  // Trial trajectories, reused from the workspace
+  vector_array_t& xNew = xTrial_.front();
+  vector_array_t& uNew = uTrial_.front();
+  xNew.resize(x.size());
+  uNew.resize(u.size());
+
   scalar_t alpha = 1.0;
-  vector_array_t xNew(x.size());
-  vector_array_t uNew(u.size());
   do {
+    // Stop if the time budget is exhausted. Not taking a step keeps the current iterate.
+    if (getTimeBudget().isExhausted()) {
+      if (settings_.printLinesearch) {
+        std::cerr << "Exiting linesearch early due to the exhausted time budget\n";
+      }
+      break;
+    }
+
     // Compute step
     for (int i = 0; i < u.size(); i++) {
       if (du[i].size() > 0) {  // account for absence of inputs at events.
@@ -517,27 +850,19 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
     }
 
     // Compute cost and constraints
-    const PerformanceIndex performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew);
+    const bool isFullStepLinearized = linearizeFullStep && alpha == 1.0;
+    PerformanceIndex performanceNew;
+    if (isFullStepLinearized) {
+      swapFullStepApproximation();
+      performanceNew = setupQuadraticSubproblem(timeDiscretization, initState, xNew, uNew);
+      swapFullStepApproximation();
+    } else {
+      performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew);
+    }
     const scalar_t newConstraintViolation = totalConstraintViolation(performanceNew);
 
     // Step acceptance and record step type
-    const bool stepAccepted = [&]() {
-      if (newConstraintViolation > settings_.g_max) {
-        // High constraint violation. Only accept decrease in constraints.
-        stepInfo.stepType = StepType::CONSTRAINT;
-        return newConstraintViolation < ((1.0 - settings_.gamma_c) * baselineConstraintViolation);
-      } else if (newConstraintViolation < settings_.g_min && baselineConstraintViolation < settings_.g_min &&
-                 subproblemSolution.armijoDescentMetric < 0.0) {
-        // With low violation and having a descent direction, require the armijo condition.
-        stepInfo.stepType = StepType::COST;
-        return performanceNew.merit < (baseline.merit + settings_.armijoFactor * alpha * subproblemSolution.armijoDescentMetric);
-      } else {
-        // Medium violation: either merit or constraints decrease (with small gamma_c mixing of old constraints)
-        stepInfo.stepType = StepType::DUAL;
-        return performanceNew.merit < (baseline.merit - settings_.gamma_c * baselineConstraintViolation) ||
-               newConstraintViolation < ((1.0 - settings_.gamma_c) * baselineConstraintViolation);
-      }
-    }();
+    const bool stepAccepted = isStepAccepted(baseline, performanceNew, alpha, subproblemSolution.armijoDescentMetric, stepInfo.stepType);
 
     if (settings_.printLinesearch) {
       std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepInfo.stepType)
@@ -546,9 +871,14 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
       std::cerr << performanceNew << "\n";
     }
 
-    if (stepAccepted) {  // Return if step accepted
-      x = std::move(xNew);
-      u = std::move(uNew);
+    if (stepAccepted) {  // Return if step accepted. Swap, such that the old trajectories are reused as workspace.
+      x.swap(xNew);
+      u.swap(uNew);
+
+      if (isFullStepLinearized) {  // The LQ approximation of the full step is the next QP
+        isFullStepApproximationAccepted_ = true;
+        fullStepPerformance_ = performanceNew;
+      }
 
       stepInfo.stepSize = alpha;
       stepInfo.dx_norm = alpha * deltaXnorm;
@@ -570,7 +900,7 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
     }
   } while (alpha >= settings_.alpha_min);
 
-  // Alpha_min reached -> Don't take a step
+  // Alpha_min reached or out of time -> Don't take a step
   stepInfo.stepSize = 0.0;
   stepInfo.stepType = StepType::ZERO;
   stepInfo.dx_norm = 0.0;
@@ -585,6 +915,179 @@ multiple_shooting::StepInfo MultipleShootingSolver::takeStep(const PerformanceIn
   return stepInfo;
 }
 
+multiple_shooting::StepInfo MultipleShootingSolver::takeStepInParallel(const PerformanceIndex& baseline,
+                                                                       const std::vector<AnnotatedTime>& timeDiscretization,
+                                                                       const vector_t& initState,
+                                                                       const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
+                                                                       vector_array_t& u) {
+  using StepType = multiple_shooting::StepInfo::StepType;
+
+  /*
+   * Same filter linesearch as in takeStep(), but the step size candidates {1, alpha_decay, alpha_decay^2, ...} are distributed over the
+   * workers. Each worker evaluates the performance of its candidate over the full horizon with its own copy of the optimal control
+   * problem. Among the accepted candidates, the largest step size is taken. This is the step that the sequential search would take.
+   */
+  if (settings_.printLinesearch) {
+    std::cerr << std::setprecision(9) << std::fixed;
+    std::cerr << "\n=== Linesearch (parallel) ===\n";
+    std::cerr << "Baseline:\n" << baseline << "\n";
+  }
+
+  // Baseline costs
+  const scalar_t baselineConstraintViolation = totalConstraintViolation(baseline);
+
+  // Update norm
+  const auto& dx = subproblemSolution.deltaXSol;
+  const auto& du = subproblemSolution.deltaUSol;
+  const scalar_t deltaUnorm = trajectoryNorm(du);
+  const scalar_t deltaXnorm = trajectoryNorm(dx);
+
+  // Step size candidates. Stops at alpha_min or when the primal steps become too small, identical to the sequential back-tracking.
+  std::vector<scalar_t> alphaCandidates{1.0};
+  for (scalar_t alpha = settings_.alpha_decay; alpha >= settings_.alpha_min; alpha *= settings_.alpha_decay) {
+    if (alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol) {
+      break;
+    }
+    alphaCandidates.push_back(alpha);
+  }
+  const int numCandidates = static_cast<int>(alphaCandidates.size());
+
+  // Results per candidate, only valid for the evaluated candidates
+  std::vector<bool> candidateEvaluated(numCandidates, false);
+  std::vector<bool> candidateAccepted(numCandidates, false);
+  std::vector<StepType> candidateStepType(numCandidates, StepType::UNKNOWN);
+  std::vector<PerformanceIndex> candidatePerformance(numCandidates);
+
+  // Worker specific trial trajectories. The trajectories of the best accepted candidate are swapped into the last slot.
+  vector_array_t& xBest = xTrial_.back();
+  vector_array_t& uBest = uTrial_.back();
+
+  std::mutex linesearchMutex;
+  int bestCandidate = numCandidates;  // index of the largest accepted step size, guarded by linesearchMutex
+  std::atomic_int nextCandidate{0};
+  auto parallelTask = [&](int workerId) {
+    vector_array_t& xNew = xTrial_[workerId];
+    vector_array_t& uNew = uTrial_[workerId];
+
+    int k = nextCandidate++;
+    while (k < numCandidates) {
+      {  // skip if a larger step size is already accepted. All later candidates are smaller.
+        std::lock_guard<std::mutex> lock(linesearchMutex);
+        if (k > bestCandidate) {
+          break;
+        }
+      }
+
+      // Stop if the time budget is exhausted. Not taking a step keeps the current iterate.
+      if (getTimeBudget().isExhausted()) {
+        break;
+      }
+
+      // Compute step
+      const scalar_t alpha = alphaCandidates[k];
+      xNew.resize(x.size());
+      uNew.resize(u.size());
+      for (int i = 0; i < u.size(); i++) {
+        if (du[i].size() > 0) {  // account for absence of inputs at events.
+          uNew[i] = u[i] + alpha * du[i];
+        }
+      }
+      for (int i = 0; i < x.size(); i++) {
+        xNew[i] = x[i] + alpha * dx[i];
+      }
+
+      // Compute cost and constraints
+      const PerformanceIndex performanceNew = computePerformanceOnWorker(workerId, timeDiscretization, initState, xNew, uNew);
+
+      // Step acceptance and record step type
+      StepType stepType;
+      const bool stepAccepted = isStepAccepted(baseline, performanceNew, alpha, subproblemSolution.armijoDescentMetric, stepType);
+
+      {  // Record result
+        std::lock_guard<std::mutex> lock(linesearchMutex);
+        candidateEvaluated[k] = true;
+        candidateAccepted[k] = stepAccepted;
+        candidateStepType[k] = stepType;
+        candidatePerformance[k] = performanceNew;
+        if (stepAccepted && k < bestCandidate) {
+          bestCandidate = k;
+          xBest.swap(xNew);
+          uBest.swap(uNew);
+        }
+      }
+
+      k = nextCandidate++;
+    }
+  };
+  runParallel(std::move(parallelTask));
+
+  if (settings_.printLinesearch) {
+    for (int k = 0; k < numCandidates; k++) {
+      if (candidateEvaluated[k]) {
+        const scalar_t alpha = alphaCandidates[k];
+        std::cerr << "Step size: " << alpha << ", Step Type: " << toString(candidateStepType[k])
+                  << (candidateAccepted[k] ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
+        std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
+        std::cerr << candidatePerformance[k] << "\n";
+      }
+    }
+  }
+
+  // Prepare step info
+  multiple_shooting::StepInfo stepInfo;
+
+  if (bestCandidate < numCandidates) {  // Return if a step is accepted. Swap, such that the old trajectories are reused as workspace.
+    x.swap(xBest);
+    u.swap(uBest);
+
+    const scalar_t alpha = alphaCandidates[bestCandidate];
+    stepInfo.stepSize = alpha;
+    stepInfo.stepType = candidateStepType[bestCandidate];
+    stepInfo.dx_norm = alpha * deltaXnorm;
+    stepInfo.du_norm = alpha * deltaUnorm;
+    stepInfo.performanceAfterStep = candidatePerformance[bestCandidate];
+    stepInfo.totalConstraintViolationAfterStep = totalConstraintViolation(candidatePerformance[bestCandidate]);
+    return stepInfo;
+  }
+
+  // No candidate accepted or out of time -> Don't take a step
+  stepInfo.stepSize = 0.0;
+  stepInfo.stepType = StepType::ZERO;
+  stepInfo.dx_norm = 0.0;
+  stepInfo.du_norm = 0.0;
+  stepInfo.performanceAfterStep = baseline;
+  stepInfo.totalConstraintViolationAfterStep = baselineConstraintViolation;
+
+  if (settings_.printLinesearch) {
+    std::cerr << "[Linesearch terminated] Step size: " << stepInfo.stepSize << ", Step Type: " << toString(stepInfo.stepType) << "\n";
+  }
+
+  return stepInfo;
+}
+
+bool MultipleShootingSolver::isStepAccepted(const PerformanceIndex& baseline, const PerformanceIndex& performanceNew, scalar_t alpha,
+                                            scalar_t armijoDescentMetric, multiple_shooting::StepInfo::StepType& stepType) const {
+  using StepType = multiple_shooting::StepInfo::StepType;
+
+  const scalar_t baselineConstraintViolation = totalConstraintViolation(baseline);
+  const scalar_t newConstraintViolation = totalConstraintViolation(performanceNew);
+
+  if (newConstraintViolation > settings_.g_max) {
+    // High constraint violation. Only accept decrease in constraints.
+    stepType = StepType::CONSTRAINT;
+    return newConstraintViolation < ((1.0 - settings_.gamma_c) * baselineConstraintViolation);
+  } else if (newConstraintViolation < settings_.g_min && baselineConstraintViolation < settings_.g_min && armijoDescentMetric < 0.0) {
+    // With low violation and having a descent direction, require the armijo condition.
+    stepType = StepType::COST;
+    return performanceNew.merit < (baseline.merit + settings_.armijoFactor * alpha * armijoDescentMetric);
+  } else {
+    // Medium violation: either merit or constraints decrease (with small gamma_c mixing of old constraints)
+    stepType = StepType::DUAL;
+    return performanceNew.merit < (baseline.merit - settings_.gamma_c * baselineConstraintViolation) ||
+           newConstraintViolation < ((1.0 - settings_.gamma_c) * baselineConstraintViolation);
+  }
+}
+
 multiple_shooting::Convergence MultipleShootingSolver::checkConvergence(int iteration, const PerformanceIndex& baseline,
                                                                         const multiple_shooting::StepInfo& stepInfo) const {
   using Convergence = multiple_shooting::Convergence;
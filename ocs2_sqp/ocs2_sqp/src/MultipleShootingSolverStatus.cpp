@@ -59,6 +59,8 @@ std::string toString(const Convergence& convergence) {
       return "Cost decrease and constraint satisfaction below tolerance";
     case Convergence::PRIMAL:
       return "Primal update below tolerance";
+    case Convergence::TIME:
+      return "Time budget exhausted";
     case Convergence::FALSE:
     default:
       return "Not Converged";
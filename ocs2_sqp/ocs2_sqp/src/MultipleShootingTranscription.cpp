@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/MultipleShootingTranscription.h"
 
+#include <cmath>
+
 #include <ocs2_oc/approximate_model/ChangeOfInputVariables.h>
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
 
@@ -37,51 +39,153 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace multiple_shooting {
 
+namespace {
+/** Squared norm of the violation of h >= 0 */
+scalar_t inequalityViolationSquaredNorm(const vector_t& h) {
+  return h.cwiseMin(0.0).squaredNorm();
+}
+
+/** Squared norm of the violation of the box constraint by v */
+scalar_t boxViolationSquaredNorm(const BoxConstraint& box, const vector_t& v) {
+  scalar_t violationSSE = 0.0;
+  for (int i = 0; i < box.size(); i++) {
+    const scalar_t vi = v[box.indices[i]];
+    const scalar_t violation = std::max(box.lowerBound[i] - vi, 0.0) + std::max(vi - box.upperBound[i], 0.0);
+    violationSSE += violation * violation;
+  }
+  return violationSSE;
+}
+
+/** Bounds on the deviation dv from v: lowerBound - v[indices] <= dv[indices] <= upperBound - v[indices] */
+void setupDeviationBox(const BoxConstraint& box, const vector_t& v, BoxConstraint& deviationBox) {
+  deviationBox.indices = box.indices;
+  deviationBox.lowerBound = box.lowerBound;
+  deviationBox.upperBound = box.upperBound;
+  for (int i = 0; i < box.size(); i++) {
+    deviationBox.lowerBound[i] -= v[box.indices[i]];
+    deviationBox.upperBound[i] -= v[box.indices[i]];
+  }
+}
+
+/** Appends the finite bounds of the input box as rows of the inequality constraints (h >= 0) */
+void appendInputBoxToInequalities(const BoxConstraint& inputBox, VectorFunctionLinearApproximation& ineqConstraints) {
+  int numBounds = 0;
+  for (int i = 0; i < inputBox.size(); i++) {
+    numBounds += std::isfinite(inputBox.lowerBound[i]) ? 1 : 0;
+    numBounds += std::isfinite(inputBox.upperBound[i]) ? 1 : 0;
+  }
+
+  const int numIneq = ineqConstraints.f.size();
+  ineqConstraints.f.conservativeResize(numIneq + numBounds);
+  ineqConstraints.dfdx.conservativeResize(numIneq + numBounds, Eigen::NoChange);
+  ineqConstraints.dfdu.conservativeResize(numIneq + numBounds, Eigen::NoChange);
+  ineqConstraints.dfdx.bottomRows(numBounds).setZero();
+  ineqConstraints.dfdu.bottomRows(numBounds).setZero();
+
+  int row = numIneq;
+  for (int i = 0; i < inputBox.size(); i++) {
+    if (std::isfinite(inputBox.lowerBound[i])) {  // du[j] - lowerBound >= 0
+      ineqConstraints.dfdu(row, inputBox.indices[i]) = 1.0;
+      ineqConstraints.f[row] = -inputBox.lowerBound[i];
+      row++;
+    }
+    if (std::isfinite(inputBox.upperBound[i])) {  // upperBound - du[j] >= 0
+      ineqConstraints.dfdu(row, inputBox.indices[i]) = -1.0;
+      ineqConstraints.f[row] = inputBox.upperBound[i];
+      row++;
+    }
+  }
+}
+}  // namespace
+
 Transcription setupIntermediateNode(const OptimalControlProblem& optimalControlProblem,
                                     DynamicsSensitivityDiscretizer& sensitivityDiscretizer, bool projectStateInputEqualityConstraints,
                                     scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
-  // Results and short-hand notation
   Transcription transcription;
-  auto& dynamics = transcription.dynamics;
-  auto& performance = transcription.performance;
-  auto& cost = transcription.cost;
-  auto& constraints = transcription.constraints;
-  auto& projection = transcription.constraintsProjection;
+  transcription.performance =
+      setupIntermediateNode(optimalControlProblem, sensitivityDiscretizer, projectStateInputEqualityConstraints, t, dt, x, x_next, u,
+                            transcription.dynamics, transcription.cost, transcription.constraints, transcription.constraintsProjection,
+                            transcription.ineqConstraints, transcription.nextStateBox, transcription.inputBox);
+  return transcription;
+}
+
+PerformanceIndex setupIntermediateNode(const OptimalControlProblem& optimalControlProblem,
+                                       DynamicsSensitivityDiscretizer& sensitivityDiscretizer, bool projectStateInputEqualityConstraints,
+                                       scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u,
+                                       VectorFunctionLinearApproximation& dynamics, ScalarFunctionQuadraticApproximation& cost,
+                                       VectorFunctionLinearApproximation& constraints,
+                                       VectorFunctionLinearApproximation& constraintsProjection,
+                                       VectorFunctionLinearApproximation& ineqConstraints, BoxConstraint& nextStateBox,
+                                       BoxConstraint& inputBox) {
+  PerformanceIndex performance;
 
   // Dynamics
   // Discretization returns x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
-  dynamics = sensitivityDiscretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt);
-  dynamics.f -= x_next;  // make it dx_{k+1} = ...
-  performance.dynamicsViolationSSE = dt * dynamics.f.squaredNorm();
+  auto discreteDynamics = sensitivityDiscretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt);
+  discreteDynamics.f -= x_next;  // make it dx_{k+1} = ...
+  performance.dynamicsViolationSSE = dt * discreteDynamics.f.squaredNorm();
 
   // Precomputation for other terms
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Approximation;
   optimalControlProblem.preComputationPtr->request(request, t, x, u);
 
   // Costs: Approximate the integral with forward euler
-  cost = approximateCost(optimalControlProblem, t, x, u);
-  cost *= dt;
-  performance.cost = cost.f;
+  auto costApproximation = approximateCost(optimalControlProblem, t, x, u);
+  costApproximation *= dt;
+  performance.cost = costApproximation.f;
 
   // Constraints
+  bool isProjected = false;
   if (!optimalControlProblem.equalityConstraintPtr->empty()) {
     // C_{k} * dx_{k} + D_{k} * du_{k} + e_{k} = 0
     constraints = optimalControlProblem.equalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
     if (constraints.f.size() > 0) {
       performance.equalityConstraintsSSE = dt * constraints.f.squaredNorm();
       if (projectStateInputEqualityConstraints) {  // Handle equality constraints using projection.
-        // Projection stored instead of constraint, // TODO: benchmark between lu and qr method. LU seems slightly faster.
-        projection = luConstraintProjection(constraints);
-        constraints = VectorFunctionLinearApproximation();
+        // LU is faster than QR for typical sizes (see benchmark/benchmarkProjection.cpp)
+        constraintsProjection = luConstraintProjection(constraints);
+        isProjected = true;
 
         // Adapt dynamics and cost
-        changeOfInputVariables(dynamics, projection.dfdu, projection.dfdx, projection.f);
-        changeOfInputVariables(cost, projection.dfdu, projection.dfdx, projection.f);
+        changeOfInputVariables(discreteDynamics, constraintsProjection.dfdu, constraintsProjection.dfdx, constraintsProjection.f);
+        changeOfInputVariables(costApproximation, constraintsProjection.dfdu, constraintsProjection.dfdx, constraintsProjection.f);
       }
     }
+  } else {
+    constraints.setZero(0, x.size(), u.size());
+  }
+  dynamics = std::move(discreteDynamics);
+  cost = std::move(costApproximation);
+
+  // Inequality constraints
+  // C_{k} * dx_{k} + D_{k} * du_{k} + e_{k} >= 0
+  VectorFunctionLinearApproximation ineqApproximation;
+  if (!optimalControlProblem.inequalityConstraintPtr->empty()) {
+    ineqApproximation =
+        optimalControlProblem.inequalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
+    performance.inequalityConstraintsSSE = dt * inequalityViolationSquaredNorm(ineqApproximation.f);
+  } else {
+    ineqApproximation.setZero(0, x.size(), u.size());
   }
 
-  return transcription;
+  // Box constraints
+  setupDeviationBox(optimalControlProblem.stateBoxConstraint, x_next, nextStateBox);
+  performance.inequalityConstraintsSSE += dt * boxViolationSquaredNorm(optimalControlProblem.stateBoxConstraint, x_next);
+  performance.inequalityConstraintsSSE += dt * boxViolationSquaredNorm(optimalControlProblem.inputBoxConstraint, u);
+
+  if (isProjected) {
+    // The input is no longer a decision variable after the projection: Input bounds become general inequalities on the projected input.
+    BoxConstraint deviationInputBox;
+    setupDeviationBox(optimalControlProblem.inputBoxConstraint, u, deviationInputBox);
+    appendInputBoxToInequalities(deviationInputBox, ineqApproximation);
+    changeOfInputVariables(ineqApproximation, constraintsProjection.dfdu, constraintsProjection.dfdx, constraintsProjection.f);
+    inputBox = BoxConstraint();
+  } else {
+    setupDeviationBox(optimalControlProblem.inputBoxConstraint, u, inputBox);
+  }
+  ineqConstraints = std::move(ineqApproximation);
+
+  return performance;
 }
 
 PerformanceIndex computeIntermediatePerformance(const OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer,
@@ -107,47 +211,79 @@ PerformanceIndex computeIntermediatePerformance(const OptimalControlProblem& opt
       performance.equalityConstraintsSSE = dt * constraints.squaredNorm();
     }
   }
+  if (!optimalControlProblem.inequalityConstraintPtr->empty()) {
+    const vector_t ineqConstraints =
+        optimalControlProblem.inequalityConstraintPtr->getValue(t, x, u, *optimalControlProblem.preComputationPtr);
+    performance.inequalityConstraintsSSE = dt * inequalityViolationSquaredNorm(ineqConstraints);
+  }
+  performance.inequalityConstraintsSSE += dt * boxViolationSquaredNorm(optimalControlProblem.stateBoxConstraint, x_next);
+  performance.inequalityConstraintsSSE += dt * boxViolationSquaredNorm(optimalControlProblem.inputBoxConstraint, u);
 
   return performance;
 }
 
 TerminalTranscription setupTerminalNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x) {
-  // Results and short-hand notation
   TerminalTranscription transcription;
-  auto& performance = transcription.performance;
-  auto& cost = transcription.cost;
-  auto& constraints = transcription.constraints;
+  transcription.performance =
+      setupTerminalNode(optimalControlProblem, t, x, transcription.cost, transcription.constraints, transcription.ineqConstraints);
+  return transcription;
+}
+
+PerformanceIndex setupTerminalNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
+                                   ScalarFunctionQuadraticApproximation& cost, VectorFunctionLinearApproximation& constraints,
+                                   VectorFunctionLinearApproximation& ineqConstraints) {
+  PerformanceIndex performance;
 
-  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Approximation;
+  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Approximation;
   optimalControlProblem.preComputationPtr->requestFinal(request, t, x);
 
   cost = approximateFinalCost(optimalControlProblem, t, x);
   performance.cost = cost.f;
 
-  constraints = VectorFunctionLinearApproximation::Zero(0, x.size(), 0);
+  constraints.setZero(0, x.size(), 0);
 
-  return transcription;
+  if (!optimalControlProblem.finalInequalityConstraintPtr->empty()) {
+    ineqConstraints =
+        optimalControlProblem.finalInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+    ineqConstraints.dfdu.setZero(ineqConstraints.f.size(), 0);
+    performance.inequalityConstraintsSSE = inequalityViolationSquaredNorm(ineqConstraints.f);
+  } else {
+    ineqConstraints.setZero(0, x.size(), 0);
+  }
+
+  return performance;
 }
 
 PerformanceIndex computeTerminalPerformance(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x) {
   PerformanceIndex performance;
 
-  constexpr auto request = Request::Cost + Request::SoftConstraint;
+  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint;
   optimalControlProblem.preComputationPtr->requestFinal(request, t, x);
 
   performance.cost = computeFinalCost(optimalControlProblem, t, x);
 
+  if (!optimalControlProblem.finalInequalityConstraintPtr->empty()) {
+    const vector_t ineqConstraints =
+        optimalControlProblem.finalInequalityConstraintPtr->getValue(t, x, *optimalControlProblem.preComputationPtr);
+    performance.inequalityConstraintsSSE = inequalityViolationSquaredNorm(ineqConstraints);
+  }
+
   return performance;
 }
 
 EventTranscription setupEventNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
                                   const vector_t& x_next) {
-  // Results and short-hand notation
   EventTranscription transcription;
-  auto& performance = transcription.performance;
-  auto& dynamics = transcription.dynamics;
-  auto& cost = transcription.cost;
-  auto& constraints = transcription.constraints;
+  transcription.performance =
+      setupEventNode(optimalControlProblem, t, x, x_next, transcription.dynamics, transcription.cost, transcription.constraints,
+                     transcription.nextStateBox);
+  return transcription;
+}
+
+PerformanceIndex setupEventNode(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next,
+                                VectorFunctionLinearApproximation& dynamics, ScalarFunctionQuadraticApproximation& cost,
+                                VectorFunctionLinearApproximation& constraints, BoxConstraint& nextStateBox) {
+  PerformanceIndex performance;
 
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Dynamics + Request::Approximation;
   optimalControlProblem.preComputationPtr->requestPreJump(request, t, x);
@@ -162,8 +298,12 @@ EventTranscription setupEventNode(const OptimalControlProblem& optimalControlPro
   cost = approximateEventCost(optimalControlProblem, t, x);
   performance.cost = cost.f;
 
-  constraints = VectorFunctionLinearApproximation::Zero(0, x.size(), 0);
-  return transcription;
+  constraints.setZero(0, x.size(), 0);
+
+  setupDeviationBox(optimalControlProblem.stateBoxConstraint, x_next, nextStateBox);
+  performance.inequalityConstraintsSSE = boxViolationSquaredNorm(optimalControlProblem.stateBoxConstraint, x_next);
+
+  return performance;
 }
 
 PerformanceIndex computeEventPerformance(const OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x,
@@ -179,6 +319,8 @@ PerformanceIndex computeEventPerformance(const OptimalControlProblem& optimalCon
 
   performance.cost = computeEventCost(optimalControlProblem, t, x);
 
+  performance.inequalityConstraintsSSE = boxViolationSquaredNorm(optimalControlProblem.stateBoxConstraint, x_next);
+
   return performance;
 }
 
@@ -0,0 +1,247 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_sqp/PartitionedRiccatiSolver.h"
+
+#include <atomic>
+
+namespace ocs2 {
+
+void PartitionedRiccatiSolver::solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                     const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& stateTrajectory,
+                                     vector_array_t& inputTrajectory, ThreadPool& threadPool, size_t numThreads) {
+  const int N = static_cast<int>(dynamics.size());
+  const int numSegments = std::max(1, std::min(static_cast<int>(numThreads), N));
+
+  // Split the horizon into segments of (nearly) equal length
+  segmentStarts_.resize(numSegments + 1);
+  for (int j = 0; j <= numSegments; j++) {
+    segmentStarts_[j] = (j * N) / numSegments;
+  }
+  segmentValueFunctions_.resize(numSegments);
+  boundaryValueHessians_.resize(numSegments + 1);
+  boundaryValueGradients_.resize(numSegments + 1);
+  boundaryValueHessians_[numSegments] = cost[N].dfdxx;
+  boundaryValueGradients_[numSegments] = cost[N].dfdx;
+  feedbackGains_.resize(N);
+  feedforwardInputs_.resize(N);
+  stateTrajectory.resize(N + 1);
+  inputTrajectory.resize(N);
+  stateTrajectory[0] = x0;
+
+  std::atomic_int nextSegment{0};
+  // The flags are only ever cleared by the tasks, so a failure in one segment cannot be overwritten by another.
+  std::atomic_bool success{true};
+  std::atomic_bool isCondensed{true};
+
+  // Phase 1: condense the segments. The last one directly gets its value function from the final cost.
+  auto condenseTask = [&](int) {
+    int j;
+    while ((j = nextSegment++) < numSegments) {
+      const int start = segmentStarts_[j];
+      const int end = segmentStarts_[j + 1];
+      if (j == numSegments - 1) {
+        matrix_t S = boundaryValueHessians_[j + 1];
+        vector_t s = boundaryValueGradients_[j + 1];
+        if (!riccatiRecursion(start, end, dynamics, cost, S, s)) {
+          success = false;
+        }
+        boundaryValueHessians_[j] = std::move(S);
+        boundaryValueGradients_[j] = std::move(s);
+      } else {
+        if (!condenseSegment(start, end, dynamics, cost, segmentValueFunctions_[j])) {
+          isCondensed = false;
+        }
+      }
+    }
+  };
+  threadPool.runParallel(std::move(condenseTask), numSegments);
+
+  if (!success) {
+    throw std::runtime_error("[PartitionedRiccatiSolver] Input Hessian of the Riccati recursion is not positive definite.");
+  }
+
+  // Condensing requires R_k > 0, while the Riccati recursion only requires R_k + B_k' S_{k+1} B_k > 0. Continue sequentially otherwise.
+  if (!isCondensed) {
+    matrix_t S = boundaryValueHessians_[numSegments - 1];
+    vector_t s = boundaryValueGradients_[numSegments - 1];
+    if (!riccatiRecursion(0, segmentStarts_[numSegments - 1], dynamics, cost, S, s)) {
+      throw std::runtime_error("[PartitionedRiccatiSolver] Input Hessian of the Riccati recursion is not positive definite.");
+    }
+    rollout(0, N, dynamics, stateTrajectory, inputTrajectory);
+    return;
+  }
+
+  // Phase 2: propagate the value functions at the segment boundaries backward, and the states at the segment boundaries forward.
+  for (int j = numSegments - 2; j > 0; j--) {
+    riccati_scan::computeValueFunction(segmentValueFunctions_[j], boundaryValueHessians_[j + 1], boundaryValueGradients_[j + 1],
+                                       boundaryValueHessians_[j], boundaryValueGradients_[j]);
+  }
+  for (int j = 0; j < numSegments - 1; j++) {
+    riccati_scan::computeFinalState(segmentValueFunctions_[j], boundaryValueHessians_[j + 1], boundaryValueGradients_[j + 1],
+                                    stateTrajectory[segmentStarts_[j]], stateTrajectory[segmentStarts_[j + 1]]);
+  }
+
+  // Phase 3: Riccati recursion and rollout of each segment
+  nextSegment = 0;
+  auto solveTask = [&](int) {
+    int j;
+    while ((j = nextSegment++) < numSegments) {
+      const int start = segmentStarts_[j];
+      const int end = segmentStarts_[j + 1];
+      if (j < numSegments - 1) {
+        matrix_t S = boundaryValueHessians_[j + 1];
+        vector_t s = boundaryValueGradients_[j + 1];
+        if (!riccatiRecursion(start, end, dynamics, cost, S, s)) {
+          success = false;
+        }
+      }
+      rollout(start, end, dynamics, stateTrajectory, inputTrajectory);
+    }
+  };
+  threadPool.runParallel(std::move(solveTask), numSegments);
+
+  if (!success) {
+    throw std::runtime_error("[PartitionedRiccatiSolver] Input Hessian of the Riccati recursion is not positive definite.");
+  }
+}
+
+bool PartitionedRiccatiSolver::setStageValueFunction(const VectorFunctionLinearApproximation& dynamics,
+                                                     const ScalarFunctionQuadraticApproximation& cost,
+                                                     ConditionalValueFunction& valueFunction) {
+  const auto& B = dynamics.dfdu;
+  if (B.cols() > 0) {
+    // Minimize over the input: u = R^{-1} (B' l - P x - r)
+    const Eigen::LLT<matrix_t> llt(cost.dfduu);
+    if (llt.info() != Eigen::Success) {
+      return false;
+    }
+    const matrix_t RinvP = llt.solve(cost.dfdux);
+    const vector_t Rinvr = llt.solve(cost.dfdu);
+    const matrix_t RinvBt = llt.solve(B.transpose());
+    valueFunction.A = dynamics.dfdx;
+    valueFunction.A.noalias() -= B * RinvP;
+    valueFunction.b = dynamics.f;
+    valueFunction.b.noalias() -= B * Rinvr;
+    valueFunction.C.noalias() = B * RinvBt;
+    valueFunction.J = cost.dfdxx;
+    valueFunction.J.noalias() -= cost.dfdux.transpose() * RinvP;
+    valueFunction.eta = -cost.dfdx;
+    valueFunction.eta.noalias() += cost.dfdux.transpose() * Rinvr;
+  } else {
+    valueFunction.A = dynamics.dfdx;
+    valueFunction.b = dynamics.f;
+    valueFunction.C.setZero(dynamics.dfdx.rows(), dynamics.dfdx.rows());
+    valueFunction.J = cost.dfdxx;
+    valueFunction.eta = -cost.dfdx;
+  }
+  return true;
+}
+
+bool PartitionedRiccatiSolver::condenseSegment(int start, int end, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                               const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                                               ConditionalValueFunction& segment) const {
+  if (!setStageValueFunction(dynamics[start], cost[start], segment)) {
+    return false;
+  }
+  ConditionalValueFunction stage;
+  for (int k = start + 1; k < end; k++) {
+    if (!setStageValueFunction(dynamics[k], cost[k], stage)) {
+      return false;
+    }
+    riccati_scan::appendValueFunction(segment, stage);
+  }
+  return true;
+}
+
+bool PartitionedRiccatiSolver::riccatiRecursion(int start, int end, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                                const std::vector<ScalarFunctionQuadraticApproximation>& cost, matrix_t& S, vector_t& s) {
+  matrix_t SA;
+  vector_t Sbs;
+  matrix_t Hux;
+  vector_t hu;
+  for (int k = end - 1; k >= start; k--) {
+    const auto& A = dynamics[k].dfdx;
+    const auto& B = dynamics[k].dfdu;
+    SA.noalias() = S * A;
+    Sbs = s;
+    Sbs.noalias() += S * dynamics[k].f;
+
+    if (B.cols() > 0) {
+      matrix_t Huu = cost[k].dfduu;
+      Huu.noalias() += B.transpose() * S * B;
+      Hux = cost[k].dfdux;
+      Hux.noalias() += B.transpose() * SA;
+      hu = cost[k].dfdu;
+      hu.noalias() += B.transpose() * Sbs;
+
+      const Eigen::LLT<matrix_t> llt(Huu);
+      if (llt.info() != Eigen::Success) {
+        return false;
+      }
+      feedbackGains_[k] = -llt.solve(Hux);
+      feedforwardInputs_[k] = -llt.solve(hu);
+
+      s = cost[k].dfdx;
+      s.noalias() += A.transpose() * Sbs;
+      s.noalias() += Hux.transpose() * feedforwardInputs_[k];
+      matrix_t SNext = cost[k].dfdxx;
+      SNext.noalias() += A.transpose() * SA;
+      SNext.noalias() += Hux.transpose() * feedbackGains_[k];
+      S = 0.5 * (SNext + SNext.transpose());
+    } else {
+      feedbackGains_[k].resize(0, A.cols());
+      feedforwardInputs_[k].resize(0);
+
+      s = cost[k].dfdx;
+      s.noalias() += A.transpose() * Sbs;
+      matrix_t SNext = cost[k].dfdxx;
+      SNext.noalias() += A.transpose() * SA;
+      S = 0.5 * (SNext + SNext.transpose());
+    }
+  }
+  return true;
+}
+
+void PartitionedRiccatiSolver::rollout(int start, int end, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                       vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) const {
+  const int N = static_cast<int>(dynamics.size());
+  for (int k = start; k < end; k++) {
+    inputTrajectory[k] = feedforwardInputs_[k];
+    inputTrajectory[k].noalias() += feedbackGains_[k] * stateTrajectory[k];
+    // The state at the end of the segment is owned by the next segment
+    if (k + 1 < end || end == N) {
+      stateTrajectory[k + 1] = dynamics[k].f;
+      stateTrajectory[k + 1].noalias() += dynamics[k].dfdx * stateTrajectory[k];
+      stateTrajectory[k + 1].noalias() += dynamics[k].dfdu * inputTrajectory[k];
+    }
+  }
+}
+
+}  // namespace ocs2
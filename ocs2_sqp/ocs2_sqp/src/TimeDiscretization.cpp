@@ -29,6 +29,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/TimeDiscretization.h"
 
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+#include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/misc/Lookup.h>
 
 namespace ocs2 {
@@ -60,6 +65,11 @@ scalar_t getIntervalDuration(const AnnotatedTime& start, const AnnotatedTime& en
 std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt,
                                                         const scalar_array_t& eventTimes, scalar_t dt_min) {
   assert(dt > 0);
+  return timeDiscretizationWithEvents(initTime, finalTime, [dt](scalar_t) { return dt; }, eventTimes, dt_min);
+}
+
+std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, const StepSizeFunction& stepSize,
+                                                        const scalar_array_t& eventTimes, scalar_t dt_min) {
   assert(finalTime > initTime);
   std::vector<AnnotatedTime> timeDiscretization;
 
@@ -70,6 +80,8 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
   // Fill iteratively with pre event, post events are added later
   AnnotatedTime nextNode = timeDiscretization.back();
   while (timeDiscretization.back().time < finalTime) {
+    const scalar_t dt = stepSize(nextNode.time);
+    assert(dt > 0);
     nextNode.time = nextNode.time + dt;
     nextNode.event = AnnotatedTime::Event::None;
 
@@ -113,4 +125,97 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
   return timeDiscretizationWithDoubleEvents;
 }
 
+namespace time_grid {
+
+std::string toString(TimeGridType timeGridType) {
+  static const std::unordered_map<TimeGridType, std::string> timeGridMap = {{TimeGridType::UNIFORM, "UNIFORM"},
+                                                                            {TimeGridType::GEOMETRIC, "GEOMETRIC"},
+                                                                            {TimeGridType::PIECEWISE_UNIFORM, "PIECEWISE_UNIFORM"},
+                                                                            {TimeGridType::ADAPTIVE, "ADAPTIVE"}};
+
+  return timeGridMap.at(timeGridType);
+}
+
+TimeGridType fromString(const std::string& name) {
+  static const std::unordered_map<std::string, TimeGridType> timeGridMap = {{"UNIFORM", TimeGridType::UNIFORM},
+                                                                            {"GEOMETRIC", TimeGridType::GEOMETRIC},
+                                                                            {"PIECEWISE_UNIFORM", TimeGridType::PIECEWISE_UNIFORM},
+                                                                            {"ADAPTIVE", TimeGridType::ADAPTIVE}};
+
+  return timeGridMap.at(name);
+}
+
+}  // namespace time_grid
+
+StepSizeFunction geometricStepSize(scalar_t initTime, scalar_t dt, scalar_t growthFactor, scalar_t dtMax) {
+  assert(dt > 0);
+  assert(growthFactor >= 1.0);
+  return [=](scalar_t t) { return std::min(dt + (growthFactor - 1.0) * (t - initTime), std::max(dt, dtMax)); };
+}
+
+StepSizeFunction piecewiseUniformStepSize(scalar_t initTime, scalar_t dt, const scalar_array_t& switchTimes,
+                                          const scalar_array_t& dtAfterSwitch) {
+  assert(dt > 0);
+  if (switchTimes.size() != dtAfterSwitch.size()) {
+    throw std::runtime_error("[piecewiseUniformStepSize] Got " + std::to_string(switchTimes.size()) + " switch times and " +
+                             std::to_string(dtAfterSwitch.size()) + " steps.");
+  }
+  return [=](scalar_t t) {
+    // The step of the piece that contains t, a node at a switch (up to round-off) starts the next piece.
+    const scalar_t relativeTime = t - initTime + numeric_traits::weakEpsilon<scalar_t>();
+    const auto numPassedSwitches = std::upper_bound(switchTimes.begin(), switchTimes.end(), relativeTime) - switchTimes.begin();
+    return (numPassedSwitches == 0) ? dt : dtAfterSwitch[numPassedSwitches - 1];
+  };
+}
+
+StepSizeFunction adaptiveStepSize(const scalar_array_t& timeTrajectory, const vector_array_t& stateTrajectory, scalar_t dt, scalar_t dtMin,
+                                  scalar_t dtMax) {
+  assert(timeTrajectory.size() == stateTrajectory.size());
+  assert(dtMin <= dt && dt <= dtMax);
+
+  // Curvature at the interior points with finite differences. Events (repeated times) are skipped.
+  scalar_array_t curvatureTimes;
+  scalar_array_t curvatures;
+  for (int i = 1; i + 1 < timeTrajectory.size(); i++) {
+    const scalar_t h0 = timeTrajectory[i] - timeTrajectory[i - 1];
+    const scalar_t h1 = timeTrajectory[i + 1] - timeTrajectory[i];
+    if (h0 < numeric_traits::weakEpsilon<scalar_t>() || h1 < numeric_traits::weakEpsilon<scalar_t>()) {
+      continue;
+    }
+    const vector_t slopeChange = (stateTrajectory[i + 1] - stateTrajectory[i]) / h1 - (stateTrajectory[i] - stateTrajectory[i - 1]) / h0;
+    curvatureTimes.push_back(timeTrajectory[i]);
+    curvatures.push_back(slopeChange.norm() / (0.5 * (h0 + h1)));
+  }
+
+  // Time average of the curvature
+  scalar_t averageCurvature = curvatures.empty() ? 0.0 : curvatures.front();
+  if (curvatures.size() > 1) {
+    scalar_t integral = 0.0;
+    for (int i = 0; i + 1 < curvatures.size(); i++) {
+      integral += 0.5 * (curvatures[i] + curvatures[i + 1]) * (curvatureTimes[i + 1] - curvatureTimes[i]);
+    }
+    averageCurvature = integral / (curvatureTimes.back() - curvatureTimes.front());
+  }
+
+  if (averageCurvature <= 0.0) {  // (piecewise) linear trajectory
+    return [dt](scalar_t) { return dt; };
+  }
+
+  scalar_array_t steps;
+  steps.reserve(curvatures.size());
+  for (const auto curvature : curvatures) {
+    const scalar_t step = (curvature > 0.0) ? dt * std::sqrt(averageCurvature / curvature) : dtMax;
+    steps.push_back(std::min(std::max(step, dtMin), dtMax));
+  }
+  return [curvatureTimes, steps](scalar_t t) {
+    // A step ends at the latest where a finer step is required
+    scalar_t step = LinearInterpolation::interpolate(t, curvatureTimes, steps);
+    for (auto i = std::upper_bound(curvatureTimes.begin(), curvatureTimes.end(), t) - curvatureTimes.begin();
+         i < curvatureTimes.size() && curvatureTimes[i] < t + step; i++) {
+      step = std::min(step, std::max(steps[i], curvatureTimes[i] - t));
+    }
+    return step;
+  };
+}
+
 }  // namespace ocs2
@@ -29,12 +29,50 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+
 #include "ocs2_sqp/MultipleShootingSolver.h"
 
 #include <ocs2_core/initialization/DefaultInitializer.h>
 
 #include <ocs2_oc/test/circular_kinematics.h>
 
+namespace {
+/** Circular kinematics dynamics that count their evaluations and linearizations over all clones */
+class CountingCircularKinematicsSystem final : public ocs2::SystemDynamicsBase {
+ public:
+  CountingCircularKinematicsSystem()
+      : numEvaluations_(std::make_shared<std::atomic_int>(0)), numLinearizations_(std::make_shared<std::atomic_int>(0)) {}
+  ~CountingCircularKinematicsSystem() override = default;
+  CountingCircularKinematicsSystem* clone() const override { return new CountingCircularKinematicsSystem(*this); }
+
+  ocs2::vector_t computeFlowMap(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u, const ocs2::PreComputation&) override {
+    ++*numEvaluations_;
+    return u;
+  }
+
+  ocs2::VectorFunctionLinearApproximation linearApproximation(ocs2::scalar_t t, const ocs2::vector_t& x, const ocs2::vector_t& u,
+                                                              const ocs2::PreComputation&) override {
+    ++*numLinearizations_;
+    ocs2::VectorFunctionLinearApproximation dynamics;
+    dynamics.f = u;
+    dynamics.dfdx.setZero(2, 2);
+    dynamics.dfdu.setIdentity(2, 2);
+    return dynamics;
+  }
+
+  int getNumEvaluations() const { return *numEvaluations_; }
+  int getNumLinearizations() const { return *numLinearizations_; }
+
+ private:
+  std::shared_ptr<std::atomic_int> numEvaluations_;
+  std::shared_ptr<std::atomic_int> numLinearizations_;
+};
+}  // namespace
+
 TEST(test_circular_kinematics, solve_projected_EqConstraints) {
   // optimal control problem
   ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
@@ -141,3 +179,459 @@ TEST(test_circular_kinematics, solve_EqConstraints_inQPSubproblem) {
     ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
   }
 }
+
+TEST(test_circular_kinematics, parallelLinesearch) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.printSolverStatistics = true;
+  settings.printLinesearch = true;
+  settings.nThreads = 4;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve with sequential linesearch
+  settings.parallelLinesearch = false;
+  ocs2::MultipleShootingSolver sequentialSolver(settings, problem, zeroInitializer);
+  sequentialSolver.run(startTime, initState, finalTime);
+
+  // Solve with parallel linesearch
+  settings.parallelLinesearch = true;
+  ocs2::MultipleShootingSolver parallelSolver(settings, problem, zeroInitializer);
+  parallelSolver.run(startTime, initState, finalTime);
+
+  // Both linesearch variants take the same steps
+  const auto& sequentialLog = sequentialSolver.getIterationsLog();
+  const auto& parallelLog = parallelSolver.getIterationsLog();
+  ASSERT_EQ(sequentialLog.size(), parallelLog.size());
+  for (int i = 0; i < sequentialLog.size(); i++) {
+    ASSERT_NEAR(sequentialLog[i].merit, parallelLog[i].merit, 1e-9);
+  }
+
+  const auto sequentialSolution = sequentialSolver.primalSolution(finalTime);
+  const auto parallelSolution = parallelSolver.primalSolution(finalTime);
+  ASSERT_EQ(sequentialSolution.timeTrajectory_.size(), parallelSolution.timeTrajectory_.size());
+  for (int i = 0; i < sequentialSolution.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(sequentialSolution.stateTrajectory_[i].isApprox(parallelSolution.stateTrajectory_[i]));
+    ASSERT_TRUE(sequentialSolution.inputTrajectory_[i].isApprox(parallelSolution.inputTrajectory_[i]));
+  }
+}
+
+TEST(test_circular_kinematics, linearizeFullStep) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.printSolverStatistics = true;
+  settings.printLinesearch = true;
+  settings.nThreads = 4;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve with a separate linearization of each iterate
+  auto* referenceDynamicsPtr = new CountingCircularKinematicsSystem();
+  problem.dynamicsPtr.reset(referenceDynamicsPtr);
+  settings.linearizeFullStep = false;
+  ocs2::MultipleShootingSolver referenceSolver(settings, problem, zeroInitializer);
+  referenceSolver.run(startTime, initState, finalTime);
+
+  // Solve with the linearization of the full step reused
+  auto* dynamicsPtr = new CountingCircularKinematicsSystem();
+  problem.dynamicsPtr.reset(dynamicsPtr);
+  settings.linearizeFullStep = true;
+  ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+  solver.run(startTime, initState, finalTime);
+
+  // Full steps are accepted on this problem, so every trial point is linearized once and no separate evaluation is needed
+  ASSERT_EQ(dynamicsPtr->getNumEvaluations(), 0);
+  ASSERT_LT(dynamicsPtr->getNumLinearizations(), referenceDynamicsPtr->getNumEvaluations() + referenceDynamicsPtr->getNumLinearizations());
+
+  // Reusing the linearization does not change the iterates
+  const auto& referenceLog = referenceSolver.getIterationsLog();
+  const auto& log = solver.getIterationsLog();
+  ASSERT_EQ(referenceLog.size(), log.size());
+  for (int i = 0; i < referenceLog.size(); i++) {
+    ASSERT_NEAR(referenceLog[i].merit, log[i].merit, 1e-9);
+  }
+
+  const auto referenceSolution = referenceSolver.primalSolution(finalTime);
+  const auto solution = solver.primalSolution(finalTime);
+  ASSERT_EQ(referenceSolution.timeTrajectory_.size(), solution.timeTrajectory_.size());
+  for (int i = 0; i < referenceSolution.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(referenceSolution.stateTrajectory_[i].isApprox(solution.stateTrajectory_[i]));
+    ASSERT_TRUE(referenceSolution.inputTrajectory_[i].isApprox(solution.inputTrajectory_[i]));
+  }
+}
+
+TEST(test_circular_kinematics, realTimeIteration) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.nThreads = 4;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Reference: fully converged SQP
+  ocs2::MultipleShootingSolver sqpSolver(settings, problem, zeroInitializer);
+  sqpSolver.run(startTime, initState, finalTime);
+
+  // Real-time iteration: one step per run, the next run is prepared in between
+  settings.realTimeIteration = true;
+  ocs2::MultipleShootingSolver rtiSolver(settings, problem, zeroInitializer);
+  for (int iter = 0; iter < 10; iter++) {
+    rtiSolver.run(startTime, initState, finalTime);
+    ASSERT_EQ(rtiSolver.getIterationsLog().size(), 1);
+    rtiSolver.prepareRealTimeIteration(startTime, finalTime);
+  }
+
+  // Repeated real-time iterations on the same problem converge to the SQP solution
+  const auto sqpSolution = sqpSolver.primalSolution(finalTime);
+  const auto rtiSolution = rtiSolver.primalSolution(finalTime);
+  ASSERT_EQ(sqpSolution.timeTrajectory_.size(), rtiSolution.timeTrajectory_.size());
+  ASSERT_TRUE(rtiSolution.stateTrajectory_.front().isApprox(initState));
+  for (int i = 0; i < sqpSolution.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(sqpSolution.stateTrajectory_[i].isApprox(rtiSolution.stateTrajectory_[i], 1e-6));
+    ASSERT_TRUE(sqpSolution.inputTrajectory_[i].isApprox(rtiSolution.inputTrajectory_[i], 1e-6));
+  }
+}
+
+TEST(test_circular_kinematics, realTimeIterationDelayedObservation) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.nThreads = 2;
+  settings.realTimeIteration = true;
+  settings.dtGrowthFactor = 1.1;
+
+  // Additional problem definitions
+  const ocs2::scalar_t horizon = 1.0;
+  const ocs2::scalar_t predictedTime = 0.05;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  for (const auto timeGrid : {ocs2::TimeGridType::UNIFORM, ocs2::TimeGridType::GEOMETRIC}) {
+    settings.timeGrid = timeGrid;
+    // The observation arrives later than predicted, within and beyond half of the first interval of the prepared grid
+    for (const ocs2::scalar_t delay : {0.3 * settings.dt, 0.7 * settings.dt}) {
+      ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+      solver.run(0.0, initState, horizon);
+      solver.prepareRealTimeIteration(predictedTime, predictedTime + horizon);
+
+      const ocs2::scalar_t initTime = predictedTime + delay;
+      solver.run(initTime, initState, initTime + horizon);
+
+      // The policy starts at the observation
+      const auto solution = solver.primalSolution(initTime + horizon);
+      ASSERT_DOUBLE_EQ(solution.timeTrajectory_.front(), initTime);
+      ASSERT_TRUE(solution.stateTrajectory_.front().isApprox(initState));
+      ASSERT_LT(solution.timeTrajectory_[0], solution.timeTrajectory_[1]);
+      if (delay < 0.5 * settings.dt) {
+        // Only the first node is moved, the other nodes stay on the prepared grid
+        ASSERT_DOUBLE_EQ(solution.timeTrajectory_[1], predictedTime + settings.dt);
+      } else {
+        // The prepared grid is not used
+        ASSERT_DOUBLE_EQ(solution.timeTrajectory_[1], initTime + settings.dt);
+      }
+      ASSERT_TRUE(solution.stateTrajectory_.back().allFinite());
+    }
+  }
+}
+
+TEST(test_circular_kinematics, qpWarmStart) {
+  // optimal control problem with input bounds
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+  problem.inputBoxConstraint =
+      ocs2::BoxConstraint({0, 1}, ocs2::vector_t::Constant(2, -0.8), ocs2::vector_t::Constant(2, 0.8));  // the optimum exceeds the bounds
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = false;
+  settings.useFeedbackPolicy = false;
+  settings.nThreads = 1;
+
+  // Additional problem definitions
+  const ocs2::scalar_t horizon = 1.0;
+  const ocs2::scalar_t mpcTimeStep = 0.05;
+  const int numCycles = 10;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  ocs2::MultipleShootingSolver coldSolver(settings, problem, zeroInitializer);
+  settings.qpWarmStart = true;
+  ocs2::MultipleShootingSolver warmSolver(settings, problem, zeroInitializer);
+
+  // MPC loop: shift the horizon
+  for (int cycle = 0; cycle < numCycles; cycle++) {
+    const ocs2::scalar_t startTime = cycle * mpcTimeStep;
+    const ocs2::scalar_t finalTime = startTime + horizon;
+    coldSolver.run(startTime, initState, finalTime);
+    warmSolver.run(startTime, initState, finalTime);
+
+    // Same solution with and without warm start
+    ASSERT_NEAR(coldSolver.getPerformanceIndeces().cost, warmSolver.getPerformanceIndeces().cost, 1e-6);
+    const auto coldSolution = coldSolver.primalSolution(finalTime);
+    const auto warmSolution = warmSolver.primalSolution(finalTime);
+    ASSERT_EQ(coldSolution.timeTrajectory_.size(), warmSolution.timeTrajectory_.size());
+    for (int i = 0; i < coldSolution.timeTrajectory_.size(); i++) {
+      ASSERT_LT((coldSolution.stateTrajectory_[i] - warmSolution.stateTrajectory_[i]).norm(), 1e-4);
+      ASSERT_LT((coldSolution.inputTrajectory_[i] - warmSolution.inputTrajectory_[i]).norm(), 1e-4);
+    }
+  }
+
+  // Warm starting does not need more interior point iterations
+  ASSERT_LE(warmSolver.getNumQpIterations(), coldSolver.getNumQpIterations());
+}
+
+TEST(test_circular_kinematics, nonUniformTimeGrid) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.nThreads = 2;
+
+  // Additional problem definitions
+  const ocs2::scalar_t horizon = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  for (const auto timeGrid : {ocs2::TimeGridType::GEOMETRIC, ocs2::TimeGridType::PIECEWISE_UNIFORM, ocs2::TimeGridType::ADAPTIVE}) {
+    settings.timeGrid = timeGrid;
+    settings.dtGrowthFactor = 1.1;
+    settings.dtSwitchTimes = {0.1};
+    settings.dtAfterSwitch = {0.05};
+    ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+
+    // Consecutive runs on shifted horizons, each initialized from the previous solution on a different grid
+    for (int cycle = 0; cycle < 3; cycle++) {
+      const ocs2::scalar_t startTime = 0.05 * cycle;
+      const ocs2::scalar_t finalTime = startTime + horizon;
+      solver.run(startTime, initState, finalTime);
+
+      const auto primalSolution = solver.primalSolution(finalTime);
+      ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.front(), startTime);
+      ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.back(), finalTime);
+      ASSERT_TRUE(primalSolution.stateTrajectory_.front().isApprox(initState));
+      if (timeGrid != ocs2::TimeGridType::ADAPTIVE) {  // the curvature of a circle is constant, the adaptive grid stays uniform
+        ASSERT_LT(primalSolution.timeTrajectory_.size(), horizon / settings.dt / 2);
+      }
+
+      const auto performance = solver.getPerformanceIndeces();
+      ASSERT_LT(performance.dynamicsViolationSSE, 1e-6);
+      ASSERT_LT(performance.equalityConstraintsSSE, 1e-6);
+    }
+  }
+}
+
+TEST(test_circular_kinematics, timeBudget) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.nThreads = 4;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  for (const bool parallelLinesearch : {false, true}) {
+    settings.parallelLinesearch = parallelLinesearch;
+    ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+
+    // without a budget the solver converges
+    solver.run(startTime, initState, finalTime);
+    ASSERT_NE(solver.getConvergence(), ocs2::multiple_shooting::Convergence::TIME);
+    const auto numConvergedIterations = solver.getIterationsLog().size();
+    const auto convergedSolution = solver.primalSolution(finalTime);
+
+    // a budget which does not suffice for a single step keeps the initial iterate
+    solver.reset();
+    solver.setTimeBudget(1e-9);
+    solver.run(startTime, initState, finalTime);
+    ASSERT_EQ(solver.getConvergence(), ocs2::multiple_shooting::Convergence::TIME) << "parallelLinesearch: " << parallelLinesearch;
+    ASSERT_LT(solver.getIterationsLog().size(), numConvergedIterations);
+    ASSERT_TRUE(std::isfinite(solver.getPerformanceIndeces().merit));
+    const auto limitedSolution = solver.primalSolution(finalTime);
+    ASSERT_FALSE(limitedSolution.timeTrajectory_.empty());
+    ASSERT_FALSE(limitedSolution.controllerPtr_->empty());
+    for (int i = 0; i < limitedSolution.timeTrajectory_.size(); i++) {
+      ASSERT_TRUE(limitedSolution.stateTrajectory_[i].allFinite());
+      ASSERT_TRUE(limitedSolution.inputTrajectory_[i].allFinite());
+    }
+
+    // an ample budget does not change the solution
+    solver.reset();
+    solver.setTimeBudget(100.0);
+    solver.run(startTime, initState, finalTime);
+    ASSERT_NE(solver.getConvergence(), ocs2::multiple_shooting::Convergence::TIME);
+    ASSERT_EQ(solver.getIterationsLog().size(), numConvergedIterations);
+    const auto ampleSolution = solver.primalSolution(finalTime);
+    ASSERT_EQ(ampleSolution.timeTrajectory_.size(), convergedSolution.timeTrajectory_.size());
+    for (int i = 0; i < ampleSolution.timeTrajectory_.size(); i++) {
+      ASSERT_TRUE(ampleSolution.stateTrajectory_[i].isApprox(convergedSolution.stateTrajectory_[i]));
+      ASSERT_TRUE(ampleSolution.inputTrajectory_[i].isApprox(convergedSolution.inputTrajectory_[i]));
+    }
+  }
+}
+
+TEST(test_circular_kinematics, boxConstraints) {
+  // optimal control problem, the bounds stop the particle before it reaches y = sin(1)
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+  const ocs2::scalar_t yMax = 0.5;
+  const ocs2::scalar_t u0Min = -0.2;
+  const ocs2::scalar_t infinity = std::numeric_limits<ocs2::scalar_t>::infinity();
+  problem.stateBoxConstraint = ocs2::BoxConstraint({1}, ocs2::vector_t::Constant(1, -infinity), ocs2::vector_t::Constant(1, yMax));
+  problem.inputBoxConstraint = ocs2::BoxConstraint({0}, ocs2::vector_t::Constant(1, u0Min), ocs2::vector_t::Constant(1, infinity));
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.useFeedbackPolicy = true;
+  settings.printSolverStatistics = true;
+  settings.nThreads = 1;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+  const ocs2::scalar_t tol = 1e-6;
+
+  for (const bool projectStateInputEqualityConstraints : {true, false}) {
+    settings.projectStateInputEqualityConstraints = projectStateInputEqualityConstraints;
+    ocs2::MultipleShootingSolver solver(settings, problem, zeroInitializer);
+    solver.run(startTime, initState, finalTime);
+
+    // Check constraint satisfaction
+    const auto performance = solver.getPerformanceIndeces();
+    ASSERT_LT(performance.dynamicsViolationSSE, tol);
+    ASSERT_LT(performance.equalityConstraintsSSE, tol);
+    ASSERT_LT(performance.inequalityConstraintsSSE, tol);
+
+    // The optimum respects the bounds, and both of them are active
+    const auto primalSolution = solver.primalSolution(finalTime);
+    ASSERT_TRUE(primalSolution.stateTrajectory_.front().isApprox(initState));
+    ocs2::scalar_t yLargest = -infinity;
+    ocs2::scalar_t u0Smallest = infinity;
+    for (int i = 0; i < primalSolution.timeTrajectory_.size(); i++) {
+      yLargest = std::max(yLargest, primalSolution.stateTrajectory_[i](1));
+      if (i + 1 < primalSolution.timeTrajectory_.size()) {
+        u0Smallest = std::min(u0Smallest, primalSolution.inputTrajectory_[i](0));
+      }
+    }
+    ASSERT_LE(yLargest, yMax + tol) << "projection: " << projectStateInputEqualityConstraints;
+    ASSERT_GE(u0Smallest, u0Min - tol) << "projection: " << projectStateInputEqualityConstraints;
+    ASSERT_NEAR(yLargest, yMax, 1e-3) << "projection: " << projectStateInputEqualityConstraints;
+    ASSERT_NEAR(u0Smallest, u0Min, 1e-3) << "projection: " << projectStateInputEqualityConstraints;
+  }
+}
+
+TEST(test_circular_kinematics, partialCondensing) {
+  // optimal control problem with active bounds, such that the constraints, bounds and inequality multipliers are condensed as well
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+  const ocs2::scalar_t infinity = std::numeric_limits<ocs2::scalar_t>::infinity();
+  problem.stateBoxConstraint = ocs2::BoxConstraint({1}, ocs2::vector_t::Constant(1, -infinity), ocs2::vector_t::Constant(1, 0.5));
+  problem.inputBoxConstraint = ocs2::BoxConstraint({0}, ocs2::vector_t::Constant(1, -0.2), ocs2::vector_t::Constant(1, infinity));
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings, the condensed QP does not provide the Riccati feedback
+  ocs2::multiple_shooting::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.useFeedbackPolicy = false;
+  settings.nThreads = 1;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  for (const bool projectStateInputEqualityConstraints : {true, false}) {
+    settings.projectStateInputEqualityConstraints = projectStateInputEqualityConstraints;
+    settings.hpipmSettings.partialCondensingBlockSize = 1;
+    ocs2::MultipleShootingSolver fullSolver(settings, problem, zeroInitializer);
+    fullSolver.run(startTime, initState, finalTime);
+    const auto fullSolution = fullSolver.primalSolution(finalTime);
+
+    for (const int blockSize : {2, 10}) {
+      settings.hpipmSettings.partialCondensingBlockSize = blockSize;
+      ocs2::MultipleShootingSolver condensedSolver(settings, problem, zeroInitializer);
+      condensedSolver.run(startTime, initState, finalTime);
+
+      // Same solution as with the full-length QPs
+      ASSERT_NEAR(fullSolver.getPerformanceIndeces().cost, condensedSolver.getPerformanceIndeces().cost, 1e-6)
+          << "projection: " << projectStateInputEqualityConstraints << ", block size: " << blockSize;
+      const auto condensedSolution = condensedSolver.primalSolution(finalTime);
+      ASSERT_EQ(fullSolution.timeTrajectory_.size(), condensedSolution.timeTrajectory_.size());
+      for (int i = 0; i < fullSolution.timeTrajectory_.size(); i++) {
+        ASSERT_LT((fullSolution.stateTrajectory_[i] - condensedSolution.stateTrajectory_[i]).norm(), 1e-4);
+        ASSERT_LT((fullSolution.inputTrajectory_[i] - condensedSolution.inputTrajectory_[i]).norm(), 1e-4);
+      }
+    }
+  }
+}
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 #include "ocs2_sqp/TimeDiscretization.h"
 
 using namespace ocs2;
@@ -127,4 +129,76 @@ TEST(test_discretization, withEvents) {
   ASSERT_EQ(time[12].event, AnnotatedTime::Event::PreEvent);
   ASSERT_EQ(time[13].event, AnnotatedTime::Event::PostEvent);
   ASSERT_EQ(time[14].event, AnnotatedTime::Event::None);
-}
\ No newline at end of file
+}
+
+TEST(test_discretization, geometricGrid) {
+  scalar_t initTime = 1.0;
+  scalar_t finalTime = 3.0;
+  scalar_t dt = 0.01;
+  scalar_t growthFactor = 1.1;
+  scalar_t dtMax = 0.2;
+  scalar_array_t eventTimes{1.5};
+
+  auto time = timeDiscretizationWithEvents(initTime, finalTime, geometricStepSize(initTime, dt, growthFactor, dtMax), eventTimes);
+  ASSERT_EQ(time.front().time, initTime);
+  ASSERT_EQ(time.back().time, finalTime);
+  ASSERT_NEAR(time[1].time - time[0].time, dt, 1e-9);
+  ASSERT_NEAR(time[2].time - time[1].time, growthFactor * dt, 1e-9);
+  ASSERT_NEAR(time[3].time - time[2].time, growthFactor * growthFactor * dt, 1e-9);
+
+  // Far fewer nodes than a uniform grid, the event is kept and the steps are bounded
+  ASSERT_LT(time.size(), (finalTime - initTime) / dt / 4);
+  ASSERT_EQ(std::count_if(time.begin(), time.end(), [&](const AnnotatedTime& t) { return t.time == eventTimes[0]; }), 2);
+  for (int i = 0; i + 1 < time.size(); i++) {
+    ASSERT_LE(time[i + 1].time - time[i].time, dtMax + 1e-9);
+  }
+}
+
+TEST(test_discretization, piecewiseUniformGrid) {
+  scalar_t initTime = 1.0;
+  scalar_t finalTime = 2.0;
+  scalar_t dt = 0.01;
+  scalar_array_t switchTimes{0.1, 0.5};
+  scalar_array_t dtAfterSwitch{0.05, 0.1};
+
+  auto time = timeDiscretizationWithEvents(initTime, finalTime, piecewiseUniformStepSize(initTime, dt, switchTimes, dtAfterSwitch), {});
+  // 10 steps of 0.01, 8 steps of 0.05, 5 steps of 0.1
+  ASSERT_EQ(time.size(), 10 + 8 + 5 + 1);
+  ASSERT_NEAR(time[10].time, initTime + switchTimes[0], 1e-9);
+  ASSERT_NEAR(time[11].time - time[10].time, dtAfterSwitch[0], 1e-9);
+  ASSERT_NEAR(time[18].time, initTime + switchTimes[1], 1e-9);
+  ASSERT_NEAR(time[19].time - time[18].time, dtAfterSwitch[1], 1e-9);
+  ASSERT_EQ(time.back().time, finalTime);
+
+  ASSERT_ANY_THROW(piecewiseUniformStepSize(initTime, dt, switchTimes, {0.05}));
+}
+
+TEST(test_discretization, adaptiveGrid) {
+  // Straight lines with a kink at t = 0.5
+  scalar_array_t timeTrajectory;
+  vector_array_t stateTrajectory;
+  for (int i = 0; i <= 100; i++) {
+    timeTrajectory.push_back(0.01 * i);
+    stateTrajectory.push_back(vector_t::Constant(1, std::abs(timeTrajectory.back() - 0.5)));
+  }
+  scalar_t dt = 0.05;
+  scalar_t dtMin = 0.01;
+  scalar_t dtMax = 0.2;
+
+  const auto stepSize = adaptiveStepSize(timeTrajectory, stateTrajectory, dt, dtMin, dtMax);
+  ASSERT_DOUBLE_EQ(stepSize(0.5), dtMin);
+  ASSERT_DOUBLE_EQ(stepSize(0.1), dtMax);
+  ASSERT_DOUBLE_EQ(stepSize(2.0), dtMax);  // constant beyond the trajectory
+
+  auto time = timeDiscretizationWithEvents(0.0, 1.0, stepSize, {});
+  ASSERT_LT(time.size(), 1.0 / dt);
+  const auto nearKink = std::count_if(time.begin(), time.end(), [](const AnnotatedTime& t) { return std::abs(t.time - 0.5) < 0.05; });
+  const auto farFromKink = std::count_if(time.begin(), time.end(), [](const AnnotatedTime& t) { return std::abs(t.time - 0.1) < 0.05; });
+  ASSERT_GT(nearKink, farFromKink);
+
+  // Without curvature the step is uniform
+  for (auto& x : stateTrajectory) {
+    x.setZero();
+  }
+  ASSERT_DOUBLE_EQ(adaptiveStepSize(timeTrajectory, stateTrajectory, dt, dtMin, dtMax)(0.5), dt);
+}
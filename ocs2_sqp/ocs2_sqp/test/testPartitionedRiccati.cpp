@@ -0,0 +1,183 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_sqp/PartitionedRiccatiSolver.h"
+
+#include <ocs2_core/test/testTools.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+namespace {
+
+struct KnownSolutionProblem {
+  std::vector<ocs2::VectorFunctionLinearApproximation> dynamics;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  ocs2::vector_array_t xSol;
+  ocs2::vector_array_t uSol;
+};
+
+/** Random LQ problem with cost that is minimized at a given feasible trajectory. Every eventPeriod-th stage has no inputs. */
+KnownSolutionProblem getKnownSolutionProblem(int N, int nx, int nu, int eventPeriod) {
+  KnownSolutionProblem problem;
+  problem.xSol.emplace_back(ocs2::vector_t::Random(nx));
+  for (int k = 0; k < N; k++) {
+    const int nuk = (k % eventPeriod == eventPeriod - 1) ? 0 : nu;
+    problem.uSol.emplace_back(ocs2::vector_t::Random(nuk));
+
+    problem.dynamics.emplace_back(ocs2::getRandomDynamics(nx, nuk));
+    const auto& dynamics = problem.dynamics.back();
+    problem.xSol.emplace_back(dynamics.f + dynamics.dfdx * problem.xSol[k] + dynamics.dfdu * problem.uSol[k]);
+
+    problem.cost.emplace_back(ocs2::getRandomCost(nx, nuk));
+    auto& cost = problem.cost.back();
+    cost.dfdx = -(cost.dfdxx * problem.xSol[k] + cost.dfdux.transpose() * problem.uSol[k]);
+    cost.dfdu = -(cost.dfduu * problem.uSol[k] + cost.dfdux * problem.xSol[k]);
+  }
+  problem.cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  problem.cost[N].dfdx = -problem.cost[N].dfdxx * problem.xSol[N];
+  return problem;
+}
+
+}  // namespace
+
+TEST(test_partitioned_riccati, knownSolution) {
+  const int N = 23;
+  const auto problem = getKnownSolutionProblem(N, 3, 2, N + 1);
+
+  ocs2::ThreadPool threadPool(3, 0);
+  ocs2::PartitionedRiccatiSolver solver;
+  for (int numThreads = 1; numThreads <= 4; numThreads++) {
+    ocs2::vector_array_t xSol;
+    ocs2::vector_array_t uSol;
+    solver.solve(problem.xSol[0], problem.dynamics, problem.cost, xSol, uSol, threadPool, numThreads);
+
+    ASSERT_TRUE(ocs2::isEqual(problem.xSol, xSol, 1e-8)) << "numThreads: " << numThreads;
+    ASSERT_TRUE(ocs2::isEqual(problem.uSol, uSol, 1e-8)) << "numThreads: " << numThreads;
+  }
+}
+
+TEST(test_partitioned_riccati, eventNodes) {
+  const int N = 30;
+  const auto problem = getKnownSolutionProblem(N, 4, 2, 7);
+
+  ocs2::ThreadPool threadPool(3, 0);
+  ocs2::PartitionedRiccatiSolver solver;
+  ocs2::vector_array_t xSol;
+  ocs2::vector_array_t uSol;
+  solver.solve(problem.xSol[0], problem.dynamics, problem.cost, xSol, uSol, threadPool, 4);
+
+  ASSERT_TRUE(ocs2::isEqual(problem.xSol, xSol, 1e-8));
+  ASSERT_TRUE(ocs2::isEqual(problem.uSol, uSol, 1e-8));
+
+  // The feedback policy reproduces the solution
+  const auto& feedbackGains = solver.getRiccatiFeedback();
+  ASSERT_EQ(feedbackGains.size(), N);
+  for (int k = 0; k < N; k++) {
+    ASSERT_EQ(feedbackGains[k].rows(), uSol[k].size());
+    ASSERT_EQ(feedbackGains[k].cols(), xSol[k].size());
+  }
+}
+
+TEST(test_partitioned_riccati, partitionedEqualsSequential) {
+  const int N = 100;
+  const int nx = 6;
+  const int nu = 3;
+  const ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> dynamics;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    dynamics.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    // Keep the dynamics stable over the long horizon
+    dynamics.back().dfdx *= 0.9 / dynamics.back().dfdx.norm();
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+
+  ocs2::ThreadPool threadPool(7, 0);
+  ocs2::PartitionedRiccatiSolver solver;
+  ocs2::vector_array_t xSequential, uSequential;
+  solver.solve(x0, dynamics, cost, xSequential, uSequential, threadPool, 1);
+  const ocs2::matrix_array_t feedbackSequential = solver.getRiccatiFeedback();
+
+  ocs2::vector_array_t xPartitioned, uPartitioned;
+  solver.solve(x0, dynamics, cost, xPartitioned, uPartitioned, threadPool, 8);
+
+  ASSERT_TRUE(ocs2::isEqual(xSequential, xPartitioned, 1e-8));
+  ASSERT_TRUE(ocs2::isEqual(uSequential, uPartitioned, 1e-8));
+  ASSERT_TRUE(ocs2::isEqual(feedbackSequential, solver.getRiccatiFeedback(), 1e-8));
+}
+
+TEST(test_partitioned_riccati, singularInputHessian) {
+  const int N = 23;
+  const int nu = 2;
+  auto problem = getKnownSolutionProblem(N, 3, nu, N + 1);
+
+  // R_k = 0 cannot be condensed, but R_k + B_k' S_{k+1} B_k is still positive definite
+  for (int k : {2, 9}) {
+    auto& cost = problem.cost[k];
+    cost.dfduu.setZero(nu, nu);
+    cost.dfdux.setZero();
+    cost.dfdx = -cost.dfdxx * problem.xSol[k];
+    cost.dfdu.setZero();
+  }
+
+  ocs2::ThreadPool threadPool(3, 0);
+  ocs2::PartitionedRiccatiSolver solver;
+  for (int numThreads = 1; numThreads <= 4; numThreads++) {
+    ocs2::vector_array_t xSol;
+    ocs2::vector_array_t uSol;
+    solver.solve(problem.xSol[0], problem.dynamics, problem.cost, xSol, uSol, threadPool, numThreads);
+
+    ASSERT_TRUE(ocs2::isEqual(problem.xSol, xSol, 1e-8)) << "numThreads: " << numThreads;
+    ASSERT_TRUE(ocs2::isEqual(problem.uSol, uSol, 1e-8)) << "numThreads: " << numThreads;
+  }
+}
+
+TEST(test_partitioned_riccati, singleSegmentFails) {
+  const int N = 23;
+  const int nu = 2;
+  const auto problem = getKnownSolutionProblem(N, 3, nu, N + 1);
+
+  ocs2::ThreadPool threadPool(3, 0);
+  ocs2::PartitionedRiccatiSolver solver;
+  for (int numThreads = 1; numThreads <= 4; numThreads++) {
+    // Make one stage infeasible at a time, such that exactly one segment fails while the others succeed
+    for (int k : {0, 6, 12, 22}) {
+      auto failingProblem = problem;
+      failingProblem.cost[k].dfduu = -1e6 * ocs2::matrix_t::Identity(nu, nu);
+
+      ocs2::vector_array_t xSol;
+      ocs2::vector_array_t uSol;
+      ASSERT_THROW(solver.solve(failingProblem.xSol[0], failingProblem.dynamics, failingProblem.cost, xSol, uSol, threadPool, numThreads),
+                   std::runtime_error)
+          << "numThreads: " << numThreads << ", failing stage: " << k;
+    }
+  }
+}
@@ -29,8 +29,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <limits>
+
 #include "ocs2_sqp/MultipleShootingTranscription.h"
 
+#include <ocs2_core/constraint/LinearStateInputConstraint.h>
+
 #include <ocs2_oc/test/circular_kinematics.h>
 #include <ocs2_oc/test/testProblemsGeneration.h>
 
@@ -38,8 +42,8 @@ namespace {
 /** Helper to compare if two performance indices are identical */
 bool areIdentical(const ocs2::PerformanceIndex& lhs, const ocs2::PerformanceIndex& rhs) {
   return lhs.merit == rhs.merit && lhs.cost == rhs.cost && lhs.dynamicsViolationSSE == rhs.dynamicsViolationSSE &&
-         lhs.equalityConstraintsSSE == rhs.equalityConstraintsSSE && lhs.equalityLagrangian == rhs.equalityLagrangian &&
-         lhs.inequalityLagrangian == rhs.inequalityLagrangian;
+         lhs.equalityConstraintsSSE == rhs.equalityConstraintsSSE && lhs.inequalityConstraintsSSE == rhs.inequalityConstraintsSSE &&
+         lhs.equalityLagrangian == rhs.equalityLagrangian && lhs.inequalityLagrangian == rhs.inequalityLagrangian;
 }
 }  // namespace
 
@@ -65,6 +69,90 @@ TEST(test_transcription, intermediate_performance) {
   ASSERT_TRUE(areIdentical(performance, transcription.performance));
 }
 
+TEST(test_transcription, intermediate_inPlace) {
+  // optimal control problem
+  OptimalControlProblem problem = createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+
+  scalar_t t = 0.5;
+  scalar_t dt = 0.1;
+  const vector_t x = (vector_t(2) << 1.0, 0.1).finished();
+  const vector_t x_next = (vector_t(2) << 1.1, 0.2).finished();
+  const vector_t u = (vector_t(2) << 0.1, 1.3).finished();
+
+  // Storage is reused between the calls, with and without projection
+  VectorFunctionLinearApproximation dynamics;
+  ScalarFunctionQuadraticApproximation cost;
+  VectorFunctionLinearApproximation constraints;
+  VectorFunctionLinearApproximation projection;
+  VectorFunctionLinearApproximation ineqConstraints;
+  BoxConstraint nextStateBox;
+  BoxConstraint inputBox;
+  for (bool projectConstraints : {true, false, true}) {
+    const auto transcription = setupIntermediateNode(problem, sensitivityDiscretizer, projectConstraints, t, dt, x, x_next, u);
+    const auto performance = setupIntermediateNode(problem, sensitivityDiscretizer, projectConstraints, t, dt, x, x_next, u, dynamics,
+                                                   cost, constraints, projection, ineqConstraints, nextStateBox, inputBox);
+
+    ASSERT_TRUE(areIdentical(performance, transcription.performance));
+    ASSERT_TRUE(dynamics.dfdx.isApprox(transcription.dynamics.dfdx));
+    ASSERT_TRUE(dynamics.dfdu.isApprox(transcription.dynamics.dfdu));
+    ASSERT_TRUE(dynamics.f.isApprox(transcription.dynamics.f));
+    ASSERT_TRUE(cost.dfdxx.isApprox(transcription.cost.dfdxx));
+    ASSERT_TRUE(cost.dfduu.isApprox(transcription.cost.dfduu));
+    ASSERT_DOUBLE_EQ(cost.f, transcription.cost.f);
+    ASSERT_TRUE(constraints.dfdu.isApprox(transcription.constraints.dfdu));
+    if (projectConstraints) {
+      ASSERT_TRUE(projection.dfdu.isApprox(transcription.constraintsProjection.dfdu));
+      ASSERT_TRUE(projection.f.isApprox(transcription.constraintsProjection.f));
+    } else {
+      ASSERT_EQ(transcription.constraintsProjection.f.size(), 0);
+    }
+  }
+}
+
+TEST(test_transcription, intermediate_inequalities) {
+  // optimal control problem
+  OptimalControlProblem problem = createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  // inequality constraints and bounds that are violated at the evaluation point
+  const scalar_t infinity = std::numeric_limits<scalar_t>::infinity();
+  const matrix_t C = matrix_t::Random(3, 2);
+  const matrix_t D = matrix_t::Random(3, 2);
+  problem.inequalityConstraintPtr->add("inequality", std::unique_ptr<StateInputConstraint>(
+                                                         new LinearStateInputConstraint(vector_t::Constant(3, -10.0), C, D)));
+  problem.stateBoxConstraint = BoxConstraint({1}, vector_t::Constant(1, -infinity), vector_t::Constant(1, 0.0));
+  problem.inputBoxConstraint = BoxConstraint({0, 1}, vector_t::Constant(2, -1.0), (vector_t(2) << 1.0, infinity).finished());
+
+  auto discretizer = selectDynamicsDiscretization(SensitivityIntegratorType::RK4);
+  auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+
+  scalar_t t = 0.5;
+  scalar_t dt = 0.1;
+  const vector_t x = (vector_t(2) << 1.0, 0.1).finished();
+  const vector_t x_next = (vector_t(2) << 1.1, 0.2).finished();
+  const vector_t u = (vector_t(2) << 1.5, 1.3).finished();
+
+  const auto performance = computeIntermediatePerformance(problem, discretizer, t, dt, x, x_next, u);
+  ASSERT_GT(performance.inequalityConstraintsSSE, 0.0);
+
+  // Without projection, the bounds are passed on as deviations
+  const auto transcription = setupIntermediateNode(problem, sensitivityDiscretizer, false, t, dt, x, x_next, u);
+  ASSERT_TRUE(areIdentical(performance, transcription.performance));
+  ASSERT_EQ(transcription.ineqConstraints.f.size(), 3);
+  ASSERT_EQ(transcription.nextStateBox.size(), 1);
+  ASSERT_DOUBLE_EQ(transcription.nextStateBox.upperBound[0], -x_next[1]);
+  ASSERT_EQ(transcription.inputBox.size(), 2);
+  ASSERT_DOUBLE_EQ(transcription.inputBox.lowerBound[0], -1.0 - u[0]);
+
+  // With projection, the finite input bounds become inequality constraints on the projected input
+  const auto projectedTranscription = setupIntermediateNode(problem, sensitivityDiscretizer, true, t, dt, x, x_next, u);
+  ASSERT_TRUE(areIdentical(performance, projectedTranscription.performance));
+  ASSERT_TRUE(projectedTranscription.inputBox.empty());
+  ASSERT_EQ(projectedTranscription.ineqConstraints.f.size(), 3 + 3);
+  ASSERT_EQ(projectedTranscription.ineqConstraints.dfdu.cols(), projectedTranscription.constraintsProjection.dfdu.cols());
+}
+
 TEST(test_transcription, terminal_performance) {
   int nx = 3;
 
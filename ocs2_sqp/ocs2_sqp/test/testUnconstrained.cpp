@@ -41,7 +41,7 @@ namespace {
 
 std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithFeedbackSetting(
     bool feedback, bool emptyConstraint, const VectorFunctionLinearApproximation& dynamicsMatrices,
-    const ScalarFunctionQuadraticApproximation& costMatrices) {
+    const ScalarFunctionQuadraticApproximation& costMatrices, bool partitionedRiccati = false) {
   int n = dynamicsMatrices.dfdu.rows();
   int m = dynamicsMatrices.dfdu.cols();
 
@@ -76,6 +76,7 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithFeedbackSettin
   settings.printSolverStatus = true;
   settings.printLinesearch = true;
   settings.nThreads = 100;
+  settings.partitionedRiccati = partitionedRiccati;
 
   // Additional problem definitions
   const ocs2::scalar_t startTime = 0.0;
@@ -160,3 +161,29 @@ TEST(test_unconstrained, noFeedback) {
         withEmptyConstraint.controllerPtr_->computeInput(t, x).isApprox(withNullConstraint.controllerPtr_->computeInput(t, x), tol));
   }
 }
+
+TEST(test_unconstrained, partitionedRiccati) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+  const auto solWithHpipm = ocs2::solveWithFeedbackSetting(true, false, dynamics, costs, false);
+  const auto solWithPartitionedRiccati = ocs2::solveWithFeedbackSetting(true, false, dynamics, costs, true);
+
+  ASSERT_LE(solWithPartitionedRiccati.second.size(), 2);
+  ASSERT_LT(solWithPartitionedRiccati.second.back().dynamicsViolationSSE, tol);
+
+  // Compare
+  const auto& withHpipm = solWithHpipm.first;
+  const auto& withPartitionedRiccati = solWithPartitionedRiccati.first;
+  for (int i = 0; i < withHpipm.timeTrajectory_.size(); i++) {
+    ASSERT_DOUBLE_EQ(withHpipm.timeTrajectory_[i], withPartitionedRiccati.timeTrajectory_[i]);
+    ASSERT_TRUE(withHpipm.stateTrajectory_[i].isApprox(withPartitionedRiccati.stateTrajectory_[i], tol));
+    ASSERT_TRUE(withHpipm.inputTrajectory_[i].isApprox(withPartitionedRiccati.inputTrajectory_[i], tol));
+
+    const auto t = withHpipm.timeTrajectory_[i];
+    const auto& x = withHpipm.stateTrajectory_[i];
+    ASSERT_TRUE(withHpipm.controllerPtr_->computeInput(t, x).isApprox(withPartitionedRiccati.controllerPtr_->computeInput(t, x), tol));
+  }
+}